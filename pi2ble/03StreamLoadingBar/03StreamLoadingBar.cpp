@@ -1,20 +1,181 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
+#include <csignal>
+#include <cstring>
+#include "CameraSource.h"
+#include "Framebuffer.h"
+#include "LogHistogram.h"
+#include "OverlayLayer.h"
+#include "ProgressBar.h"
+#include "YuvBlit.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// The overlay shows telemetry, so it is redrawn at this rate and only
+// composited onto the video frames in between
+static const std::chrono::milliseconds OVERLAY_INTERVAL(100);
+
+struct CapturedFrame {
+    cv::Mat image;
+    int number;
+    Clock::time_point capturedAt;
+};
+
+// Preallocated frames shared by the capture and display threads. Filled
+// frames wait in a short queue; when it is full the oldest one is dropped,
+// so the display always gets the newest frame and never falls behind.
+class FramePool {
+private:
+    std::vector<CapturedFrame> frames;
+    std::vector<int> freeSlots;
+    std::deque<int> ready;
+    size_t readyCapacity;
+    std::mutex mutex;
+    std::condition_variable frameReady;
+    int dropped;
+    
+public:
+
+    FramePool(int width, int height, size_t queueCapacity)
+        : readyCapacity(queueCapacity), dropped(0) {
+        // One being captured, one on screen, the rest queued
+        frames.resize(queueCapacity + 2);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            frames[i].image.create(height, width, CV_8UC3);
+            freeSlots.push_back(static_cast<int>(i));
+        }
+    }
+    
+    CapturedFrame& frame(int slot) {
+        return frames[slot];
+    }
+    
+    // A slot to capture into; there is always one, the queue makes room
+    int acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    
+    void publish(int slot) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ready.size() >= readyCapacity) {
+                freeSlots.push_back(ready.front());
+                ready.pop_front();
+                dropped++;
+            }
+            ready.push_back(slot);
+        }
+        frameReady.notify_one();
+    }
+    
+    // Newest queued frame (older ones count as dropped), -1 if none
+    // arrived within the timeout
+    int take(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!frameReady.wait_for(lock, timeout, [this] { return !ready.empty(); })) {
+            return -1;
+        }
+        int slot = ready.back();
+        ready.pop_back();
+        while (!ready.empty()) {
+            freeSlots.push_back(ready.front());
+            ready.pop_front();
+            dropped++;
+        }
+        return slot;
+    }
+    
+    void release(int slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSlots.push_back(slot);
+    }
+    
+    int droppedFrames() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dropped;
+    }
+};
+
+// Capture-to-display latency over a reporting window, or the whole run,
+// in the fixed buckets of common/LogHistogram.h: a long drive costs no
+// more memory than a short one and nothing is sorted.
+class LatencyStats {
+private:
+    LogHistogram histogram;
+    double maxMs;
+    
+    // Upper bound of the bucket holding the p-th percentile, capped at the max
+    double percentile(double p) const {
+        return std::min(histogram.percentile(p) / 1000.0, maxMs);
+    }
+    
+public:
+    LatencyStats() {
+        reset();
+    }
+    
+    void add(double ms) {
+        histogram.record(ms > 0 ? static_cast<uint64_t>(ms * 1000.0) : 0);
+        maxMs = std::max(maxMs, ms);
+    }
+    
+    size_t count() const {
+        return static_cast<size_t>(histogram.count());
+    }
+    
+    void print(std::ostream& out) {
+        if (count() == 0) return;
+        out << std::fixed << std::setprecision(1)
+            << "latency p50 " << percentile(50)
+            << " ms, p99 " << percentile(99)
+            << " ms, max " << maxMs << " ms";
+    }
+    
+    void reset() {
+        histogram.reset();
+        maxMs = 0.0;
+    }
+};
+
+// Framebuffer mode has no window to read keys from, Ctrl+C stops it
+static volatile std::sig_atomic_t interrupted = 0;
+
+static void onInterrupt(int) {
+    interrupted = 1;
+}
 
 class VideoStreamer {
 private:
     cv::VideoCapture cap;
-    cv::Mat frame;
     std::string windowName;
     int totalFrames;
     int currentFrame;
     double fps;
+    std::atomic<bool> running;
+    std::atomic<int> captured;
+    std::atomic<bool> cameraLost;
+    FrameSource* camera;
+    Framebuffer* framebuffer;
     
 public:
     VideoStreamer(const std::string& videoPath, const std::string& winName = "Video Stream") 
-        : windowName(winName), currentFrame(0) {
+        : windowName(winName), currentFrame(0), running(false), captured(0), cameraLost(false), camera(NULL), framebuffer(NULL) {
         
         // Try to open video file first, if that fails, try camera
         if (!videoPath.empty() && videoPath != "0") {
@@ -47,80 +208,197 @@ public:
         cv::namedWindow(windowName, cv::WINDOW_AUTOSIZE);
     }
     
+    // Camera overlay mode on a native capture source (V4L2 or a raw file),
+    // shown in a window or, with a framebuffer, straight on the display
+    VideoStreamer(FrameSource& source, Framebuffer* fb = NULL, const std::string& winName = "Video Stream")
+        : windowName(winName), totalFrames(0), currentFrame(0), fps(0), running(false), captured(0),
+          cameraLost(false), camera(&source), framebuffer(fb) {
+        std::cout << "Camera opened: " << camera->width() << "x" << camera->height() << " "
+                  << (camera->format() == CAMERA_YUYV ? "YUYV" : "NV12") << std::endl;
+        if (framebuffer) {
+            std::cout << "Framebuffer: " << framebuffer->width() << "x" << framebuffer->height() << std::endl;
+        } else {
+            cv::namedWindow(windowName, cv::WINDOW_AUTOSIZE);
+        }
+    }
+    
     ~VideoStreamer() {
         cap.release();
         cv::destroyAllWindows();
     }
     
-    void drawProgressBar(cv::Mat& image, double progress) {
-        int barWidth = 400;
-        int barHeight = 30;
-        int barX = (image.cols - barWidth) / 2;
-        int barY = image.rows - 60;
-        
-        // Ensure progress is between 0 and 1
-        progress = std::max(0.0, std::min(1.0, progress));
-        
-        // Draw background rectangle (gray)
-        cv::rectangle(image, 
-                     cv::Point(barX, barY), 
-                     cv::Point(barX + barWidth, barY + barHeight),
-                     cv::Scalar(100, 100, 100), 
-                     -1);
-        
-        // Draw progress rectangle (green)
-        int progressWidth = static_cast<int>(barWidth * progress);
-        if (progressWidth > 0) {
-            cv::rectangle(image, 
-                         cv::Point(barX, barY), 
-                         cv::Point(barX + progressWidth, barY + barHeight),
-                         cv::Scalar(0, 255, 0), 
-                         -1);
-        }
-        
-        // Draw border
-        cv::rectangle(image, 
-                     cv::Point(barX, barY), 
-                     cv::Point(barX + barWidth, barY + barHeight),
-                     cv::Scalar(255, 255, 255), 
-                     2);
-        
-        // Add percentage text
-        std::string progressText = std::to_string(static_cast<int>(progress * 100)) + "%";
-        int baseline = 0;
-        cv::Size textSize = cv::getTextSize(progressText, cv::FONT_HERSHEY_SIMPLEX, 0.8, 2, &baseline);
-        cv::Point textOrg(barX + (barWidth - textSize.width) / 2, barY + (barHeight + textSize.height) / 2);
-        
-        cv::putText(image, progressText, textOrg, cv::FONT_HERSHEY_SIMPLEX, 0.8, 
-                   cv::Scalar(255, 255, 255), 2);
-        
-        // Add frame info
-        std::string frameInfo = "Frame: " + std::to_string(currentFrame) + "/" + std::to_string(totalFrames);
-        cv::putText(image, frameInfo, cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.7, 
-                   cv::Scalar(255, 255, 255), 2);
-    }
-    
-    void stream() {
-        auto startTime = std::chrono::high_resolution_clock::now();
+    // Grabs frames into the pool as fast as the source delivers them.
+    // Files are paced at their own frame rate and loop, like a camera.
+    void captureLoop(FramePool& pool) {
+        double frameMs = (totalFrames > 0 && fps > 0) ? 1000.0 / fps : 0.0;
+        Clock::time_point nextFrame = Clock::now();
+        int number = 0;
         
-        while (true) {
-            cap >> frame;
+        while (running) {
+            if (frameMs > 0) {
+                std::this_thread::sleep_until(nextFrame);
+                nextFrame += std::chrono::microseconds(static_cast<long long>(frameMs * 1000));
+            }
             
-            if (frame.empty()) {
+            int slot = pool.acquire();
+            CapturedFrame& captureFrame = pool.frame(slot);
+            if (!cap.read(captureFrame.image) || captureFrame.image.empty()) {
+                pool.release(slot);
                 if (totalFrames > 0) {
                     // Video ended, restart from beginning
                     cap.set(cv::CAP_PROP_POS_FRAMES, 0);
-                    currentFrame = 0;
+                    number = 0;
                     continue;
-                } else {
-                    // Camera disconnected
-                    std::cout << "No frame captured from camera" << std::endl;
-                    break;
                 }
+                // Camera disconnected
+                std::cout << "No frame captured from camera" << std::endl;
+                cameraLost = true;
+                break;
             }
             
+            captureFrame.capturedAt = Clock::now();
+            captureFrame.number = ++number;
+            captured++;
+            pool.publish(slot);
+        }
+    }
+    
+    // Camera buffers are dequeued straight from the driver, drawn on in
+    // place and converted to BGR once for display. The driver keeps
+    // capturing into its other buffers meanwhile; older ready frames are
+    // handed back so the newest one is shown. With a framebuffer the
+    // overlay goes on its own layer instead, redrawn at telemetry rate,
+    // and one fused pass converts, composites and writes the frame to
+    // the display.
+    void streamCamera() {
+        auto startTime = Clock::now();
+        cv::Mat bgr;
+        if (!framebuffer) bgr.create(camera->height(), camera->width(), CV_8UC3);
+        OverlayLayer overlay(framebuffer ? camera->width() : 0, framebuffer ? camera->height() : 0);
+        Clock::time_point overlayDue = Clock::now();
+        if (framebuffer) std::signal(SIGINT, onInterrupt);
+        LatencyStats latency;
+        LatencyStats totalLatency;
+        int displayed = 0;
+        long long dropped = 0;
+        bool first = true;
+        uint32_t lastSequence = 0;
+        Clock::time_point lastReport = Clock::now();
+        
+        while (!interrupted) {
+            CameraFrame shown;
+            if (!camera->dequeue(shown, 100)) {
+                if (framebuffer) continue;
+                char key = cv::waitKey(1) & 0xFF;
+                if (key == 'q' || key == 27) break;
+                continue;
+            }
+            CameraFrame newer;
+            while (camera->dequeue(newer, 0)) {
+                camera->requeue(shown);
+                shown = newer;
+            }
+            // Anything between two shown frames was dropped, here or in the driver
+            if (!first) dropped += static_cast<uint32_t>(shown.sequence - lastSequence - 1);
+            first = false;
+            lastSequence = shown.sequence;
             currentFrame++;
             
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count();
+            double progress = (elapsed % 5000) / 5000.0;  // 5-second cycle
+            
+            char key = 0;
+            if (framebuffer) {
+                if (Clock::now() >= overlayDue) {
+                    overlay.clear();
+                    drawProgressBar(overlay, progress, currentFrame, totalFrames);
+                    overlayDue = Clock::now() + OVERLAY_INTERVAL;
+                }
+                
+                YuvImage src;
+                src.layout = shown.format == CAMERA_YUYV ? YUV_YUYV : YUV_NV12;
+                src.width = std::min(camera->width(), framebuffer->width()) & ~1;
+                src.height = std::min(camera->height(), framebuffer->height()) & ~1;
+                src.data = shown.format == CAMERA_YUYV ? shown.yuyv.data : shown.luma.data;
+                src.stride = shown.format == CAMERA_YUYV ? shown.yuyv.step : shown.luma.step;
+                src.chroma = shown.format == CAMERA_YUYV ? NULL : shown.chroma.data;
+                src.chromaStride = shown.format == CAMERA_YUYV ? 0 : shown.chroma.step;
+                OverlaySource layer = overlay.source();
+                blitYuvToFramebuffer(src, &layer, framebuffer->pixels(), framebuffer->stride(), framebuffer->format());
+                camera->requeue(shown);
+            } else {
+                drawProgressBar(shown, progress, currentFrame, totalFrames);
+                if (shown.format == CAMERA_YUYV) {
+                    cv::cvtColor(shown.yuyv, bgr, cv::COLOR_YUV2BGR_YUYV);
+                } else {
+                    cv::cvtColorTwoPlane(shown.luma, shown.chroma, bgr, cv::COLOR_YUV2BGR_NV12);
+                }
+                camera->requeue(shown);
+                
+                cv::imshow(windowName, bgr);
+                key = cv::waitKey(1) & 0xFF;
+            }
+            
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - shown.capturedAt).count();
+            latency.add(ms);
+            totalLatency.add(ms);
+            displayed++;
+            
+            if (key == 'q' || key == 27) {  // 'q' or ESC key
+                break;
+            }
+            
+            if (Clock::now() - lastReport >= std::chrono::seconds(5)) {
+                std::cout << "displayed " << displayed << ", dropped " << dropped << ", ";
+                latency.print(std::cout);
+                std::cout << std::endl;
+                latency.reset();
+                lastReport = Clock::now();
+            }
+        }
+        
+        std::cout << "Displayed " << displayed << " frames, dropped " << dropped << std::endl;
+        std::cout << "Capture to display: ";
+        totalLatency.print(std::cout);
+        std::cout << std::endl;
+    }
+    
+    void stream() {
+        if (camera) {
+            streamCamera();
+            return;
+        }
+        
+        auto startTime = std::chrono::high_resolution_clock::now();
+        int width = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
+        int height = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+        FramePool pool(width > 0 ? width : 640, height > 0 ? height : 480, 2);
+        
+        running = true;
+        std::thread captureThread(&VideoStreamer::captureLoop, this, std::ref(pool));
+        
+        // Made for the first frame's size, frames may differ from the properties
+        std::unique_ptr<OverlayLayer> overlay;
+        Clock::time_point overlayDue = Clock::now();
+        
+        LatencyStats latency;
+        LatencyStats totalLatency;
+        int displayed = 0;
+        Clock::time_point lastReport = Clock::now();
+        
+        while (running) {
+            int slot = pool.take(std::chrono::milliseconds(100));
+            if (slot < 0) {
+                if (cameraLost) break;
+                // Keep the window responsive while waiting
+                char key = cv::waitKey(1) & 0xFF;
+                if (key == 'q' || key == 27) break;
+                continue;
+            }
+            
+            CapturedFrame& shown = pool.frame(slot);
+            currentFrame = shown.number;
+            
             // Calculate progress
             double progress = 0.0;
             if (totalFrames > 0) {
@@ -133,28 +411,121 @@ public:
                 progress = (elapsed % 5000) / 5000.0;  // 5-second cycle
             }
             
-            // Draw progress bar on frame
-            drawProgressBar(frame, progress);
+            // Redraw the progress bar when due, blend it onto every frame
+            if (!overlay || overlay->size() != shown.image.size()) {
+                overlay.reset(new OverlayLayer(shown.image.cols, shown.image.rows));
+                overlayDue = Clock::now();
+            }
+            if (Clock::now() >= overlayDue) {
+                overlay->clear();
+                drawProgressBar(*overlay, progress, currentFrame, totalFrames);
+                overlayDue = Clock::now() + OVERLAY_INTERVAL;
+            }
+            overlay->compositeOnto(shown.image);
             
             // Display frame
-            cv::imshow(windowName, frame);
+            cv::imshow(windowName, shown.image);
             
             // Check for exit condition
             char key = cv::waitKey(1) & 0xFF;
+            
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - shown.capturedAt).count();
+            latency.add(ms);
+            totalLatency.add(ms);
+            displayed++;
+            pool.release(slot);
+            
             if (key == 'q' || key == 27) {  // 'q' or ESC key
                 break;
             }
             
-            // Control frame rate for camera
-            if (totalFrames == 0) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(33));  // ~30 FPS
+            if (Clock::now() - lastReport >= std::chrono::seconds(5)) {
+                std::cout << "captured " << captured << ", displayed " << displayed
+                          << ", dropped " << pool.droppedFrames() << ", ";
+                latency.print(std::cout);
+                std::cout << std::endl;
+                latency.reset();
+                lastReport = Clock::now();
             }
         }
+        
+        running = false;
+        captureThread.join();
+        
+        std::cout << "Captured " << captured << " frames, displayed " << displayed
+                  << ", dropped " << pool.droppedFrames() << std::endl;
+        std::cout << "Capture to display: ";
+        totalLatency.print(std::cout);
+        std::cout << std::endl;
     }
 };
 
+static CameraPixelFormat parsePixelFormat(const std::string& name) {
+    if (name == "yuyv") return CAMERA_YUYV;
+    if (name == "nv12") return CAMERA_NV12;
+    throw std::runtime_error("Unknown pixel format " + name + " (yuyv or nv12)");
+}
+
+static void parseSize(const std::string& size, int& width, int& height) {
+    if (std::sscanf(size.c_str(), "%dx%d", &width, &height) != 2) {
+        throw std::runtime_error("Bad frame size " + size + " (e.g. 640x480)");
+    }
+}
+
+// Usage:
+//   ./03StreamLoadingBar [video_file_path]              OpenCV capture (default camera without a path)
+//   ./03StreamLoadingBar --v4l2 /dev/video0 [WxH] [yuyv|nv12]
+//   ./03StreamLoadingBar --raw frames.yuv WxH yuyv|nv12 [fps]
+// --v4l2 captures through V4L2 mmap buffers without copies; --raw plays
+// raw frames from a file through the same path, for testing without a
+// camera (ffmpeg -i in.mp4 -pix_fmt yuyv422 -s 640x480 -f rawvideo frames.yuv).
+// Either can add --fb [/dev/fb0] to draw on the framebuffer instead of a
+// window (one fused pass per frame, see YuvBlit.h); Ctrl+C stops.
 int main(int argc, char* argv[]) {
     try {
+        // --fb [device] anywhere: camera modes draw on the framebuffer
+        std::string fbDevice;
+        std::vector<char*> args;
+        for (int i = 0; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--fb") == 0) {
+                fbDevice = "/dev/fb0";
+                if (i + 1 < argc && std::strncmp(argv[i + 1], "/dev/", 5) == 0) fbDevice = argv[++i];
+            } else {
+                args.push_back(argv[i]);
+            }
+        }
+        argc = static_cast<int>(args.size());
+        argv = args.data();
+        
+        std::string mode = argc > 1 ? argv[1] : "";
+        if (mode == "--v4l2" || mode == "--raw") {
+            int width = 640;
+            int height = 480;
+            CameraPixelFormat format = CAMERA_YUYV;
+            if (argc < 3 || (mode == "--raw" && argc < 5)) {
+                std::cout << "Usage: " << argv[0] << " --v4l2 /dev/video0 [WxH] [yuyv|nv12] [--fb [/dev/fbN]]" << std::endl;
+                std::cout << "       " << argv[0] << " --raw frames.yuv WxH yuyv|nv12 [fps] [--fb [/dev/fbN]]" << std::endl;
+                return -1;
+            }
+            if (argc > 3) parseSize(argv[3], width, height);
+            if (argc > 4) format = parsePixelFormat(argv[4]);
+            
+            std::unique_ptr<FrameSource> source;
+            if (mode == "--v4l2") {
+                source.reset(new V4l2Capture(argv[2], width, height, format));
+            } else {
+                source.reset(new RawFileSource(argv[2], width, height, format, argc > 5 ? std::atof(argv[5]) : 30.0));
+            }
+            
+            std::unique_ptr<Framebuffer> framebuffer;
+            if (!fbDevice.empty()) framebuffer.reset(new Framebuffer(fbDevice));
+            
+            VideoStreamer streamer(*source, framebuffer.get());
+            std::cout << "Press 'q' or ESC to quit" << std::endl;
+            streamer.stream();
+            return 0;
+        }
+        
         std::string videoPath;
         
         if (argc > 1) {
@@ -0,0 +1,269 @@
+#include "CameraSource.h"
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+static int xioctl(int fd, unsigned long request, void* arg) {
+    int result;
+    do {
+        result = ioctl(fd, request, arg);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+
+static std::runtime_error v4l2Error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void wrapCameraBuffer(CameraFrame& frame, uint8_t* data, int width, int height, size_t bytesPerLine,
+                      CameraPixelFormat format) {
+    frame.format = format;
+    if (format == CAMERA_YUYV) {
+        frame.yuyv = cv::Mat(height, width, CV_8UC2, data, bytesPerLine);
+        frame.luma = cv::Mat();
+        frame.chroma = cv::Mat();
+    } else {
+        frame.yuyv = cv::Mat();
+        frame.luma = cv::Mat(height, width, CV_8UC1, data, bytesPerLine);
+        frame.chroma = cv::Mat(height / 2, width / 2, CV_8UC2, data + bytesPerLine * height, bytesPerLine);
+    }
+}
+
+V4l2Capture::V4l2Capture(const std::string& device, int width, int height, CameraPixelFormat format,
+                         int bufferCount)
+    : fd(-1), frameWidth(0), frameHeight(0), bytesPerLine(0), pixelFormat(format), streaming(false) {
+    fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if (fd < 0) {
+        throw v4l2Error("Could not open " + device);
+    }
+
+    try {
+        v4l2_capability caps;
+        std::memset(&caps, 0, sizeof(caps));
+        if (xioctl(fd, VIDIOC_QUERYCAP, &caps) == -1) {
+            throw v4l2Error(device + " is not a V4L2 device");
+        }
+        if (!(caps.capabilities & V4L2_CAP_VIDEO_CAPTURE) || !(caps.capabilities & V4L2_CAP_STREAMING)) {
+            throw std::runtime_error(device + " can't stream video capture");
+        }
+
+        v4l2_format fmt;
+        std::memset(&fmt, 0, sizeof(fmt));
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width = width;
+        fmt.fmt.pix.height = height;
+        fmt.fmt.pix.pixelformat = format == CAMERA_YUYV ? V4L2_PIX_FMT_YUYV : V4L2_PIX_FMT_NV12;
+        fmt.fmt.pix.field = V4L2_FIELD_ANY;
+        if (xioctl(fd, VIDIOC_S_FMT, &fmt) == -1) {
+            throw v4l2Error("VIDIOC_S_FMT");
+        }
+        if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_YUYV) {
+            pixelFormat = CAMERA_YUYV;
+        } else if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_NV12) {
+            pixelFormat = CAMERA_NV12;
+        } else {
+            throw std::runtime_error(device + " offers neither YUYV nor NV12");
+        }
+        frameWidth = static_cast<int>(fmt.fmt.pix.width);
+        frameHeight = static_cast<int>(fmt.fmt.pix.height);
+        bytesPerLine = fmt.fmt.pix.bytesperline;
+
+        v4l2_requestbuffers request;
+        std::memset(&request, 0, sizeof(request));
+        request.count = bufferCount;
+        request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        request.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd, VIDIOC_REQBUFS, &request) == -1) {
+            throw v4l2Error("VIDIOC_REQBUFS");
+        }
+        if (request.count < 2) {
+            throw std::runtime_error(device + ": not enough capture buffers");
+        }
+
+        for (unsigned i = 0; i < request.count; ++i) {
+            v4l2_buffer buf;
+            std::memset(&buf, 0, sizeof(buf));
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (xioctl(fd, VIDIOC_QUERYBUF, &buf) == -1) {
+                throw v4l2Error("VIDIOC_QUERYBUF");
+            }
+
+            // Writable so the overlay can be drawn on the planes in place
+            void* start = mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, buf.m.offset);
+            if (start == MAP_FAILED) {
+                throw v4l2Error("Could not map capture buffer");
+            }
+            Buffer mapped = {start, buf.length};
+            buffers.push_back(mapped);
+
+            if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
+                throw v4l2Error("VIDIOC_QBUF");
+            }
+        }
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(fd, VIDIOC_STREAMON, &type) == -1) {
+            throw v4l2Error("VIDIOC_STREAMON");
+        }
+        streaming = true;
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+V4l2Capture::~V4l2Capture() {
+    close();
+}
+
+void V4l2Capture::close() {
+    if (streaming) {
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(fd, VIDIOC_STREAMOFF, &type);
+        streaming = false;
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        munmap(buffers[i].start, buffers[i].length);
+    }
+    buffers.clear();
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool V4l2Capture::dequeue(CameraFrame& frame, int timeoutMs) {
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ready = poll(&pfd, 1, timeoutMs);
+    if (ready < 0 && errno != EINTR) {
+        throw v4l2Error("poll");
+    }
+    if (ready <= 0) return false;
+
+    v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(fd, VIDIOC_DQBUF, &buf) == -1) {
+        if (errno == EAGAIN) return false;
+        throw v4l2Error("VIDIOC_DQBUF");
+    }
+
+    frame.buffer = static_cast<int>(buf.index);
+    frame.sequence = buf.sequence;
+    // Monotonic driver timestamps are on the steady_clock timeline
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        frame.capturedAt = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::seconds(buf.timestamp.tv_sec) + std::chrono::microseconds(buf.timestamp.tv_usec)));
+    } else {
+        frame.capturedAt = Clock::now();
+    }
+    wrapCameraBuffer(frame, static_cast<uint8_t*>(buffers[buf.index].start), frameWidth, frameHeight,
+                     bytesPerLine, pixelFormat);
+    return true;
+}
+
+void V4l2Capture::requeue(const CameraFrame& frame) {
+    v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = frame.buffer;
+    if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
+        throw v4l2Error("VIDIOC_QBUF");
+    }
+}
+
+RawFileSource::RawFileSource(const std::string& path, int width, int height, CameraPixelFormat format,
+                             double fps, int bufferCount)
+    : fd(-1), frameWidth(width), frameHeight(height), pixelFormat(format), nextFrame(0), sequence(0) {
+    if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0) {
+        throw std::runtime_error("Raw frames need an even width and height");
+    }
+    frameBytes = format == CAMERA_YUYV ? static_cast<size_t>(width) * height * 2
+                                       : static_cast<size_t>(width) * height * 3 / 2;
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw v4l2Error("Could not open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < frameBytes) {
+        ::close(fd);
+        throw std::runtime_error(path + " holds no complete frame of that size");
+    }
+    frameCount = static_cast<size_t>(st.st_size) / frameBytes;
+
+    buffers.resize(bufferCount);
+    for (int i = 0; i < bufferCount; ++i) {
+        buffers[i].resize(frameBytes);
+        freeBuffers.push_back(i);
+    }
+    frameInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / (fps > 0 ? fps : 30.0)));
+    nextDue = Clock::now();
+}
+
+RawFileSource::~RawFileSource() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool RawFileSource::dequeue(CameraFrame& frame, int timeoutMs) {
+    // Like a driver with every buffer held by the caller: nothing to give
+    if (freeBuffers.empty()) return false;
+
+    Clock::time_point now = Clock::now();
+    if (nextDue > now) {
+        Clock::time_point deadline = now + std::chrono::milliseconds(timeoutMs);
+        if (nextDue > deadline) {
+            std::this_thread::sleep_until(deadline);
+            return false;
+        }
+        std::this_thread::sleep_until(nextDue);
+    }
+
+    // Frames the "sensor" produced while nobody was reading are lost,
+    // which shows up as a gap in the sequence numbers
+    now = Clock::now();
+    while (nextDue + frameInterval <= now) {
+        nextDue += frameInterval;
+        nextFrame = (nextFrame + 1) % frameCount;
+        sequence++;
+    }
+
+    int buffer = freeBuffers.back();
+    freeBuffers.pop_back();
+    uint8_t* data = buffers[buffer].data();
+    if (pread(fd, data, frameBytes, static_cast<off_t>(nextFrame * frameBytes)) != static_cast<ssize_t>(frameBytes)) {
+        freeBuffers.push_back(buffer);
+        throw v4l2Error("Could not read raw frame");
+    }
+
+    frame.buffer = buffer;
+    frame.sequence = sequence++;
+    frame.capturedAt = nextDue;
+    wrapCameraBuffer(frame, data, frameWidth, frameHeight, frameWidth * (pixelFormat == CAMERA_YUYV ? 2 : 1),
+                     pixelFormat);
+
+    nextDue += frameInterval;
+    nextFrame = (nextFrame + 1) % frameCount;
+    return true;
+}
+
+void RawFileSource::requeue(const CameraFrame& frame) {
+    freeBuffers.push_back(frame.buffer);
+}
@@ -0,0 +1,112 @@
+#ifndef CAMERA_SOURCE_H
+#define CAMERA_SOURCE_H
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum CameraPixelFormat {
+    CAMERA_YUYV, // packed 4:2:2, Y0 U Y1 V
+    CAMERA_NV12  // Y plane, then interleaved UV at half resolution
+};
+
+// One captured frame, as views into the source's buffer (no copies).
+// YUYV fills yuyv (CV_8UC2: Y, U/V per pixel); NV12 fills luma (CV_8UC1)
+// and chroma (CV_8UC2, half size). Valid until the frame is requeued.
+struct CameraFrame {
+    int buffer;
+    CameraPixelFormat format;
+    cv::Mat yuyv;
+    cv::Mat luma;
+    cv::Mat chroma;
+    uint32_t sequence;
+    std::chrono::steady_clock::time_point capturedAt;
+};
+
+// A camera as a ring of driver-owned buffers: dequeue a filled one,
+// requeue it when done. Frames arrive while the caller is busy, up to
+// the number of buffers.
+class FrameSource {
+public:
+    virtual ~FrameSource() {}
+
+    // Waits up to timeoutMs for a filled buffer (0 only takes a ready one)
+    virtual bool dequeue(CameraFrame& frame, int timeoutMs) = 0;
+    virtual void requeue(const CameraFrame& frame) = 0;
+
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+    virtual CameraPixelFormat format() const = 0;
+};
+
+// Native V4L2 capture with mmap streaming I/O (VIDIOC_REQBUFS/QBUF/DQBUF).
+// The driver writes straight into the mapped buffers, which CameraFrame
+// wraps as Mats, so a frame is never copied or converted on the way in.
+class V4l2Capture : public FrameSource {
+private:
+    struct Buffer {
+        void* start;
+        size_t length;
+    };
+
+    int fd;
+    int frameWidth;
+    int frameHeight;
+    size_t bytesPerLine;
+    CameraPixelFormat pixelFormat;
+    std::vector<Buffer> buffers;
+    bool streaming;
+
+    void close();
+
+public:
+    // format is a request; the driver may pick another size
+    V4l2Capture(const std::string& device, int width, int height, CameraPixelFormat format, int bufferCount = 4);
+    ~V4l2Capture();
+
+    bool dequeue(CameraFrame& frame, int timeoutMs);
+    void requeue(const CameraFrame& frame);
+
+    int width() const { return frameWidth; }
+    int height() const { return frameHeight; }
+    CameraPixelFormat format() const { return pixelFormat; }
+};
+
+// Stand-in camera for testing without hardware: plays raw YUYV or NV12
+// frames from a file (e.g. ffmpeg -pix_fmt yuyv422 -f rawvideo) at fps,
+// looping, through the same buffer ring a driver would fill.
+class RawFileSource : public FrameSource {
+private:
+    int fd;
+    int frameWidth;
+    int frameHeight;
+    CameraPixelFormat pixelFormat;
+    size_t frameBytes;
+    size_t frameCount;
+    size_t nextFrame;
+    uint32_t sequence;
+    std::vector<std::vector<uint8_t> > buffers;
+    std::vector<int> freeBuffers;
+    std::chrono::steady_clock::duration frameInterval;
+    std::chrono::steady_clock::time_point nextDue;
+
+public:
+    RawFileSource(const std::string& path, int width, int height, CameraPixelFormat format, double fps,
+                  int bufferCount = 4);
+    ~RawFileSource();
+
+    bool dequeue(CameraFrame& frame, int timeoutMs);
+    void requeue(const CameraFrame& frame);
+
+    int width() const { return frameWidth; }
+    int height() const { return frameHeight; }
+    CameraPixelFormat format() const { return pixelFormat; }
+};
+
+// Wraps a buffer of the given format as the CameraFrame views
+void wrapCameraBuffer(CameraFrame& frame, uint8_t* data, int width, int height, size_t bytesPerLine,
+                      CameraPixelFormat format);
+
+#endif // CAMERA_SOURCE_H
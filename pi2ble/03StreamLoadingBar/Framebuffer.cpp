@@ -0,0 +1,15 @@
+#include "Framebuffer.h"
+#include <stdexcept>
+
+Framebuffer::Framebuffer(const std::string& path) : device(path) {
+    const fb_var_screeninfo& vinfo = device.variableInfo();
+    if (vinfo.bits_per_pixel == 16) {
+        pixelFormat = FB_RGB565;
+    } else if (vinfo.bits_per_pixel == 32 && vinfo.red.offset == 16) {
+        pixelFormat = FB_XRGB8888;
+    } else if (vinfo.bits_per_pixel == 32 && vinfo.red.offset == 0) {
+        pixelFormat = FB_XBGR8888;
+    } else {
+        throw std::runtime_error(path + ": unsupported pixel format");
+    }
+}
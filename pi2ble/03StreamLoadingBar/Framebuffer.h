@@ -0,0 +1,28 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "FramebufferDevice.h"
+#include "YuvBlit.h"
+
+// Mapped Linux framebuffer (/dev/fb0, ../common/FramebufferDevice.h) with
+// its pixel format worked out for blitYuvToFramebuffer.
+class Framebuffer {
+private:
+    FramebufferDevice device;
+    FramebufferFormat pixelFormat;
+
+public:
+    explicit Framebuffer(const std::string& path = "/dev/fb0");
+
+    int width() const { return device.width(); }
+    int height() const { return device.height(); }
+    size_t stride() const { return device.stride(); }
+    FramebufferFormat format() const { return pixelFormat; }
+    // Top left of the visible area
+    uint8_t* pixels() const { return device.pixels(); }
+};
+
+#endif // FRAMEBUFFER_H
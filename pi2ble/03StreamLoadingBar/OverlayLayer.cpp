@@ -0,0 +1,121 @@
+#include "OverlayLayer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+static cv::Scalar premultiplied(const cv::Scalar& bgr, double alpha) {
+    alpha = std::max(0.0, std::min(1.0, alpha));
+    return cv::Scalar(bgr[0] * alpha, bgr[1] * alpha, bgr[2] * alpha, 255 * alpha);
+}
+
+OverlayLayer::OverlayLayer(int width, int height)
+    : spanBegin(height, 0), spanEnd(height, 0), prepared(false) {
+    bgra.create(height, width, CV_8UC4);
+    bgra.setTo(cv::Scalar(0, 0, 0, 0));
+    color.create(height, width, CV_8UC3);
+    inverseAlpha.create(height, width, CV_8UC3);
+}
+
+void OverlayLayer::mark(const cv::Rect& area) {
+    cv::Rect box = area & cv::Rect(0, 0, bgra.cols, bgra.rows);
+    if (box.area() <= 0) return;
+
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if ((boxes[i] & box).area() > 0) {
+                box |= boxes[i];
+                boxes.erase(boxes.begin() + i);
+                merged = true;
+                break;
+            }
+        }
+    }
+    boxes.push_back(box);
+    prepared = false;
+}
+
+void OverlayLayer::clear() {
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        bgra(boxes[i]).setTo(cv::Scalar(0, 0, 0, 0));
+    }
+    boxes.clear();
+    prepared = false;
+}
+
+void OverlayLayer::fillRect(cv::Point p1, cv::Point p2, const cv::Scalar& bgr, double alpha) {
+    cv::rectangle(bgra, p1, p2, premultiplied(bgr, alpha), -1);
+    mark(cv::Rect(p1, p2) | cv::Rect(p2, cv::Size(1, 1)));
+}
+
+void OverlayLayer::outlineRect(cv::Point p1, cv::Point p2, const cv::Scalar& bgr, int thickness, double alpha) {
+    cv::rectangle(bgra, p1, p2, premultiplied(bgr, alpha), thickness);
+    cv::Rect box = cv::Rect(p1, p2) | cv::Rect(p2, cv::Size(1, 1));
+    mark(cv::Rect(box.x - thickness, box.y - thickness, box.width + 2 * thickness, box.height + 2 * thickness));
+}
+
+void OverlayLayer::drawText(const std::string& text, cv::Point org, double scale, const cv::Scalar& bgr,
+                            int thickness, double alpha) {
+    cv::putText(bgra, text, org, cv::FONT_HERSHEY_SIMPLEX, scale, premultiplied(bgr, alpha), thickness);
+    int baseline = 0;
+    cv::Size textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, scale, thickness, &baseline);
+    mark(cv::Rect(org.x - thickness, org.y - textSize.height - thickness, textSize.width + 2 * thickness,
+                  textSize.height + baseline + 2 * thickness));
+}
+
+// Runs once per change, not per video frame
+void OverlayLayer::prepare() {
+    if (prepared) return;
+
+    std::fill(spanBegin.begin(), spanBegin.end(), 0);
+    std::fill(spanEnd.begin(), spanEnd.end(), 0);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const cv::Rect& box = boxes[i];
+        for (int y = box.y; y < box.y + box.height; ++y) {
+            const uint8_t* src = bgra.ptr<uint8_t>(y) + box.x * 4;
+            uint8_t* premultipliedColor = color.ptr<uint8_t>(y) + box.x * 3;
+            uint8_t* inverse = inverseAlpha.ptr<uint8_t>(y) + box.x * 3;
+            for (int x = 0; x < box.width; ++x) {
+                uint8_t coverage = static_cast<uint8_t>(255 - src[4 * x + 3]);
+                for (int c = 0; c < 3; ++c) {
+                    premultipliedColor[3 * x + c] = src[4 * x + c];
+                    inverse[3 * x + c] = coverage;
+                }
+            }
+
+            if (spanBegin[y] == spanEnd[y]) {
+                spanBegin[y] = static_cast<uint16_t>(box.x);
+                spanEnd[y] = static_cast<uint16_t>(box.x + box.width);
+            } else {
+                spanBegin[y] = static_cast<uint16_t>(std::min<int>(spanBegin[y], box.x));
+                spanEnd[y] = static_cast<uint16_t>(std::max<int>(spanEnd[y], box.x + box.width));
+            }
+        }
+    }
+    prepared = true;
+}
+
+void OverlayLayer::compositeOnto(cv::Mat& frame) {
+    if (frame.size() != bgra.size() || frame.type() != CV_8UC3) {
+        throw std::runtime_error("Overlay layer and frame differ in size or type");
+    }
+    prepare();
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const cv::Rect& box = boxes[i];
+        for (int y = box.y; y < box.y + box.height; ++y) {
+            blendOverBgr(color.ptr<uint8_t>(y) + box.x * 3, inverseAlpha.ptr<uint8_t>(y) + box.x * 3,
+                         frame.ptr<uint8_t>(y) + box.x * 3, static_cast<size_t>(box.width) * 3);
+        }
+    }
+}
+
+OverlaySource OverlayLayer::source() {
+    prepare();
+    OverlaySource overlay;
+    overlay.bgra = bgra.ptr<uint8_t>(0);
+    overlay.stride = bgra.step;
+    overlay.spanBegin = spanBegin.data();
+    overlay.spanEnd = spanEnd.data();
+    return overlay;
+}
@@ -0,0 +1,52 @@
+#ifndef OVERLAY_LAYER_H
+#define OVERLAY_LAYER_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "YuvBlit.h"
+
+// Overlay widgets on their own premultiplied-alpha BGRA surface instead
+// of on the video frame. The layer is redrawn only when the widgets
+// change (at telemetry rate) and blended onto every video frame, only
+// inside the bounding boxes of what was drawn.
+//
+// Shapes replace what is under them on the layer; alpha is how much of
+// the video shows through.
+class OverlayLayer {
+private:
+    cv::Mat bgra;
+    // Blend form of bgra inside the boxes, see blendOverBgr
+    cv::Mat color;
+    cv::Mat inverseAlpha;
+    // Drawn areas, merged so they never overlap
+    std::vector<cv::Rect> boxes;
+    std::vector<uint16_t> spanBegin;
+    std::vector<uint16_t> spanEnd;
+    bool prepared;
+
+    void mark(const cv::Rect& area);
+    void prepare();
+
+public:
+    OverlayLayer(int width, int height);
+
+    cv::Size size() const { return bgra.size(); }
+    bool empty() const { return boxes.empty(); }
+    const std::vector<cv::Rect>& drawnBoxes() const { return boxes; }
+
+    // Transparent again, touching only what was drawn
+    void clear();
+    void fillRect(cv::Point p1, cv::Point p2, const cv::Scalar& bgr, double alpha = 1.0);
+    void outlineRect(cv::Point p1, cv::Point p2, const cv::Scalar& bgr, int thickness, double alpha = 1.0);
+    void drawText(const std::string& text, cv::Point org, double scale, const cv::Scalar& bgr, int thickness,
+                  double alpha = 1.0);
+
+    // Blends the layer onto a BGR frame of the same size
+    void compositeOnto(cv::Mat& frame);
+    // The layer for blitYuvToFramebuffer; valid until the next change
+    OverlaySource source();
+};
+
+#endif // OVERLAY_LAYER_H
@@ -0,0 +1,81 @@
+#include "ProgressBar.h"
+
+void fillRect(cv::Mat& image, cv::Point p1, cv::Point p2, const cv::Scalar& color) {
+    cv::rectangle(image, p1, p2, color, -1);
+}
+
+void outlineRect(cv::Mat& image, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness) {
+    cv::rectangle(image, p1, p2, color, thickness);
+}
+
+void drawText(cv::Mat& image, const std::string& text, cv::Point org, double scale,
+              const cv::Scalar& color, int thickness) {
+    cv::putText(image, text, org, cv::FONT_HERSHEY_SIMPLEX, scale, color, thickness);
+}
+
+// BT.601 limited range, what UVC cameras and the Pi ISP deliver
+static cv::Scalar bgrToYuv(const cv::Scalar& bgr) {
+    double b = bgr[0], g = bgr[1], r = bgr[2];
+    double y = 16 + 0.257 * r + 0.504 * g + 0.098 * b;
+    double u = 128 - 0.148 * r - 0.291 * g + 0.439 * b;
+    double v = 128 + 0.439 * r - 0.368 * g - 0.071 * b;
+    return cv::Scalar(y, u, v);
+}
+
+void fillRect(CameraFrame& frame, cv::Point p1, cv::Point p2, const cv::Scalar& color) {
+    cv::Scalar yuv = bgrToYuv(color);
+    if (frame.format == CAMERA_YUYV) {
+        // Whole Y0 U Y1 V macropixels, so both chroma samples get set
+        cv::Mat macropixels(frame.yuyv.rows, frame.yuyv.cols / 2, CV_8UC4, frame.yuyv.data, frame.yuyv.step);
+        cv::rectangle(macropixels, cv::Point(p1.x / 2, p1.y), cv::Point(p2.x / 2, p2.y),
+                      cv::Scalar(yuv[0], yuv[1], yuv[0], yuv[2]), -1);
+    } else {
+        cv::rectangle(frame.luma, p1, p2, cv::Scalar(yuv[0]), -1);
+        cv::rectangle(frame.chroma, cv::Point(p1.x / 2, p1.y / 2), cv::Point(p2.x / 2, p2.y / 2),
+                      cv::Scalar(yuv[1], yuv[2]), -1);
+    }
+}
+
+void outlineRect(CameraFrame& frame, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness) {
+    int half = thickness / 2;
+    fillRect(frame, cv::Point(p1.x - half, p1.y - half), cv::Point(p2.x + half, p1.y + half), color);
+    fillRect(frame, cv::Point(p1.x - half, p2.y - half), cv::Point(p2.x + half, p2.y + half), color);
+    fillRect(frame, cv::Point(p1.x - half, p1.y - half), cv::Point(p1.x + half, p2.y + half), color);
+    fillRect(frame, cv::Point(p2.x - half, p1.y - half), cv::Point(p2.x + half, p2.y + half), color);
+}
+
+void drawText(CameraFrame& frame, const std::string& text, cv::Point org, double scale,
+              const cv::Scalar& color, int thickness) {
+    double y = bgrToYuv(color)[0];
+    if (frame.format == CAMERA_YUYV) {
+        cv::putText(frame.yuyv, text, org, cv::FONT_HERSHEY_SIMPLEX, scale, cv::Scalar(y, 128), thickness);
+    } else {
+        cv::putText(frame.luma, text, org, cv::FONT_HERSHEY_SIMPLEX, scale, cv::Scalar(y), thickness);
+    }
+}
+
+cv::Size canvasSize(const cv::Mat& image) {
+    return image.size();
+}
+
+cv::Size canvasSize(const CameraFrame& frame) {
+    return frame.format == CAMERA_YUYV ? frame.yuyv.size() : frame.luma.size();
+}
+
+// Widgets drawn on an OverlayLayer, which is composited onto the frames
+void fillRect(OverlayLayer& layer, cv::Point p1, cv::Point p2, const cv::Scalar& color) {
+    layer.fillRect(p1, p2, color);
+}
+
+void outlineRect(OverlayLayer& layer, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness) {
+    layer.outlineRect(p1, p2, color, thickness);
+}
+
+void drawText(OverlayLayer& layer, const std::string& text, cv::Point org, double scale,
+              const cv::Scalar& color, int thickness) {
+    layer.drawText(text, org, scale, color, thickness);
+}
+
+cv::Size canvasSize(const OverlayLayer& layer) {
+    return layer.size();
+}
@@ -0,0 +1,82 @@
+#ifndef PROGRESS_BAR_H
+#define PROGRESS_BAR_H
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <string>
+#include "CameraSource.h"
+#include "OverlayLayer.h"
+
+// Drawing primitives for drawProgressBar, on a BGR Mat, straight onto
+// the YUV planes of a camera buffer (no conversion before drawing), or
+// on an OverlayLayer that is composited onto the frames.
+void fillRect(cv::Mat& image, cv::Point p1, cv::Point p2, const cv::Scalar& color);
+void outlineRect(cv::Mat& image, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness);
+void drawText(cv::Mat& image, const std::string& text, cv::Point org, double scale, const cv::Scalar& color,
+              int thickness);
+cv::Size canvasSize(const cv::Mat& image);
+
+void fillRect(CameraFrame& frame, cv::Point p1, cv::Point p2, const cv::Scalar& color);
+void outlineRect(CameraFrame& frame, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness);
+// Text only goes into luma (with neutral chroma for YUYV): fine for the
+// white labels used here, colored text needs a BGR frame
+void drawText(CameraFrame& frame, const std::string& text, cv::Point org, double scale, const cv::Scalar& color,
+              int thickness);
+cv::Size canvasSize(const CameraFrame& frame);
+
+void fillRect(OverlayLayer& layer, cv::Point p1, cv::Point p2, const cv::Scalar& color);
+void outlineRect(OverlayLayer& layer, cv::Point p1, cv::Point p2, const cv::Scalar& color, int thickness);
+void drawText(OverlayLayer& layer, const std::string& text, cv::Point org, double scale, const cv::Scalar& color,
+              int thickness);
+cv::Size canvasSize(const OverlayLayer& layer);
+
+// The bar at the bottom center with its percentage, and the frame counter
+// top left. A template so every canvas gets the same layout; 05modular's
+// DrawBench times it on the canvases VideoStreamer draws on.
+template <typename Canvas>
+void drawProgressBar(Canvas& image, double progress, int currentFrame, int totalFrames) {
+    cv::Size size = canvasSize(image);
+    int barWidth = 400;
+    int barHeight = 30;
+    int barX = (size.width - barWidth) / 2;
+    int barY = size.height - 60;
+    
+    // Ensure progress is between 0 and 1
+    progress = std::max(0.0, std::min(1.0, progress));
+    
+    // Draw background rectangle (gray)
+    fillRect(image, 
+             cv::Point(barX, barY), 
+             cv::Point(barX + barWidth, barY + barHeight),
+             cv::Scalar(100, 100, 100));
+    
+    // Draw progress rectangle (green)
+    int progressWidth = static_cast<int>(barWidth * progress);
+    if (progressWidth > 0) {
+        fillRect(image, 
+                 cv::Point(barX, barY), 
+                 cv::Point(barX + progressWidth, barY + barHeight),
+                 cv::Scalar(0, 255, 0));
+    }
+    
+    // Draw border
+    outlineRect(image, 
+                cv::Point(barX, barY), 
+                cv::Point(barX + barWidth, barY + barHeight),
+                cv::Scalar(255, 255, 255), 
+                2);
+    
+    // Add percentage text
+    std::string progressText = std::to_string(static_cast<int>(progress * 100)) + "%";
+    int baseline = 0;
+    cv::Size textSize = cv::getTextSize(progressText, cv::FONT_HERSHEY_SIMPLEX, 0.8, 2, &baseline);
+    cv::Point textOrg(barX + (barWidth - textSize.width) / 2, barY + (barHeight + textSize.height) / 2);
+    
+    drawText(image, progressText, textOrg, 0.8, cv::Scalar(255, 255, 255), 2);
+    
+    // Add frame info
+    std::string frameInfo = "Frame: " + std::to_string(currentFrame) + "/" + std::to_string(totalFrames);
+    drawText(image, frameInfo, cv::Point(10, 30), 0.7, cv::Scalar(255, 255, 255), 2);
+}
+
+#endif // PROGRESS_BAR_H
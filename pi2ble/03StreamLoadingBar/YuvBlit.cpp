@@ -0,0 +1,175 @@
+#include "YuvBlit.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Pixels per chunk: R, G, B planes of this size stay in L1 between steps.
+// The loops below are plain fixed-point arithmetic over these arrays so
+// the compiler can vectorize them (NEON on the Pi, SSE/AVX on a PC).
+const int CHUNK = 128;
+
+inline uint8_t clamp255(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// x / 255, rounded, for x in 0..255*255
+inline int div255(int x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// BT.601 limited range to RGB, 8.8 fixed point, one pixel pair sharing U/V
+inline void convertPair(int y0, int y1, int u, int v, uint8_t* r, uint8_t* g, uint8_t* b) {
+    int c0 = (y0 - 16) * 298 + 128;
+    int c1 = (y1 - 16) * 298 + 128;
+    int d = u - 128;
+    int e = v - 128;
+    int rv = 409 * e;
+    int gv = -100 * d - 208 * e;
+    int bv = 516 * d;
+    r[0] = clamp255((c0 + rv) >> 8);
+    g[0] = clamp255((c0 + gv) >> 8);
+    b[0] = clamp255((c0 + bv) >> 8);
+    r[1] = clamp255((c1 + rv) >> 8);
+    g[1] = clamp255((c1 + gv) >> 8);
+    b[1] = clamp255((c1 + bv) >> 8);
+}
+
+// n pixels (even) starting at pixel x of row y into planar R, G, B
+void convertChunk(const YuvImage& src, int y, int x, int n, uint8_t* r, uint8_t* g, uint8_t* b) {
+    if (src.layout == YUV_YUYV) {
+        const uint8_t* p = src.data + y * src.stride + x * 2;
+        for (int i = 0; i < n; i += 2) {
+            convertPair(p[2 * i], p[2 * i + 2], p[2 * i + 1], p[2 * i + 3], r + i, g + i, b + i);
+        }
+    } else {
+        const uint8_t* luma = src.data + y * src.stride + x;
+        const uint8_t* uv = src.chroma + (y / 2) * src.chromaStride + x;
+        for (int i = 0; i < n; i += 2) {
+            convertPair(luma[i], luma[i + 1], uv[i], uv[i + 1], r + i, g + i, b + i);
+        }
+    }
+}
+
+// Premultiplied "over": out = overlay + out * (255 - alpha) / 255
+void blendChunk(const uint8_t* bgra, int n, uint8_t* r, uint8_t* g, uint8_t* b) {
+    for (int i = 0; i < n; ++i) {
+        int inverse = 255 - bgra[4 * i + 3];
+        b[i] = static_cast<uint8_t>(bgra[4 * i + 0] + div255(b[i] * inverse));
+        g[i] = static_cast<uint8_t>(bgra[4 * i + 1] + div255(g[i] * inverse));
+        r[i] = static_cast<uint8_t>(bgra[4 * i + 2] + div255(r[i] * inverse));
+    }
+}
+
+void packChunk(const uint8_t* r, const uint8_t* g, const uint8_t* b, int n, uint8_t* dst, FramebufferFormat format) {
+    if (format == FB_RGB565) {
+        uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+        for (int i = 0; i < n; ++i) {
+            out[i] = static_cast<uint16_t>(((r[i] >> 3) << 11) | ((g[i] >> 2) << 5) | (b[i] >> 3));
+        }
+    } else if (format == FB_XRGB8888) {
+        uint32_t* out = reinterpret_cast<uint32_t*>(dst);
+        for (int i = 0; i < n; ++i) {
+            out[i] = (static_cast<uint32_t>(r[i]) << 16) | (static_cast<uint32_t>(g[i]) << 8) | b[i];
+        }
+    } else {
+        uint32_t* out = reinterpret_cast<uint32_t*>(dst);
+        for (int i = 0; i < n; ++i) {
+            out[i] = (static_cast<uint32_t>(b[i]) << 16) | (static_cast<uint32_t>(g[i]) << 8) | r[i];
+        }
+    }
+}
+
+// Part of [x, x + n) the overlay covers on row y, false if none
+bool overlaySpan(const OverlaySource& overlay, int y, int x, int n, int width, int& begin, int& end) {
+    begin = overlay.spanBegin ? overlay.spanBegin[y] : 0;
+    end = overlay.spanEnd ? overlay.spanEnd[y] : width;
+    begin = std::max(begin, x);
+    end = std::min(end, x + n);
+    return begin < end;
+}
+
+} // namespace
+
+void blitYuvToFramebuffer(const YuvImage& src, const OverlaySource* overlay, uint8_t* dst, size_t dstStride,
+                          FramebufferFormat format) {
+    uint8_t r[CHUNK];
+    uint8_t g[CHUNK];
+    uint8_t b[CHUNK];
+    size_t bytesPerPixel = framebufferBytesPerPixel(format);
+
+    for (int y = 0; y < src.height; ++y) {
+        uint8_t* dstRow = dst + y * dstStride;
+        for (int x = 0; x < src.width; x += CHUNK) {
+            int n = std::min(CHUNK, src.width - x);
+            convertChunk(src, y, x, n, r, g, b);
+
+            int begin, end;
+            if (overlay && overlaySpan(*overlay, y, x, n, src.width, begin, end)) {
+                blendChunk(overlay->bgra + y * overlay->stride + begin * 4, end - begin, r + (begin - x),
+                           g + (begin - x), b + (begin - x));
+            }
+            packChunk(r, g, b, n, dstRow + x * bytesPerPixel, format);
+        }
+    }
+}
+
+void blendOverBgr(const uint8_t* color, const uint8_t* inverseAlpha, uint8_t* bgr, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        bgr[i] = static_cast<uint8_t>(color[i] + div255(bgr[i] * inverseAlpha[i]));
+    }
+}
+
+void yuvToBgr(const YuvImage& src, uint8_t* bgr, size_t bgrStride) {
+    uint8_t r[CHUNK];
+    uint8_t g[CHUNK];
+    uint8_t b[CHUNK];
+    for (int y = 0; y < src.height; ++y) {
+        uint8_t* row = bgr + y * bgrStride;
+        for (int x = 0; x < src.width; x += CHUNK) {
+            int n = std::min(CHUNK, src.width - x);
+            convertChunk(src, y, x, n, r, g, b);
+            for (int i = 0; i < n; ++i) {
+                row[3 * (x + i) + 0] = b[i];
+                row[3 * (x + i) + 1] = g[i];
+                row[3 * (x + i) + 2] = r[i];
+            }
+        }
+    }
+}
+
+void blendOverlayBgr(uint8_t* bgr, size_t bgrStride, int width, int height, const OverlaySource& overlay) {
+    for (int y = 0; y < height; ++y) {
+        int begin, end;
+        if (!overlaySpan(overlay, y, 0, width, width, begin, end)) continue;
+        uint8_t* row = bgr + y * bgrStride;
+        const uint8_t* bgra = overlay.bgra + y * overlay.stride;
+        for (int x = begin; x < end; ++x) {
+            int inverse = 255 - bgra[4 * x + 3];
+            for (int c = 0; c < 3; ++c) {
+                row[3 * x + c] = static_cast<uint8_t>(bgra[4 * x + c] + div255(row[3 * x + c] * inverse));
+            }
+        }
+    }
+}
+
+void bgrToFramebuffer(const uint8_t* bgr, size_t bgrStride, int width, int height, uint8_t* dst, size_t dstStride,
+                      FramebufferFormat format) {
+    uint8_t r[CHUNK];
+    uint8_t g[CHUNK];
+    uint8_t b[CHUNK];
+    size_t bytesPerPixel = framebufferBytesPerPixel(format);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = bgr + y * bgrStride;
+        for (int x = 0; x < width; x += CHUNK) {
+            int n = std::min(CHUNK, width - x);
+            for (int i = 0; i < n; ++i) {
+                b[i] = row[3 * (x + i) + 0];
+                g[i] = row[3 * (x + i) + 1];
+                r[i] = row[3 * (x + i) + 2];
+            }
+            packChunk(r, g, b, n, dst + y * dstStride + x * bytesPerPixel, format);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef YUV_BLIT_H
+#define YUV_BLIT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Camera frame layouts the blit understands (see CameraSource.h)
+enum YuvLayout {
+    YUV_YUYV, // packed 4:2:2: Y0 U Y1 V
+    YUV_NV12  // Y plane + interleaved UV plane at half resolution
+};
+
+// Framebuffer pixel formats, little endian words
+enum FramebufferFormat {
+    FB_RGB565,   // 16 bpp, R in the top bits (Pi displays, fb_cube)
+    FB_XRGB8888, // 32 bpp, 0x00RRGGBB
+    FB_XBGR8888  // 32 bpp, 0x00BBGGRR
+};
+
+struct YuvImage {
+    YuvLayout layout;
+    int width;  // even
+    int height; // even for NV12
+    const uint8_t* data; // YUYV pixels or the Y plane
+    size_t stride;
+    const uint8_t* chroma; // NV12 UV plane
+    size_t chromaStride;
+};
+
+// Premultiplied-alpha BGRA layer composited during the conversion, the
+// size of the frame. Row y is only blended between spanBegin[y] and
+// spanEnd[y] (pixels, end exclusive); without spans every pixel is.
+struct OverlaySource {
+    const uint8_t* bgra;
+    size_t stride;
+    const uint16_t* spanBegin;
+    const uint16_t* spanEnd;
+};
+
+// Converts a YUV frame (BT.601 limited range) to the framebuffer format
+// and composites the overlay on top, in one pass: each source row is read
+// once and each destination row written once, the RGB in between only
+// lives in a small on-stack chunk. overlay may be null.
+void blitYuvToFramebuffer(const YuvImage& src, const OverlaySource* overlay, uint8_t* dst, size_t dstStride,
+                          FramebufferFormat format);
+
+// Premultiplied "over" onto BGR pixels in place, bytes = 3 * pixels:
+// bgr = color + bgr * inverseAlpha / 255, where color is the overlay's
+// premultiplied BGR and inverseAlpha its 255 - alpha repeated for each
+// channel. In that form every byte blends the same way, so it vectorizes
+// on any SIMD unit; OverlayLayer prepares it when its widgets change.
+void blendOverBgr(const uint8_t* color, const uint8_t* inverseAlpha, uint8_t* bgr, size_t bytes);
+
+// The same steps as separate full-frame passes (YUV -> BGR, blend the
+// overlay onto BGR, BGR -> framebuffer), the way the camera path worked
+// with cvtColor, drawing and blitMatToFB. For comparison in YuvBlitBench.
+void yuvToBgr(const YuvImage& src, uint8_t* bgr, size_t bgrStride);
+void blendOverlayBgr(uint8_t* bgr, size_t bgrStride, int width, int height, const OverlaySource& overlay);
+void bgrToFramebuffer(const uint8_t* bgr, size_t bgrStride, int width, int height, uint8_t* dst, size_t dstStride,
+                      FramebufferFormat format);
+
+inline size_t framebufferBytesPerPixel(FramebufferFormat format) {
+    return format == FB_RGB565 ? 2 : 4;
+}
+
+#endif // YUV_BLIT_H
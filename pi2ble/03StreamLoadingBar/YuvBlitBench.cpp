@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "YuvBlit.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Overlay like the camera mode's: the progress bar near the bottom and a
+// translucent info box top left, everything else transparent
+struct BenchOverlay {
+    std::vector<uint8_t> bgra;
+    std::vector<uint16_t> spanBegin;
+    std::vector<uint16_t> spanEnd;
+    size_t coveredPixels;
+    OverlaySource source;
+
+    BenchOverlay(int width, int height) : bgra(width * height * 4, 0), spanBegin(height, 0), spanEnd(height, 0),
+                                          coveredPixels(0) {
+        int barWidth = std::min(400, width - 20);
+        fill(width, (width - barWidth) / 2, height - 60, barWidth, 30, 100, 255);
+        fill(width, 5, 5, std::min(340, width - 10), 70, 40, 160);
+        source.bgra = bgra.data();
+        source.stride = width * 4;
+        source.spanBegin = spanBegin.data();
+        source.spanEnd = spanEnd.data();
+    }
+
+    void fill(int width, int x, int y, int w, int h, int gray, int alpha) {
+        int premultiplied = gray * alpha / 255;
+        for (int row = y; row < y + h; ++row) {
+            for (int col = x; col < x + w; ++col) {
+                uint8_t* p = &bgra[(row * width + col) * 4];
+                p[0] = p[1] = p[2] = static_cast<uint8_t>(premultiplied);
+                p[3] = static_cast<uint8_t>(alpha);
+            }
+            spanBegin[row] = static_cast<uint16_t>(x);
+            spanEnd[row] = static_cast<uint16_t>(x + w);
+            coveredPixels += w;
+        }
+    }
+};
+
+static const char* layoutName(YuvLayout layout) {
+    return layout == YUV_YUYV ? "YUYV" : "NV12";
+}
+
+static const char* formatName(FramebufferFormat format) {
+    return format == FB_RGB565 ? "RGB565" : (format == FB_XRGB8888 ? "XRGB8888" : "XBGR8888");
+}
+
+// Fused YUV -> framebuffer + overlay kernel against the three full-frame
+// passes it replaces (YUV -> BGR, overlay onto BGR, BGR -> framebuffer).
+// Memory traffic is counted in frame passes: reading the camera frame
+// and writing the framebuffer once is 1.0.
+//
+// Usage: ./YuvBlitBench [width] [height] [frames]
+int main(int argc, char* argv[]) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 640;
+    int height = argc > 2 ? std::atoi(argv[2]) : 480;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 300;
+    width &= ~1;
+    height &= ~1;
+    if (width < 32 || height < 80 || frames <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [width] [height] [frames]" << std::endl;
+        return 1;
+    }
+
+    std::srand(42);
+    std::vector<uint8_t> yuv(width * height * 2);
+    for (size_t i = 0; i < yuv.size(); ++i) yuv[i] = static_cast<uint8_t>(std::rand());
+    BenchOverlay overlay(width, height);
+    std::vector<uint8_t> bgr(width * height * 3);
+    std::vector<uint8_t> fused(width * height * 4);
+    std::vector<uint8_t> separate(width * height * 4);
+
+    const YuvLayout layouts[] = {YUV_YUYV, YUV_NV12};
+    const FramebufferFormat formats[] = {FB_RGB565, FB_XRGB8888};
+    double pixels = static_cast<double>(width) * height;
+    bool identical = true;
+
+    std::cout << width << "x" << height << ", " << frames << " frames, overlay covers " << std::fixed
+              << std::setprecision(1) << 100.0 * overlay.coveredPixels / pixels << "% of the frame" << std::endl;
+    for (int l = 0; l < 2; ++l) {
+        YuvImage src;
+        src.layout = layouts[l];
+        src.width = width;
+        src.height = height;
+        src.data = yuv.data();
+        src.stride = layouts[l] == YUV_YUYV ? width * 2 : width;
+        src.chroma = yuv.data() + width * height;
+        src.chromaStride = width;
+        double srcBytes = layouts[l] == YUV_YUYV ? 2.0 : 1.5;
+
+        for (int f = 0; f < 2; ++f) {
+            FramebufferFormat format = formats[f];
+            size_t dstStride = width * framebufferBytesPerPixel(format);
+
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < frames; ++i) {
+                blitYuvToFramebuffer(src, &overlay.source, fused.data(), dstStride, format);
+            }
+            double fusedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+
+            start = Clock::now();
+            for (int i = 0; i < frames; ++i) {
+                yuvToBgr(src, bgr.data(), width * 3);
+                blendOverlayBgr(bgr.data(), width * 3, width, height, overlay.source);
+                bgrToFramebuffer(bgr.data(), width * 3, width, height, separate.data(), dstStride, format);
+            }
+            double separateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+
+            if (std::memcmp(fused.data(), separate.data(), dstStride * height) != 0) identical = false;
+
+            // Bytes per frame touched in memory; the overlay is read where it covers
+            double dstBytes = static_cast<double>(framebufferBytesPerPixel(format));
+            double onePass = pixels * (srcBytes + dstBytes);
+            double overlayBytes = overlay.coveredPixels * 4.0;
+            double fusedTraffic = onePass + overlayBytes;
+            double separateTraffic = onePass + pixels * 3 * 3 + overlayBytes + overlay.coveredPixels * 3.0 * 2;
+
+            std::cout << "  " << layoutName(src.layout) << " -> " << std::left << std::setw(9) << formatName(format)
+                      << std::right << std::setprecision(2) << " fused " << std::setw(6) << fusedMs << " ms ("
+                      << std::setprecision(2) << fusedTraffic / onePass << " passes)   separate " << std::setw(6)
+                      << separateMs << " ms (" << separateTraffic / onePass << " passes)   "
+                      << std::setprecision(1) << separateMs / fusedMs << "x" << std::endl;
+        }
+    }
+
+    // Compositing onto BGR frames (the OpenCV capture path): the BGRA
+    // blend per pixel against blendOverBgr on the form OverlayLayer
+    // prepares once per redraw
+    std::vector<uint8_t> color(width * height * 3, 0);
+    std::vector<uint8_t> inverseAlpha(width * height * 3, 255);
+    for (int y = 0; y < height; ++y) {
+        for (int x = overlay.spanBegin[y]; x < overlay.spanEnd[y]; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                color[(y * width + x) * 3 + c] = overlay.bgra[(y * width + x) * 4 + c];
+                inverseAlpha[(y * width + x) * 3 + c] = static_cast<uint8_t>(255 - overlay.bgra[(y * width + x) * 4 + 3]);
+            }
+        }
+    }
+    std::vector<uint8_t> frame(width * height * 3);
+    for (size_t i = 0; i < frame.size(); ++i) frame[i] = static_cast<uint8_t>(std::rand());
+    std::vector<uint8_t> perPixel(frame);
+    std::vector<uint8_t> prepared(frame);
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < frames; ++i) {
+        blendOverlayBgr(perPixel.data(), width * 3, width, height, overlay.source);
+    }
+    double perPixelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+
+    start = Clock::now();
+    for (int i = 0; i < frames; ++i) {
+        for (int y = 0; y < height; ++y) {
+            size_t offset = (static_cast<size_t>(y) * width + overlay.spanBegin[y]) * 3;
+            blendOverBgr(&color[offset], &inverseAlpha[offset], &prepared[offset],
+                         (overlay.spanEnd[y] - overlay.spanBegin[y]) * 3);
+        }
+    }
+    double preparedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+    if (perPixel != prepared) identical = false;
+
+    std::cout << "  overlay onto BGR   per pixel " << std::setprecision(3) << perPixelMs << " ms   prepared "
+              << preparedMs << " ms   " << std::setprecision(1) << perPixelMs / preparedMs << "x" << std::endl;
+
+    std::cout << (identical ? "outputs match" : "MISMATCH between the variants")
+              << std::endl;
+    return identical ? 0 : 1;
+}
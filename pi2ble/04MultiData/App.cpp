@@ -1,3 +1,4 @@
+#include "AsyncLog.h"
 #include "Config.h"
 #include "Frame.h"
 #include <chrono>
@@ -19,8 +20,10 @@ class App {
             int frameCount = 0;
             int msBetweenFrames = videoConfig.frameRate > 0 ? 1000 / videoConfig.frameRate : 0;
 
-            std::cout << "Frame rate: " << videoConfig.frameRate << " FPS" << std::endl;
-            std::cout << "Milliseconds between frames: " << msBetweenFrames << " ms" << std::endl;
+            // This thread's log ring is allocated here, not in the first frame
+            AsyncLog::attachThread();
+            LOG_INFO("Frame rate: {} FPS", videoConfig.frameRate);
+            LOG_INFO("Milliseconds between frames: {} ms", msBetweenFrames);
 
             auto lastFrame = std::chrono::steady_clock::now();
 
@@ -33,8 +36,9 @@ class App {
                     frame.addDataPoint("Data Point " + std::to_string(frameCount) + "_" + std::to_string(count));
                     frame.render();
 
-                    std::cout << "frameCount: " + std::to_string(frameCount) << std::endl;
-                    std::cout << "count: " + std::to_string(count) << std::endl;
+                    LOG_DEBUG("frameCount: {}", frameCount);
+                    LOG_DEBUG("count: {}", count);
+                    LOG_EVERY_MS(LOG_LEVEL_INFO, 1000, "frameCount: {} count: {}", frameCount, count);
     
                     char charRead = frame.waitKey(1);
                     if(charRead == 'q' || charRead == 27) {
@@ -47,7 +51,7 @@ class App {
                 count++;
             }
 
-            std::cout << "App finished" << std::endl;
+            LOG_INFO("App finished");
             return;
         }
 };
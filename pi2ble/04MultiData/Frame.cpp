@@ -8,6 +8,8 @@
 
 Frame::Frame(const std::string& winName, int width, int height)
     : windowName(winName), windowWidth(width), windowHeight(height)  {
+    image.create(windowHeight, windowWidth, CV_8UC3);
+    text.reserve(64);
 }
 
 void Frame::addDataPoint(const std::string& data) {
@@ -18,16 +20,20 @@ void Frame::addDataPoint(const std::string& data) {
 void Frame::render() {
     // Implementation for rendering the frame
     // cv::Mat image = cv::Mat(windowHeight, windowWidth, CV_8UC3, cv::Scalar(230, 216, 173)); // Light blue in BGR
-    cv::Mat image = cv::Mat(windowHeight, windowWidth, CV_8UC3, cv::Scalar(255, 255, 255)); // Light blue in BGR
+    image.setTo(cv::Scalar(255, 255, 255)); // Light blue in BGR
 
     // cv::putText(image, "Sample Frame for OpenCV Demo", cv::Point(150, 300), 
     //             cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(50, 50, 50), 2);
     // cv::putText(image, "hi: " + count, cv::Point(150, 300), 
     //             cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(50, 50, 50), 2);
-    cv::putText(image, "hi: " + count, cv::Point(windowWidth / 5, windowHeight / 2), 
+    text.assign("hi: ");
+    text += count;
+    cv::putText(image, text, cv::Point(windowWidth / 5, windowHeight / 2), 
                 cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(50, 50, 50), 2);
     // Draw Velocity
-    cv::putText(image, "velo: " + velocity, cv::Point(windowWidth / 2 - 10, windowHeight - 20),
+    text.assign("velo: ");
+    text += velocity;
+    cv::putText(image, text, cv::Point(windowWidth / 2 - 10, windowHeight - 20),
                 cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(50,50,50), 1);
     cv::imshow(windowName, image);
     // cv::waitKey(0); // Wait for a key press to close the window
@@ -10,6 +10,9 @@ private:
     int windowHeight = 240;
     std::string count;
     std::string velocity = "0";
+    // Drawn on again every frame instead of allocating a new one
+    cv::Mat image;
+    std::string text;
 public:
     Frame(const std::string& winName, int width, int height);
     void addDataPoint(const std::string& data);
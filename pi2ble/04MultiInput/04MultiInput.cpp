@@ -1,5 +1,7 @@
 #include "SensorSimulator.h"
 #include "DataVisualizer.h"
+#include "Trace.h"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -36,19 +38,31 @@ public:
         visualizer.setConfig(config);
     }
     
+    // window (default), fb[:device], null or ppm[:prefix]
+    void setSink(const std::string& spec) {
+        visualizer.setSink(makeFrameSink(spec, "Multi-Input Data Visualization"));
+    }
+    
     void run() {
         std::cout << "Starting Multi-Input Data Visualization..." << std::endl;
         std::cout << "Simulating Temperature, Wind Speed, and Humidity data" << std::endl;
         std::cout << "Data update interval: " << config.updateIntervalMs << "ms" << std::endl;
-        std::cout << "Press 'q' or ESC in the window to quit" << std::endl;
+        std::cout << "Press 'q' or ESC in the window to quit, 'h' for the performance HUD" << std::endl;
         
         auto lastUpdate = std::chrono::steady_clock::now();
+        FrameStats& stats = visualizer.frameStats();
+        auto framePeriod = std::chrono::microseconds(1000000 / std::max(1, config.targetFps));
+        auto nextFrame = lastUpdate;
+        TRACE_START("04MultiInput.trace.json");
+        TRACE_THREAD_NAME("render");
         
         while (running) {
+            stats.beginFrame();
             auto now = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate);
             
             if (elapsed.count() >= config.updateIntervalMs) {
+                TRACE_SCOPE("ingest");
                 // Generate new sensor reading
                 SensorReading reading = simulator.generateReading();
                 
@@ -57,6 +71,7 @@ public:
                 
                 lastUpdate = now;
             }
+            stats.endStage(STAGE_INGEST);
             
             // Render visualization
             visualizer.render();
@@ -65,11 +80,19 @@ public:
             if (visualizer.shouldClose()) {
                 running = false;
             }
+            stats.endFrame();
+            visualizer.adaptQuality();
             
-            // Small delay to prevent excessive CPU usage
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // Wait for the next frame deadline; a late frame starts the next
+            // period from now instead of rushing to catch up
+            nextFrame += framePeriod;
+            auto frameEnd = std::chrono::steady_clock::now();
+            if (nextFrame < frameEnd) nextFrame = frameEnd;
+            std::this_thread::sleep_until(nextFrame);
         }
         
+        TRACE_STOP();
+        stats.print(std::cout);
         std::cout << "Application shutting down..." << std::endl;
     }
     
@@ -85,13 +108,26 @@ public:
                   << "Amplitude=±" << config.humidityAmplitude << "%, "
                   << "Frequency=" << config.humidityFrequency << " Hz" << std::endl;
         std::cout << "Max Data Points: " << config.maxDataPoints << std::endl;
+        std::cout << "Target FPS: " << config.targetFps << ", adaptive quality "
+                  << (config.adaptiveQuality ? "on" : "off") << std::endl;
         std::cout << "==============================\n" << std::endl;
     }
 };
 
-int main(int /* argc */, char* /* argv */[]) {
+// Stages (ingest, render, graphs, text, blit, flip) are traced with
+// TRACE_SCOPE: build with `make trace` and open 04MultiInput.trace.json in
+// chrome://tracing or Perfetto.
+//
+// Usage: ./04MultiInput [sink]
+//   sink: window (default), fb[:/dev/fbN] to draw straight onto a
+//   framebuffer, null to render without showing, ppm[:prefix] to dump
+//   every frame as prefix000000.ppm...
+int main(int argc, char* argv[]) {
     try {
         MultiInputApp app;
+        if (argc > 1) {
+            app.setSink(argv[1]);
+        }
         
         // Print configuration
         app.printConfiguration();
@@ -0,0 +1,73 @@
+#include "AllocationCounter.h"
+#include "DataVisualizer.h"
+#include "SensorSimulator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// Renders the visualizer headless, the way MultiInputApp drives it (a new
+// reading, then a frame), and counts heap allocations per frame once it
+// is warmed up: the reading ring full and every pooled surface drawn on.
+// Runs the frames at every quality level, pinned, and once more switching
+// level every few frames the way the governor would. Exits non-zero if
+// any steady-state frame allocated.
+//
+// Usage: ./AllocCheck [frames]
+//   frames per run (default 1000)
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    if (frames <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [frames]" << std::endl;
+        return 1;
+    }
+
+    SensorConfig config;
+    config.maxDataPoints = 200;
+    SensorSimulator simulator(config);
+    DataVisualizer visualizer;
+    visualizer.setConfig(config);
+    visualizer.setShowHud(true);
+    FrameStats& stats = visualizer.frameStats();
+
+    for (int i = 0; i < config.maxDataPoints + 10; ++i) {
+        visualizer.setQualityLevel(static_cast<QualityLevel>(i % QUALITY_LEVEL_COUNT));
+        stats.beginFrame();
+        visualizer.addDataPoint(simulator.generateReading());
+        visualizer.renderFrame();
+        stats.endFrame();
+    }
+
+    bool clean = true;
+    for (int level = 0; level <= QUALITY_LEVEL_COUNT; ++level) {
+        bool switching = level == QUALITY_LEVEL_COUNT;
+        if (!switching) visualizer.setQualityLevel(static_cast<QualityLevel>(level));
+        stats.reset();
+
+        size_t total = 0;
+        size_t worst = 0;
+        int allocatingFrames = 0;
+        for (int i = 0; i < frames; ++i) {
+            size_t before = AllocationCounter::count();
+            if (switching && i % 7 == 0) {
+                visualizer.setQualityLevel(static_cast<QualityLevel>((i / 7) % QUALITY_LEVEL_COUNT));
+            }
+            stats.beginFrame();
+            visualizer.addDataPoint(simulator.generateReading());
+            stats.endStage(STAGE_INGEST);
+            visualizer.renderFrame();
+            stats.endFrame();
+            size_t allocations = AllocationCounter::count() - before;
+            total += allocations;
+            worst = std::max(worst, allocations);
+            if (allocations > 0) allocatingFrames++;
+        }
+
+        std::cout << "Quality " << (switching ? "switching" : QualityGovernor::levelName(visualizer.qualityLevel()))
+                  << ": ";
+        stats.print(std::cout);
+        std::cout << frames << " steady-state frames: " << total << " allocations, " << allocatingFrames
+                  << " frames allocated, at most " << worst << " in one frame" << std::endl;
+        if (total > 0) clean = false;
+    }
+    return clean ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// Counts heap allocations made through operator new, to check that the
+// render loop doesn't allocate once it is warmed up. The counting
+// operator new is in AllocationCounter.cpp and only linked into the
+// allocation check (make alloccheck), which defines ALLOCATION_COUNTER;
+// everywhere else these are no-ops.
+namespace AllocationCounter {
+
+#ifdef ALLOCATION_COUNTER
+size_t count();
+#else
+inline size_t count() { return 0; }
+#endif
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATION_COUNTER_H
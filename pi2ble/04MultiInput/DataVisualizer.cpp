@@ -1,16 +1,27 @@
 #include "DataVisualizer.h"
+#include "Trace.h"
+#include "GraphDraw.h"
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+// Stroke width of text drawn at a render scale
+static int strokeAt(int thickness, double scale) {
+    return std::max(1, static_cast<int>(thickness * scale + 0.5));
+}
+
+DataVisualizer::TextGlyphs::TextGlyphs(double scale)
+    : values(0.6 * scale, strokeAt(2, scale)), count(0.6 * scale, strokeAt(1, scale)),
+      column(0.5 * scale, strokeAt(1, scale)), waiting(1.0 * scale, strokeAt(2, scale)) {
+}
 
 DataVisualizer::DataVisualizer(const std::string& winName, int width, int height)
-    : windowName(winName), windowWidth(width), windowHeight(height) {
-    
-    // Initialize graph properties
-    graphMargin = 60;
-    headerHeight = 100;
-    graphHeight = (windowHeight - headerHeight - 4 * graphMargin) / 3;
-    graphWidth = windowWidth - 2 * graphMargin;
+    : windowWidth(width), windowHeight(height), oldest(0), readingCount(0),
+      sink(new WindowSink(winName)), frames(width, height, CV_8UC3), halfFrames(width / 2, height / 2, CV_8UC3, 1),
+      tempLabel("Temperature (°C)"), windLabel("Wind Speed (km/h)"), humidityLabel("Humidity (%)"),
+      hudGlyphs(0.5, 1), showHud(false), fullGlyphs(1.0), halfGlyphs(0.5),
+      scaleRow(static_cast<size_t>(width / 2) * 3), textFrame(0) {
     
     // Initialize colors
     tempColor = cv::Scalar(0, 0, 255);      // Red for temperature
@@ -20,101 +31,283 @@ DataVisualizer::DataVisualizer(const std::string& winName, int width, int height
     textColor = cv::Scalar(255, 255, 255);  // White text
     gridColor = cv::Scalar(80, 80, 80);     // Light gray grid
     
-    // Create window
-    cv::namedWindow(windowName, cv::WINDOW_AUTOSIZE);
+    text.reserve(128);
+    
+    // Both render scales are drawn up front so switching quality doesn't allocate
+    applyLayout(0.5);
+    halfStaticLayer.create(renderHeight, renderWidth, CV_8UC3);
+    drawStaticLayer(halfStaticLayer);
+    halfTextCache.create(renderHeight, renderWidth, CV_8UC3);
+    applyLayout(1.0);
+    staticLayer.create(windowHeight, windowWidth, CV_8UC3);
+    drawStaticLayer(staticLayer);
+    textCache.create(windowHeight, windowWidth, CV_8UC3);
+    
+    setConfig(config);
+    setQualityLevel(QUALITY_FULL);
 }
 
-void DataVisualizer::addDataPoint(const SensorReading& reading) {
-    dataBuffer.push_back(reading);
+// Geometry at a render scale; coordinates below go through px()
+void DataVisualizer::applyLayout(double scale) {
+    renderScale = scale;
+    renderWidth = static_cast<int>(windowWidth * scale);
+    renderHeight = static_cast<int>(windowHeight * scale);
+    
+    // Initialize graph properties
+    graphMargin = px(60);
+    headerHeight = px(100);
+    graphHeight = (renderHeight - headerHeight - 4 * graphMargin) / 3;
+    graphWidth = renderWidth - 2 * graphMargin;
     
-    // Limit buffer size
-    while (dataBuffer.size() > static_cast<size_t>(config.maxDataPoints)) {
-        dataBuffer.pop_front();
+    // Where the text redrawn every frame goes: the header band and the
+    // column right of the graphs
+    int columnX = graphMargin + graphWidth + px(6);
+    headerBand = cv::Rect(0, 0, renderWidth, headerHeight);
+    valueColumn = cv::Rect(columnX, headerHeight, renderWidth - columnX, renderHeight - headerHeight);
+}
+
+void DataVisualizer::setQualityLevel(QualityLevel level) {
+    governor.reset(level);
+    applyQuality(level);
+}
+
+void DataVisualizer::applyQuality(QualityLevel level) {
+    quality = level;
+    lineType = level >= QUALITY_PLAIN_LINES ? cv::LINE_8 : cv::LINE_AA;
+    applyLayout(level >= QUALITY_HALF_RES ? 0.5 : 1.0);
+    maxGraphPoints = level >= QUALITY_FEWER_SAMPLES ? static_cast<size_t>(std::max(2, graphWidth / 8)) : 0;
+    textInterval = level >= QUALITY_SLOW_TEXT ? 5 : 1;
+    // Redraw on the next frame, the cache may be from the other scale
+    textFrame = 0;
+}
+
+void DataVisualizer::adaptQuality() {
+    if (governor.update(stats.lastFrameUs())) {
+        applyQuality(governor.level());
+        std::cout << "Quality " << governor.transition() << std::endl;
     }
 }
 
-void DataVisualizer::render() {
-    cv::Mat image(windowHeight, windowWidth, CV_8UC3, bgColor);
+void DataVisualizer::setConfig(const SensorConfig& cfg) {
+    config = cfg;
+    showHud = config.showHud;
+    governor.setTargetFps(config.targetFps);
+    governor.setEnabled(config.adaptiveQuality);
+    size_t capacity = static_cast<size_t>(std::max(1, config.maxDataPoints));
+    
+    // Keep the newest readings that still fit
+    std::vector<SensorReading> kept;
+    size_t keep = std::min(readingCount, capacity);
+    for (size_t i = readingCount - keep; i < readingCount; ++i) {
+        kept.push_back(readings[(oldest + i) % readings.size()]);
+    }
+    readings = kept;
+    readings.resize(capacity);
+    oldest = 0;
+    readingCount = keep;
     
-    if (dataBuffer.empty()) {
-        cv::putText(image, "Waiting for data...", cv::Point(50, 50), 
-                   cv::FONT_HERSHEY_SIMPLEX, 1.0, textColor, 2);
-        cv::imshow(windowName, image);
-        return;
+    tempData.reserve(capacity);
+    windData.reserve(capacity);
+    humidityData.reserve(capacity);
+}
+
+void DataVisualizer::addDataPoint(const SensorReading& reading) {
+    // Full: overwrite the oldest reading
+    if (readingCount < readings.size()) {
+        readings[(oldest + readingCount) % readings.size()] = reading;
+        readingCount++;
+    } else {
+        readings[oldest] = reading;
+        oldest = (oldest + 1) % readings.size();
     }
+}
+
+const SensorReading& DataVisualizer::latest() const {
+    return readings[(oldest + readingCount - 1) % readings.size()];
+}
+
+void DataVisualizer::setSink(std::unique_ptr<FrameSink> frameSink) {
+    sink = std::move(frameSink);
+}
+
+void DataVisualizer::render() {
+    const cv::Mat* frame;
+    {
+        TRACE_SCOPE("render");
+        frame = &renderFrame();
+    }
+    TRACE_SCOPE("blit");
+    sink->show(*frame);
+    stats.endStage(STAGE_BLIT);
+}
+
+const cv::Mat& DataVisualizer::renderFrame() {
+    cv::Mat& output = frames.next();
+    bool half = renderScale < 1.0;
+    cv::Mat& image = half ? halfFrames.next() : output;
     
-    const SensorReading& latestReading = dataBuffer.back();
+    if (readingCount == 0) {
+        image.setTo(bgColor);
+        glyphs().waiting.draw(image, "Waiting for data...", cv::Point(px(50), px(50)), textColor);
+        if (half) scaleUp(image, output);
+        stats.endStage(STAGE_TEXT);
+        return output;
+    }
     
-    // Draw header with current values
-    drawHeader(image, latestReading);
+    (half ? halfStaticLayer : staticLayer).copyTo(image);
+    stats.endStage(STAGE_STATIC);
     
     // Extract data for each sensor type
-    std::vector<double> tempData = extractTemperatureData();
-    std::vector<double> windData = extractWindSpeedData();
-    std::vector<double> humidityData = extractHumidityData();
+    extractData();
     
     // Draw graphs
-    int yOffset = headerHeight;
-    drawGraph(image, tempData, tempColor, -30.0, 50.0, yOffset, "Temperature", "°C");
+    int tempOffset = headerHeight;
+    int windOffset = tempOffset + graphHeight + graphMargin;
+    int humidityOffset = windOffset + graphHeight + graphMargin;
+    {
+        TRACE_SCOPE("graphs");
+        drawGraph(image, tempData, tempColor, -30.0, 50.0, tempOffset);
+        drawGraph(image, windData, windColor, 0.0, 100.0, windOffset);
+        drawGraph(image, humidityData, humidityColor, 0.0, 100.0, humidityOffset);
+    }
+    stats.endStage(STAGE_GRAPHS);
     
-    yOffset += graphHeight + graphMargin;
-    drawGraph(image, windData, windColor, 0.0, 100.0, yOffset, "Wind Speed", "km/h");
+    // Header with current values and the value column, or the last ones
+    // drawn when this frame skips them
+    TRACE_SCOPE("text");
+    cv::Mat& cache = half ? halfTextCache : textCache;
+    if (textFrame == 0) {
+        drawHeader(image, latest());
+        drawCurrentValue(image, tempData, tempColor, -30.0, 50.0, tempOffset);
+        drawCurrentValue(image, windData, windColor, 0.0, 100.0, windOffset);
+        drawCurrentValue(image, humidityData, humidityColor, 0.0, 100.0, humidityOffset);
+        if (textInterval > 1) {
+            image(headerBand).copyTo(cache(headerBand));
+            image(valueColumn).copyTo(cache(valueColumn));
+        }
+    } else {
+        cache(headerBand).copyTo(image(headerBand));
+        cache(valueColumn).copyTo(image(valueColumn));
+    }
+    textFrame = (textFrame + 1) % textInterval;
     
-    yOffset += graphHeight + graphMargin;
-    drawGraph(image, humidityData, humidityColor, 0.0, 100.0, yOffset, "Humidity", "%");
+    if (half) scaleUp(image, output);
     
-    // Draw legend
-    if (++fifthFrameCount % 5 == 0) {
-        drawLegend(image);
+    // At full resolution, so it stays readable at every level
+    if (showHud) {
+        drawHud(output);
     }
-    // drawLegend(image);
+    stats.endStage(STAGE_TEXT);
     
-    cv::imshow(windowName, image);
+    return output;
 }
 
-void DataVisualizer::drawHeader(cv::Mat& image, const SensorReading& latestReading) {
+// Bilinear 2x upscale of the half-res frame (image) onto the window-size
+// output, pixel centers aligned as in cv::INTER_LINEAR: every output pixel
+// is 9/16 of its nearest source pixel, 3/16 of each of the next ones in x
+// and y and 1/16 of the diagonal one. Written out because cv::resize
+// reserves its coefficient tables on every call; scaleRow is sized from
+// halfFrames up front. A last odd row or column repeats the one before.
+void DataVisualizer::scaleUp(const cv::Mat& image, cv::Mat& output) {
+    const int cols = image.cols;
+    const int rows = image.rows;
+    uint16_t* blended = scaleRow.data();
+    
+    for (int y = 0; y < output.rows; ++y) {
+        int row = std::min(y / 2, rows - 1);
+        int neighbor = (y % 2 == 0) ? std::max(row - 1, 0) : std::min(row + 1, rows - 1);
+        const uint8_t* near = image.ptr<uint8_t>(row);
+        const uint8_t* far = image.ptr<uint8_t>(neighbor);
+        for (int i = 0; i < cols * 3; ++i) {
+            blended[i] = static_cast<uint16_t>(3 * near[i] + far[i]);
+        }
+        
+        // Edge pixels blend with themselves, the rest without bounds checks
+        uint8_t* out = output.ptr<uint8_t>(y);
+        for (int c = 0; c < 3; ++c) {
+            out[c] = static_cast<uint8_t>((4 * blended[c] + 8) >> 4);
+            out[6 * cols - 3 + c] = static_cast<uint8_t>((4 * blended[3 * cols - 3 + c] + 8) >> 4);
+        }
+        for (int x = 0; x < cols - 1; ++x) {
+            const uint16_t* p = blended + 3 * x;
+            uint8_t* o = out + 6 * x + 3;
+            for (int c = 0; c < 3; ++c) {
+                o[c] = static_cast<uint8_t>((3 * p[c] + p[c + 3] + 8) >> 4);
+                o[c + 3] = static_cast<uint8_t>((p[c] + 3 * p[c + 3] + 8) >> 4);
+            }
+        }
+        for (int x = 2 * cols; x < output.cols; ++x) {
+            for (int c = 0; c < 3; ++c) out[3 * x + c] = out[3 * (x - 1) + c];
+        }
+    }
+}
+
+// Everything that doesn't depend on the data
+void DataVisualizer::drawStaticLayer(cv::Mat& image) {
+    image.setTo(bgColor);
+    
     // Background for header
-    cv::rectangle(image, cv::Point(0, 0), cv::Point(windowWidth, headerHeight), 
+    cv::rectangle(image, cv::Point(0, 0), cv::Point(renderWidth, headerHeight), 
                  cv::Scalar(60, 60, 60), -1);
     
     // Title
-    cv::putText(image, "Real-time Sensor Data Monitor", cv::Point(20, 30), 
-               cv::FONT_HERSHEY_SIMPLEX, 1.0, textColor, 2);
+    drawText(image, formatText("Real-time Sensor Data Monitor"), cv::Point(px(20), px(30)), 1.0, textColor, 2);
+    
+    int yOffset = headerHeight;
+    drawGraphFrame(image, tempColor, -30.0, 50.0, yOffset, tempLabel);
+    
+    yOffset += graphHeight + graphMargin;
+    drawGraphFrame(image, windColor, 0.0, 100.0, yOffset, windLabel);
     
-    // Current values
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(1);
+    yOffset += graphHeight + graphMargin;
+    drawGraphFrame(image, humidityColor, 0.0, 100.0, yOffset, humidityLabel);
+    
+    drawLegend(image);
+}
+
+// Text of the static layers, drawn once at startup. cv::putText reserves
+// a point buffer on every call, so text redrawn per frame goes through
+// the glyph caches instead. Scale and thickness are at full resolution.
+void DataVisualizer::drawText(cv::Mat& image, const std::string& str, cv::Point org, double scale,
+                              const cv::Scalar& color, int thickness) {
+    cv::putText(image, str, org, cv::FONT_HERSHEY_SIMPLEX, scale * renderScale, color,
+                strokeAt(thickness, renderScale));
+}
+
+// printf into the reused text buffer; valid until the next call
+const std::string& DataVisualizer::formatText(const char* format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    text.assign(buffer);
+    return text;
+}
+
+// Current values; the rest of the header is on the static layer
+void DataVisualizer::drawHeader(cv::Mat& image, const SensorReading& latestReading) {
+    const TextGlyphs& g = glyphs();
     
     // Temperature
-    ss.str("");
-    ss << "Temp: " << latestReading.temperature << "°C";
-    cv::putText(image, ss.str(), cv::Point(20, 65), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.6, tempColor, 2);
+    g.values.draw(image, formatText("Temp: %.1f°C", latestReading.temperature).c_str(), cv::Point(px(20), px(65)),
+                  tempColor);
     
     // Wind Speed
-    ss.str("");
-    ss << "Wind: " << latestReading.windSpeed << " km/h";
-    cv::putText(image, ss.str(), cv::Point(200, 65), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.6, windColor, 2);
+    g.values.draw(image, formatText("Wind: %.1f km/h", latestReading.windSpeed).c_str(), cv::Point(px(200), px(65)),
+                  windColor);
     
     // Humidity
-    ss.str("");
-    ss << "Humidity: " << latestReading.humidity << "%";
-    cv::putText(image, ss.str(), cv::Point(400, 65), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.6, humidityColor, 2);
+    g.values.draw(image, formatText("Humidity: %.1f%%", latestReading.humidity).c_str(), cv::Point(px(400), px(65)),
+                  humidityColor);
     
     // Data points count
-    ss.str("");
-    ss << "Data Points: " << dataBuffer.size();
-    cv::putText(image, ss.str(), cv::Point(windowWidth - 200, 65), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.6, textColor, 1);
+    g.count.draw(image, formatText("Data Points: %d", static_cast<int>(readingCount)).c_str(),
+                 cv::Point(renderWidth - px(200), px(65)), textColor);
 }
 
-void DataVisualizer::drawGraph(cv::Mat& image, const std::vector<double>& data, 
-                              cv::Scalar color, double minVal, double maxVal, 
-                              int yOffset, const std::string& label, const std::string& unit) {
-    if (data.empty()) return;
-    
+void DataVisualizer::drawGraphFrame(cv::Mat& image, cv::Scalar color, double minVal, double maxVal,
+                                    int yOffset, const std::string& label) {
     // Draw background
     cv::rectangle(image, cv::Point(graphMargin, yOffset), 
                  cv::Point(graphMargin + graphWidth, yOffset + graphHeight), 
@@ -129,53 +322,34 @@ void DataVisualizer::drawGraph(cv::Mat& image, const std::vector<double>& data,
                  gridColor, 1);
     
     // Draw label
-    cv::putText(image, label + " (" + unit + ")", cv::Point(graphMargin, yOffset - 10), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.6, color, 2);
+    drawText(image, label, cv::Point(graphMargin, yOffset - px(10)), 0.6, color, 2);
     
     // Draw min/max labels
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(1) << maxVal;
-    cv::putText(image, ss.str(), cv::Point(5, yOffset + 15), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.4, textColor, 1);
-    
-    ss.str("");
-    ss << std::fixed << std::setprecision(1) << minVal;
-    cv::putText(image, ss.str(), cv::Point(5, yOffset + graphHeight - 5), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.4, textColor, 1);
-    
-    // Draw data points
-    if (data.size() > 1) {
-        for (size_t i = 1; i < data.size(); ++i) {
-            // Calculate positions
-            double x1 = graphMargin + (static_cast<double>(i - 1) / (data.size() - 1)) * graphWidth;
-            double x2 = graphMargin + (static_cast<double>(i) / (data.size() - 1)) * graphWidth;
-            
-            double y1 = yOffset + graphHeight - ((data[i - 1] - minVal) / (maxVal - minVal)) * graphHeight;
-            double y2 = yOffset + graphHeight - ((data[i] - minVal) / (maxVal - minVal)) * graphHeight;
-            
-            // Clamp Y coordinates
-            y1 = std::max(static_cast<double>(yOffset), std::min(static_cast<double>(yOffset + graphHeight), y1));
-            y2 = std::max(static_cast<double>(yOffset), std::min(static_cast<double>(yOffset + graphHeight), y2));
-            
-            cv::line(image, cv::Point(static_cast<int>(x1), static_cast<int>(y1)), 
-                    cv::Point(static_cast<int>(x2), static_cast<int>(y2)), color, 2);
-        }
-    }
+    drawText(image, formatText("%.1f", maxVal), cv::Point(px(5), yOffset + px(15)), 0.4, textColor, 1);
+    drawText(image, formatText("%.1f", minVal), cv::Point(px(5), yOffset + graphHeight - px(5)), 0.4, textColor, 1);
+}
+
+// Y of a value in a graph, clamped to the graph
+double DataVisualizer::valueY(double value, double minVal, double maxVal, int yOffset) const {
+    return seriesY(cv::Rect(graphMargin, yOffset, graphWidth, graphHeight), value, minVal, maxVal);
+}
+
+// Every sample, or every stride-th when the level caps the vertex count
+// (the newest always included), see GraphDraw.h
+void DataVisualizer::drawGraph(cv::Mat& image, const std::vector<double>& data, 
+                              cv::Scalar color, double minVal, double maxVal, int yOffset) {
+    SeriesStyle style = {std::max(1, px(2)), lineType, maxGraphPoints, std::max(1, px(4)), px(5)};
+    drawSeries(image, data, cv::Rect(graphMargin, yOffset, graphWidth, graphHeight), minVal, maxVal, color, style);
+}
+
+void DataVisualizer::drawCurrentValue(cv::Mat& image, const std::vector<double>& data,
+                                      cv::Scalar color, double minVal, double maxVal, int yOffset) {
+    if (data.empty()) return;
     
-    // Draw current value indicator
-    if (!data.empty()) {
-        double currentVal = data.back();
-        double y = yOffset + graphHeight - ((currentVal - minVal) / (maxVal - minVal)) * graphHeight;
-        y = std::max(static_cast<double>(yOffset), std::min(static_cast<double>(yOffset + graphHeight), y));
-        
-        cv::circle(image, cv::Point(graphMargin + graphWidth - 5, static_cast<int>(y)), 4, color, -1);
-        
-        // Current value text
-        std::stringstream currentSs;
-        currentSs << std::fixed << std::setprecision(1) << currentVal;
-        cv::putText(image, currentSs.str(), cv::Point(graphMargin + graphWidth + 10, static_cast<int>(y) + 5), 
-                   cv::FONT_HERSHEY_SIMPLEX, 0.5, color, 1);
-    }
+    double currentVal = data.back();
+    double y = valueY(currentVal, minVal, maxVal, yOffset);
+    glyphs().column.draw(image, formatText("%.1f", currentVal).c_str(),
+                         cv::Point(graphMargin + graphWidth + px(10), static_cast<int>(y) + px(5)), color);
 }
 
 void DataVisualizer::drawGrid(cv::Mat& image, int yOffset) {
@@ -195,38 +369,47 @@ void DataVisualizer::drawGrid(cv::Mat& image, int yOffset) {
 }
 
 void DataVisualizer::drawLegend(cv::Mat& image) {
-    int legendX = windowWidth - 150;
-    int legendY = windowHeight - 80;
+    int legendX = renderWidth - px(150);
+    int legendY = renderHeight - px(80);
     
-    cv::putText(image, "Press 'q' to quit", cv::Point(legendX, legendY), 
-               cv::FONT_HERSHEY_SIMPLEX, 0.5, textColor, 1);
+    drawText(image, formatText("Press 'q' to quit"), cv::Point(legendX, legendY), 0.5, textColor, 1);
 }
 
-bool DataVisualizer::shouldClose() {
-    char key = cv::waitKey(1) & 0xFF;
-    return (key == 'q' || key == 27); // 'q' or ESC
-}
-
-std::vector<double> DataVisualizer::extractTemperatureData() const {
-    std::vector<double> data;
-    for (const auto& reading : dataBuffer) {
-        data.push_back(reading.temperature);
-    }
-    return data;
+// FPS, p99 frame time, the stage with the worst p99 and the quality
+// level, top right.
+// Stamped from cached glyphs, so showing it costs next to nothing.
+void DataVisualizer::drawHud(cv::Mat& image) {
+    FrameStage worst = stats.worstStage();
+    char line[96];
+    std::snprintf(line, sizeof(line), "%.0f fps  p99 %.1f ms  %s %.1f ms  %s", stats.fps(),
+                  stats.frameTimes().percentile(99) / 1000.0, FrameStats::stageName(worst),
+                  stats.stage(worst).percentile(99) / 1000.0, QualityGovernor::levelName(quality));
+    
+    int width = hudGlyphs.textWidth(line);
+    cv::Point org(windowWidth - width - 10, 26);
+    cv::rectangle(image, cv::Point(org.x - 6, 8), cv::Point(windowWidth - 4, 34), cv::Scalar(0, 0, 0), -1);
+    hudGlyphs.draw(image, line, org, cv::Scalar(0, 255, 255));
 }
 
-std::vector<double> DataVisualizer::extractWindSpeedData() const {
-    std::vector<double> data;
-    for (const auto& reading : dataBuffer) {
-        data.push_back(reading.windSpeed);
+bool DataVisualizer::shouldClose() {
+    TRACE_SCOPE("flip");
+    char key = sink->pollKey() & 0xFF;
+    stats.endStage(STAGE_FLIP);
+    if (key == 'h') {
+        showHud = !showHud;
     }
-    return data;
+    return (key == 'q' || key == 27); // 'q' or ESC
 }
 
-std::vector<double> DataVisualizer::extractHumidityData() const {
-    std::vector<double> data;
-    for (const auto& reading : dataBuffer) {
-        data.push_back(reading.humidity);
+// Into the reused per-sensor buffers, oldest first
+void DataVisualizer::extractData() {
+    tempData.clear();
+    windData.clear();
+    humidityData.clear();
+    for (size_t i = 0; i < readingCount; ++i) {
+        const SensorReading& reading = readings[(oldest + i) % readings.size()];
+        tempData.push_back(reading.temperature);
+        windData.push_back(reading.windSpeed);
+        humidityData.push_back(reading.humidity);
     }
-    return data;
 }
@@ -2,23 +2,87 @@
 #define DATA_VISUALIZER_H
 
 #include "SensorData.h"
+#include "FramePool.h"
+#include "FrameSink.h"
+#include "FrameStats.h"
+#include "GlyphCache.h"
+#include "QualityGovernor.h"
 #include <opencv2/opencv.hpp>
-#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
 
 class DataVisualizer {
 private:
-    std::string windowName;
     int windowWidth;
     int windowHeight;
-    std::deque<SensorReading> dataBuffer;
+    // Last config.maxDataPoints readings, a ring starting at oldest
+    std::vector<SensorReading> readings;
+    size_t oldest;
+    size_t readingCount;
     SensorConfig config;
-    int fifthFrameCount = 0;
+    std::unique_ptr<FrameSink> sink;
     
-    // Graph properties
+    // Everything a frame needs is allocated up front and reused, so the
+    // render loop doesn't allocate once it runs (see make alloccheck)
+    FramePool frames;
+    FramePool halfFrames;
+    std::vector<double> tempData;
+    std::vector<double> windData;
+    std::vector<double> humidityData;
+    std::string tempLabel;
+    std::string windLabel;
+    std::string humidityLabel;
+    std::string text;
+    
+    // Backgrounds, grids, borders, labels and legend: drawn once, copied
+    // per frame. One per render scale.
+    cv::Mat staticLayer;
+    cv::Mat halfStaticLayer;
+    // The header values and value column as last drawn, copied back in on
+    // frames that skip redrawing them (QUALITY_SLOW_TEXT)
+    cv::Mat textCache;
+    cv::Mat halfTextCache;
+    
+    FrameStats stats;
+    GlyphCache hudGlyphs;
+    bool showHud;
+    
+    // Text redrawn every frame is stamped from glyphs, cv::putText
+    // allocates on every call. One set per render scale.
+    struct TextGlyphs {
+        GlyphCache values;  // header values
+        GlyphCache count;   // data point count
+        GlyphCache column;  // value column
+        GlyphCache waiting; // before the first reading
+        
+        explicit TextGlyphs(double scale);
+    };
+    TextGlyphs fullGlyphs;
+    TextGlyphs halfGlyphs;
+    // One row of the half-res frame blended vertically, for scaleUp
+    std::vector<uint16_t> scaleRow;
+    
+    // What the current quality level draws
+    QualityGovernor governor;
+    QualityLevel quality;
+    int lineType;
+    size_t maxGraphPoints; // 0: every sample
+    int textInterval;      // frames per redraw of the values
+    int textFrame;
+    
+    // Surface being drawn on: the window, or half of it at QUALITY_HALF_RES
+    double renderScale;
+    int renderWidth;
+    int renderHeight;
+    
+    // Graph properties, at renderScale
     int graphHeight;
     int graphWidth;
     int graphMargin;
     int headerHeight;
+    cv::Rect headerBand;
+    cv::Rect valueColumn;
     
     // Colors for different data types
     cv::Scalar tempColor;
@@ -33,21 +97,55 @@ public:
                    int width = 1200, int height = 800);
     
     void addDataPoint(const SensorReading& reading);
+    // Renders the next frame and hands it to the sink
     void render();
-    void setConfig(const SensorConfig& cfg) { config = cfg; }
+    // Draws the next frame without showing it; valid until the pool
+    // comes back around to the same surface
+    const cv::Mat& renderFrame();
+    void setConfig(const SensorConfig& cfg);
+    
+    // Where render() sends frames, a window (WindowSink) by default
+    void setSink(std::unique_ptr<FrameSink> frameSink);
     
+    // Polls the sink for a key and handles it: 'h' toggles the HUD
     bool shouldClose();
     
+    // Stage timings; the caller begins and ends frames and marks ingest,
+    // render() and shouldClose() mark the rest
+    FrameStats& frameStats() { return stats; }
+    void setShowHud(bool show) { showHud = show; }
+    
+    // After stats.endFrame(): feeds the frame's time to the governor and
+    // switches to the level it picks, logging every change
+    void adaptQuality();
+    // Pins a level; with config.adaptiveQuality adaptQuality() moves on from it
+    void setQualityLevel(QualityLevel level);
+    QualityLevel qualityLevel() const { return quality; }
+    QualityGovernor& qualityGovernor() { return governor; }
+    
 private:
+    void applyQuality(QualityLevel level);
+    void applyLayout(double scale);
+    int px(int value) const { return static_cast<int>(value * renderScale); }
+    void drawStaticLayer(cv::Mat& image);
     void drawHeader(cv::Mat& image, const SensorReading& latestReading);
+    void drawGraphFrame(cv::Mat& image, cv::Scalar color, double minVal, double maxVal,
+                        int yOffset, const std::string& label);
     void drawGraph(cv::Mat& image, const std::vector<double>& data, 
-                   cv::Scalar color, double minVal, double maxVal, 
-                   int yOffset, const std::string& label, const std::string& unit);
+                   cv::Scalar color, double minVal, double maxVal, int yOffset);
+    void drawCurrentValue(cv::Mat& image, const std::vector<double>& data,
+                          cv::Scalar color, double minVal, double maxVal, int yOffset);
+    double valueY(double value, double minVal, double maxVal, int yOffset) const;
     void drawGrid(cv::Mat& image, int yOffset);
     void drawLegend(cv::Mat& image);
-    std::vector<double> extractTemperatureData() const;
-    std::vector<double> extractWindSpeedData() const;
-    std::vector<double> extractHumidityData() const;
+    void drawHud(cv::Mat& image);
+    const TextGlyphs& glyphs() const { return renderScale < 1.0 ? halfGlyphs : fullGlyphs; }
+    void scaleUp(const cv::Mat& image, cv::Mat& output);
+    void drawText(cv::Mat& image, const std::string& str, cv::Point org, double scale,
+                  const cv::Scalar& color, int thickness);
+    const std::string& formatText(const char* format, ...);
+    const SensorReading& latest() const;
+    void extractData();
 };
 
 #endif // DATA_VISUALIZER_H
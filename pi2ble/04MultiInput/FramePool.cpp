@@ -0,0 +1,34 @@
+#include "FramePool.h"
+#include <cstdlib>
+#include <stdexcept>
+
+FramePool::FramePool(int width, int height, int type, int count) : current(0) {
+    if (width <= 0 || height <= 0 || count <= 0) {
+        throw std::runtime_error("Frame pool needs a size and at least one surface");
+    }
+
+    size_t rowBytes = static_cast<size_t>(width) * CV_ELEM_SIZE(type);
+    size_t step = (rowBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    for (int i = 0; i < count; ++i) {
+        void* block = NULL;
+        if (posix_memalign(&block, ALIGNMENT, step * height) != 0) {
+            for (size_t j = 0; j < blocks.size(); ++j) std::free(blocks[j]);
+            throw std::runtime_error("Could not allocate the frame pool");
+        }
+        blocks.push_back(block);
+        surfaces.push_back(cv::Mat(height, width, type, block, step));
+    }
+}
+
+FramePool::~FramePool() {
+    surfaces.clear();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        std::free(blocks[i]);
+    }
+}
+
+cv::Mat& FramePool::next() {
+    cv::Mat& surface = surfaces[current];
+    current = (current + 1) % surfaces.size();
+    return surface;
+}
@@ -0,0 +1,32 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Render surfaces allocated once up front and handed out round robin, so
+// drawing a frame never allocates. A surface is reused count frames later,
+// which leaves the previous ones to whoever still shows or encodes them.
+// Every row starts on a 64-byte boundary (a cache line, and aligned for
+// NEON/SSE loads).
+class FramePool {
+private:
+    std::vector<void*> blocks;
+    std::vector<cv::Mat> surfaces;
+    size_t current;
+
+    FramePool(const FramePool&);
+    FramePool& operator=(const FramePool&);
+
+public:
+    static const size_t ALIGNMENT = 64;
+
+    FramePool(int width, int height, int type, int count = 2);
+    ~FramePool();
+
+    // The next surface, with whatever was drawn on it count frames ago
+    cv::Mat& next();
+    size_t size() const { return surfaces.size(); }
+};
+
+#endif // FRAME_POOL_H
@@ -0,0 +1,79 @@
+#include "FrameSink.h"
+#include <algorithm>
+#include <stdexcept>
+
+WindowSink::WindowSink(const std::string& name) : windowName(name), open(false) {}
+
+void WindowSink::show(const cv::Mat& frame) {
+    if (!open) {
+        cv::namedWindow(windowName, cv::WINDOW_AUTOSIZE);
+        open = true;
+    }
+    cv::imshow(windowName, frame);
+}
+
+int WindowSink::pollKey() {
+    return cv::waitKey(1);
+}
+
+FramebufferSink::FramebufferSink(const std::string& path) : device(path), layout(pixelLayout(device.variableInfo())) {
+    if (device.bitsPerPixel() != 16 && device.bitsPerPixel() != 32) {
+        throw std::runtime_error("Unsupported framebuffer depth " + std::to_string(device.bitsPerPixel()));
+    }
+}
+
+// Channel positions and widths come from the framebuffer's bitfields, so
+// BGR565 and XBGR panels come out right too (FramebufferPack.h)
+void FramebufferSink::show(const cv::Mat& frame) {
+    packBgr(frame, std::min(frame.cols, device.width()), std::min(frame.rows, device.height()), device.pixels(),
+            device.stride(), layout);
+}
+
+PpmSink::PpmSink(const std::string& filePrefix, int everyNth)
+    : prefix(filePrefix), interval(std::max(1, everyNth)), frameIndex(0), path(prefix.size() + 16) {}
+
+void PpmSink::show(const cv::Mat& frame) {
+    int index = frameIndex++;
+    if (index % interval != 0) return;
+
+    std::snprintf(path.data(), path.size(), "%s%06d.ppm", prefix.c_str(), index);
+    std::FILE* file = std::fopen(path.data(), "wb");
+    if (!file) {
+        throw std::runtime_error(std::string("Could not write ") + path.data());
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", frame.cols, frame.rows);
+    row.resize(static_cast<size_t>(frame.cols) * 3);
+    for (int y = 0; y < frame.rows; ++y) {
+        const uint8_t* src = frame.ptr<uint8_t>(y);
+        for (int x = 0; x < frame.cols; ++x) {
+            row[3 * x] = src[3 * x + 2];
+            row[3 * x + 1] = src[3 * x + 1];
+            row[3 * x + 2] = src[3 * x];
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    bool failed = std::ferror(file) != 0;
+    failed = std::fclose(file) != 0 || failed;
+    if (failed) {
+        throw std::runtime_error(std::string("Could not write ") + path.data());
+    }
+}
+
+std::unique_ptr<FrameSink> makeFrameSink(const std::string& spec, const std::string& windowName) {
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::string argument = colon == std::string::npos ? "" : spec.substr(colon + 1);
+    if (kind == "window") {
+        return std::unique_ptr<FrameSink>(new WindowSink(windowName));
+    }
+    if (kind == "fb") {
+        return std::unique_ptr<FrameSink>(new FramebufferSink(argument.empty() ? "/dev/fb0" : argument));
+    }
+    if (kind == "null") {
+        return std::unique_ptr<FrameSink>(new NullSink());
+    }
+    if (kind == "ppm") {
+        return std::unique_ptr<FrameSink>(new PpmSink(argument.empty() ? "frame" : argument));
+    }
+    throw std::runtime_error("Unknown frame sink " + spec + " (window, fb[:device], null or ppm[:prefix])");
+}
@@ -0,0 +1,72 @@
+#ifndef FRAME_SINK_H
+#define FRAME_SINK_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "FramebufferDevice.h"
+#include "FramebufferPack.h"
+
+// Where DataVisualizer's finished frames go. show() gets every frame
+// (BGR, valid until the next one); pollKey() runs once per frame after
+// it and returns the key pressed since, -1 if none. DataVisualizer times
+// them as the blit and flip stages.
+class FrameSink {
+public:
+    virtual ~FrameSink() {}
+    virtual void show(const cv::Mat& frame) = 0;
+    virtual int pollKey() { return -1; }
+};
+
+// highgui window, opened on the first frame; pollKey() is waitKey(1)
+class WindowSink : public FrameSink {
+private:
+    std::string windowName;
+    bool open;
+
+public:
+    explicit WindowSink(const std::string& name);
+    void show(const cv::Mat& frame);
+    int pollKey();
+};
+
+// Linux framebuffer (16 or 32 bpp, channels where its bitfields say), top
+// left corner of the visible area, no keyboard.
+// Throws std::runtime_error if the device can't be opened or mapped.
+class FramebufferSink : public FrameSink {
+private:
+    FramebufferDevice device;
+    PixelLayout layout;
+
+public:
+    explicit FramebufferSink(const std::string& path = "/dev/fb0");
+    void show(const cv::Mat& frame);
+};
+
+// Drops every frame: what's left is the cost of rendering
+class NullSink : public FrameSink {
+public:
+    void show(const cv::Mat&) {}
+};
+
+// Writes every interval-th frame as a binary PPM, <prefix>000042.ppm
+class PpmSink : public FrameSink {
+private:
+    std::string prefix;
+    int interval;
+    int frameIndex;
+    std::vector<uint8_t> row;
+    std::vector<char> path;
+
+public:
+    explicit PpmSink(const std::string& prefix = "frame", int interval = 1);
+    void show(const cv::Mat& frame);
+};
+
+// From a command line spec: window, fb[:device], null or ppm[:prefix]
+std::unique_ptr<FrameSink> makeFrameSink(const std::string& spec, const std::string& windowName);
+
+#endif // FRAME_SINK_H
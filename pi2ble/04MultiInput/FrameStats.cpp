@@ -0,0 +1,117 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <iomanip>
+
+RollingHistogram::RollingHistogram() {
+    reset();
+}
+
+void RollingHistogram::record(uint32_t us) {
+    if (filled == WINDOW) {
+        buckets.remove(samples[next]);
+        sum -= samples[next];
+    } else {
+        filled++;
+    }
+    samples[next] = us;
+    buckets.record(us);
+    sum += us;
+    next = (next + 1) % WINDOW;
+}
+
+void RollingHistogram::reset() {
+    buckets.reset();
+    next = 0;
+    filled = 0;
+    sum = 0;
+}
+
+uint32_t RollingHistogram::max() const {
+    uint32_t result = 0;
+    for (int i = 0; i < filled; ++i) result = std::max(result, samples[i]);
+    return result;
+}
+
+uint32_t RollingHistogram::percentile(double p) const {
+    return static_cast<uint32_t>(std::min<uint64_t>(buckets.percentile(p), max()));
+}
+
+FrameStats::FrameStats() : lastFrame(0), started(false) {
+    reset();
+}
+
+static uint32_t elapsedUs(FrameStats::Clock::time_point from, FrameStats::Clock::time_point to) {
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return us > 0 ? static_cast<uint32_t>(std::min<long long>(us, 0xFFFFFFFFll)) : 0;
+}
+
+void FrameStats::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (started) intervals.record(elapsedUs(previousStart, now));
+    previousStart = now;
+    frameStart = now;
+    lastMark = now;
+    started = true;
+    std::fill(current, current + STAGE_COUNT, 0);
+}
+
+void FrameStats::endStage(FrameStage stage) {
+    Clock::time_point now = Clock::now();
+    current[stage] += elapsedUs(lastMark, now);
+    lastMark = now;
+}
+
+void FrameStats::endFrame() {
+    for (int s = 0; s < STAGE_COUNT; ++s) stages[s].record(current[s]);
+    lastFrame = elapsedUs(frameStart, Clock::now());
+    frames.record(lastFrame);
+}
+
+void FrameStats::reset() {
+    for (int s = 0; s < STAGE_COUNT; ++s) stages[s].reset();
+    frames.reset();
+    intervals.reset();
+    std::fill(current, current + STAGE_COUNT, 0);
+    lastFrame = 0;
+    started = false;
+}
+
+const char* FrameStats::stageName(FrameStage stage) {
+    switch (stage) {
+    case STAGE_INGEST: return "ingest";
+    case STAGE_STATIC: return "static";
+    case STAGE_GRAPHS: return "graphs";
+    case STAGE_TEXT: return "text";
+    case STAGE_BLIT: return "blit";
+    case STAGE_FLIP: return "flip";
+    default: return "?";
+    }
+}
+
+double FrameStats::fps() const {
+    double interval = intervals.mean();
+    return interval > 0 ? 1e6 / interval : 0.0;
+}
+
+FrameStage FrameStats::worstStage() const {
+    int worst = 0;
+    for (int s = 1; s < STAGE_COUNT; ++s) {
+        if (stages[s].percentile(99) > stages[worst].percentile(99)) worst = s;
+    }
+    return static_cast<FrameStage>(worst);
+}
+
+void FrameStats::print(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    out << "Last " << frames.count() << " frames, " << std::setprecision(1) << fps() << " fps" << std::endl;
+    out << "  stage      p50 ms   p99 ms   max ms" << std::endl;
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        const RollingHistogram& h = stages[s];
+        out << "  " << std::left << std::setw(8) << stageName(static_cast<FrameStage>(s)) << std::right
+            << std::setprecision(2) << std::setw(9) << h.percentile(50) / 1000.0 << std::setw(9)
+            << h.percentile(99) / 1000.0 << std::setw(9) << h.max() / 1000.0 << std::endl;
+    }
+    out << "  " << std::left << std::setw(8) << "frame" << std::right << std::setw(9)
+        << frames.percentile(50) / 1000.0 << std::setw(9) << frames.percentile(99) / 1000.0 << std::setw(9)
+        << frames.max() / 1000.0 << std::endl;
+}
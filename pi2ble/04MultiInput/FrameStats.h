@@ -0,0 +1,92 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "LogHistogram.h"
+
+// Where a frame's time goes, in the order the render loop runs
+enum FrameStage {
+    STAGE_INGEST,  // draining new sensor readings
+    STAGE_STATIC,  // copying the static layer (backgrounds, grids, labels)
+    STAGE_GRAPHS,  // plotting the series
+    STAGE_TEXT,    // values, legend, HUD
+    STAGE_BLIT,    // handing the frame to the window (imshow)
+    STAGE_FLIP,    // getting it on screen (waitKey)
+    STAGE_COUNT
+};
+
+// Durations in microseconds over the last WINDOW samples, in the buckets
+// of common/LogHistogram.h. Fixed size, recording never allocates.
+class RollingHistogram {
+public:
+    static const int WINDOW = 300;
+
+private:
+    uint32_t samples[WINDOW];
+    LogHistogram buckets;
+    int next;
+    int filled;
+    uint64_t sum;
+
+public:
+    RollingHistogram();
+
+    void record(uint32_t us);
+    void reset();
+
+    int count() const { return filled; }
+    double mean() const { return filled ? static_cast<double>(sum) / filled : 0.0; }
+    uint32_t max() const;
+    // Upper bound of the bucket holding the p-th percentile (0..100)
+    uint32_t percentile(double p) const;
+};
+
+// Per-stage timings of the render loop, one clock read per stage:
+//
+//   stats.beginFrame();
+//   ...ingest...   stats.endStage(STAGE_INGEST);
+//   ...render...   stats.endStage(STAGE_STATIC); ...
+//   stats.endFrame();
+//
+// A stage's time is what passed since the previous mark. A stage ended
+// more than once in a frame adds up, one not reached counts as zero.
+class FrameStats {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    RollingHistogram stages[STAGE_COUNT];
+    RollingHistogram frames;
+    RollingHistogram intervals;
+    uint32_t current[STAGE_COUNT];
+    uint32_t lastFrame;
+    Clock::time_point frameStart;
+    Clock::time_point lastMark;
+    Clock::time_point previousStart;
+    bool started;
+
+public:
+    FrameStats();
+
+    void beginFrame();
+    void endStage(FrameStage stage);
+    void endFrame();
+    void reset();
+
+    static const char* stageName(FrameStage stage);
+
+    const RollingHistogram& stage(FrameStage s) const { return stages[s]; }
+    const RollingHistogram& frameTimes() const { return frames; }
+    // The frame endFrame() last closed, in microseconds
+    uint32_t lastFrameUs() const { return lastFrame; }
+    // Frames begun per second over the window
+    double fps() const;
+    // The stage with the highest p99
+    FrameStage worstStage() const;
+
+    void print(std::ostream& out) const;
+};
+
+#endif // FRAME_STATS_H
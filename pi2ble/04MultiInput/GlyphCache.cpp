@@ -0,0 +1,75 @@
+#include "GlyphCache.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+GlyphCache::GlyphCache(double scale, int thickness) : margin(thickness), ascent(0) {
+    int baseline = 0;
+    cv::Size full = cv::getTextSize("Mgy|", cv::FONT_HERSHEY_SIMPLEX, scale, thickness, &baseline);
+    ascent = full.height;
+    int height = ascent + baseline + 2 * margin;
+
+    for (int c = FIRST; c <= LAST; ++c) {
+        std::string text(1, static_cast<char>(c));
+        int glyphBaseline = 0;
+        cv::Size size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, scale, thickness, &glyphBaseline);
+        Glyph& glyph = glyphs[c - FIRST];
+        // getTextSize adds the stroke thickness once per string, not per character
+        glyph.advance = std::max(0, size.width - thickness);
+        glyph.mask.create(height, size.width + 2 * margin, CV_8UC1);
+        glyph.mask.setTo(cv::Scalar(0));
+        cv::putText(glyph.mask, text, cv::Point(margin, margin + ascent), cv::FONT_HERSHEY_SIMPLEX, scale,
+                    cv::Scalar(255), thickness);
+    }
+}
+
+// Glyph of the character at c, -1 for the continuation bytes of a UTF-8
+// sequence
+static inline int glyphIndex(const char* c, int first, int last) {
+    unsigned char byte = static_cast<unsigned char>(*c);
+    if ((byte & 0xC0) == 0x80) return -1;
+    return (byte >= first && byte <= last) ? byte - first : '?' - first;
+}
+
+int GlyphCache::draw(cv::Mat& image, const char* text, cv::Point org, const cv::Scalar& color) const {
+    cv::Rect bounds(0, 0, image.cols, image.rows);
+    const uint8_t bgr[3] = {cv::saturate_cast<uint8_t>(color[0]), cv::saturate_cast<uint8_t>(color[1]),
+                            cv::saturate_cast<uint8_t>(color[2])};
+    int x = org.x;
+    for (const char* c = text; *c; ++c) {
+        int index = glyphIndex(c, FIRST, LAST);
+        if (index < 0) continue;
+        const Glyph& glyph = glyphs[index];
+        cv::Rect target(x - margin, org.y - ascent - margin, glyph.mask.cols, glyph.mask.rows);
+        cv::Rect visible = target & bounds;
+        if (visible.area() > 0) {
+            cv::Rect source(visible.x - target.x, visible.y - target.y, visible.width, visible.height);
+            if (image.type() == CV_8UC3) {
+                // Straight through the mask, Mat::setTo may reserve a scratch buffer
+                for (int y = 0; y < visible.height; ++y) {
+                    const uint8_t* mask = glyph.mask.ptr<uint8_t>(source.y + y) + source.x;
+                    uint8_t* out = image.ptr<uint8_t>(visible.y + y) + 3 * visible.x;
+                    for (int i = 0; i < visible.width; ++i) {
+                        if (!mask[i]) continue;
+                        out[3 * i] = bgr[0];
+                        out[3 * i + 1] = bgr[1];
+                        out[3 * i + 2] = bgr[2];
+                    }
+                }
+            } else {
+                image(visible).setTo(color, glyph.mask(source));
+            }
+        }
+        x += glyph.advance;
+    }
+    return x;
+}
+
+int GlyphCache::textWidth(const char* text) const {
+    int width = 0;
+    for (const char* c = text; *c; ++c) {
+        int index = glyphIndex(c, FIRST, LAST);
+        if (index >= 0) width += glyphs[index].advance;
+    }
+    return width + margin;
+}
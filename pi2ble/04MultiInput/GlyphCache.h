@@ -0,0 +1,34 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <opencv2/opencv.hpp>
+
+// Printable ASCII rendered once with cv::putText (Hershey simplex, no
+// anti-aliasing) into one mask per character. Drawing a string stamps the
+// color through those masks, which skips putText's stroke rasterization
+// and allocation on every call. For short text redrawn every frame.
+// Anything outside printable ASCII is drawn as one '?', a UTF-8 sequence
+// included, as putText does.
+class GlyphCache {
+private:
+    static const int FIRST = 32;
+    static const int LAST = 126;
+
+    struct Glyph {
+        cv::Mat mask;
+        int advance;
+    };
+
+    Glyph glyphs[LAST - FIRST + 1];
+    int margin;
+    int ascent;
+
+public:
+    GlyphCache(double scale, int thickness);
+
+    // org is the baseline start, like cv::putText's; returns the x after the text
+    int draw(cv::Mat& image, const char* text, cv::Point org, const cv::Scalar& color) const;
+    int textWidth(const char* text) const;
+};
+
+#endif // GLYPH_CACHE_H
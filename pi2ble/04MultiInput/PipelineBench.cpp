@@ -0,0 +1,109 @@
+#include "AllocationCounter.h"
+#include "DataVisualizer.h"
+#include "SensorSimulator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+struct BenchSize {
+    int width;
+    int height;
+};
+
+// One configuration: fill the history, then time frames SensorSimulator ->
+// DataVisualizer -> sink back to back, with no frame pacing, at a pinned
+// quality level
+static void runConfiguration(const BenchSize& size, int history, int frames, const std::string& sinkSpec,
+                             QualityLevel quality) {
+    SensorConfig config;
+    config.maxDataPoints = history;
+    config.adaptiveQuality = false;
+    SensorSimulator simulator(config);
+    DataVisualizer visualizer("PipelineBench", size.width, size.height);
+    visualizer.setConfig(config);
+    visualizer.setQualityLevel(quality);
+    visualizer.setSink(makeFrameSink(sinkSpec, "PipelineBench"));
+    FrameStats& stats = visualizer.frameStats();
+
+    // Warm up: the ring full, every pooled surface drawn on and the sink
+    // opened (window, framebuffer mapping)
+    for (int i = 0; i < history; ++i) {
+        visualizer.addDataPoint(simulator.generateReading());
+    }
+    for (int i = 0; i < 10; ++i) {
+        visualizer.addDataPoint(simulator.generateReading());
+        visualizer.render();
+        visualizer.shouldClose();
+    }
+    stats.reset();
+
+    size_t allocationsBefore = AllocationCounter::count();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        stats.beginFrame();
+        visualizer.addDataPoint(simulator.generateReading());
+        stats.endStage(STAGE_INGEST);
+        visualizer.render();
+        visualizer.shouldClose();
+        stats.endFrame();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocations = AllocationCounter::count() - allocationsBefore;
+
+    std::printf("%5dx%-5d %7d %9.1f %8.2f %8.2f", size.width, size.height, history, frames / seconds,
+                stats.frameTimes().percentile(50) / 1000.0, stats.frameTimes().percentile(99) / 1000.0);
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        std::printf(" %8.0f", stats.stage(static_cast<FrameStage>(s)).mean());
+    }
+    std::printf(" %9.2f\n", static_cast<double>(allocations) / frames);
+    std::fflush(stdout);
+}
+
+// Whole-pipeline throughput without a window: SensorSimulator readings
+// into DataVisualizer, rendered and handed to a sink as fast as they go,
+// at several frame sizes and history lengths. Per configuration: frames
+// per second, p50/p99 frame time, mean microseconds per stage (over the
+// last RollingHistogram::WINDOW frames) and heap allocations per frame.
+// DataVisualizer always plots its three channels; the history length is
+// the number of points per graph. Allocations inside OpenCV count too.
+//
+// Usage: ./PipelineBench [frames] [sink] [quality]
+//   frames per configuration (default 1000)
+//   sink: null (default), ppm[:prefix], fb[:/dev/fbN] or window
+//   quality: level 0 (full, default) to 4 (half res), see QualityGovernor.h
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    std::string sinkSpec = argc > 2 ? argv[2] : "null";
+    int level = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (frames <= 0 || level < 0 || level >= QUALITY_LEVEL_COUNT) {
+        std::cerr << "Usage: " << argv[0] << " [frames] [null|ppm[:prefix]|fb[:device]|window] [quality 0-"
+                  << QUALITY_LEVEL_COUNT - 1 << "]" << std::endl;
+        return 1;
+    }
+    QualityLevel quality = static_cast<QualityLevel>(level);
+
+    // The Pi 7" display, the default window and full HD
+    const BenchSize sizes[] = {{800, 480}, {1200, 800}, {1920, 1080}};
+    const int histories[] = {50, 200, 1000, 5000};
+
+    try {
+        std::cout << frames << " frames per configuration, sink " << sinkSpec << ", quality "
+                  << QualityGovernor::levelName(quality) << ", 3 channels, stage means in us" << std::endl;
+        std::printf("%11s %7s %9s %8s %8s", "size", "history", "fps", "p50 ms", "p99 ms");
+        for (int s = 0; s < STAGE_COUNT; ++s) {
+            std::printf(" %8s", FrameStats::stageName(static_cast<FrameStage>(s)));
+        }
+        std::printf(" %9s\n", "allocs/fr");
+        for (const BenchSize& size : sizes) {
+            for (int history : histories) {
+                runConfiguration(size, history, frames, sinkSpec, quality);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
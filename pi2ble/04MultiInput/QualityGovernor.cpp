@@ -0,0 +1,87 @@
+#include "QualityGovernor.h"
+#include <algorithm>
+#include <cstdio>
+
+QualityGovernor::QualityGovernor(int targetFps) : enabled(true) {
+    setTargetFps(targetFps);
+    reset();
+}
+
+void QualityGovernor::setTargetFps(int fps) {
+    budgetUs = 1000000u / static_cast<uint32_t>(std::max(1, fps));
+}
+
+void QualityGovernor::reset(QualityLevel level) {
+    current = level;
+    calmWindows = 0;
+    windowsSinceUp = -1;
+    std::fill(upDelay, upDelay + QUALITY_LEVEL_COUNT, static_cast<int>(INITIAL_UP_DELAY));
+    lastTransition[0] = '\0';
+    startWindow();
+}
+
+void QualityGovernor::startWindow() {
+    framesInWindow = 0;
+    missesInWindow = 0;
+    worstInWindow = 0;
+}
+
+void QualityGovernor::step(QualityLevel to) {
+    current = to;
+    calmWindows = 0;
+    startWindow();
+}
+
+bool QualityGovernor::update(uint32_t workUs) {
+    if (!enabled) return false;
+
+    framesInWindow++;
+    if (workUs > budgetUs) missesInWindow++;
+    worstInWindow = std::max(worstInWindow, workUs);
+
+    if (missesInWindow >= MISS_LIMIT && current + 1 < QUALITY_LEVEL_COUNT) {
+        QualityLevel from = current;
+        // The step up to this level didn't hold: wait longer next time
+        if (windowsSinceUp >= 0) {
+            upDelay[from] = std::min(upDelay[from] * 2, static_cast<int>(MAX_UP_DELAY));
+            windowsSinceUp = -1;
+        }
+        std::snprintf(lastTransition, sizeof(lastTransition), "%s -> %s: %d of %d frames over the %.1f ms deadline",
+                      levelName(from), levelName(static_cast<QualityLevel>(from + 1)), missesInWindow,
+                      framesInWindow, budgetUs / 1000.0);
+        step(static_cast<QualityLevel>(from + 1));
+        return true;
+    }
+    if (framesInWindow < WINDOW) return false;
+
+    // A whole window done
+    uint32_t worst = worstInWindow;
+    bool calm = worst <= budgetUs / 2;
+    startWindow();
+    if (windowsSinceUp >= 0 && ++windowsSinceUp >= 2) windowsSinceUp = -1;
+    if (!calm || current == QUALITY_FULL) {
+        calmWindows = 0;
+        return false;
+    }
+
+    QualityLevel to = static_cast<QualityLevel>(current - 1);
+    if (++calmWindows < upDelay[to]) return false;
+    std::snprintf(lastTransition, sizeof(lastTransition),
+                  "%s -> %s: %d windows of %d frames at most %.1f ms, under half the %.1f ms deadline",
+                  levelName(current), levelName(to), calmWindows, static_cast<int>(WINDOW), worst / 1000.0,
+                  budgetUs / 1000.0);
+    step(to);
+    windowsSinceUp = 0;
+    return true;
+}
+
+const char* QualityGovernor::levelName(QualityLevel level) {
+    switch (level) {
+    case QUALITY_FULL: return "full";
+    case QUALITY_PLAIN_LINES: return "plain lines";
+    case QUALITY_FEWER_SAMPLES: return "fewer samples";
+    case QUALITY_SLOW_TEXT: return "slow text";
+    case QUALITY_HALF_RES: return "half res";
+    default: return "?";
+    }
+}
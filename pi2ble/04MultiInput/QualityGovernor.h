@@ -0,0 +1,73 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include <cstdint>
+
+// How much DataVisualizer draws, best first. Each level keeps the savings
+// of the ones above it.
+enum QualityLevel {
+    QUALITY_FULL,          // anti-aliased graph lines, every sample, text every frame
+    QUALITY_PLAIN_LINES,   // graph lines without LINE_AA
+    QUALITY_FEWER_SAMPLES, // at most one graph vertex per 8 px of width
+    QUALITY_SLOW_TEXT,     // values redrawn every TEXT_INTERVAL frames, copied in between
+    QUALITY_HALF_RES,      // drawn at half the window size and scaled up
+    QUALITY_LEVEL_COUNT
+};
+
+// Holds the frame deadline (1 / targetFps) by trading quality for time.
+// Fed the work time of every frame (begin to end, not the pacing sleep):
+//
+//   - down a level as soon as MISS_LIMIT frames of the current WINDOW
+//     missed the deadline
+//   - up a level once the worst frame stayed under half the deadline for
+//     a number of whole windows in a row, INITIAL_UP_DELAY to start with
+//
+// A step up that is undone within two windows doubles the wait before
+// that level is tried again (up to MAX_UP_DELAY windows), so a level that
+// doesn't fit isn't retried every few seconds. Fixed size, never
+// allocates.
+class QualityGovernor {
+public:
+    static const int WINDOW = 30;
+    static const int MISS_LIMIT = 3;
+    static const int INITIAL_UP_DELAY = 3;
+    static const int MAX_UP_DELAY = 64;
+
+private:
+    QualityLevel current;
+    bool enabled;
+    uint32_t budgetUs;
+    int framesInWindow;
+    int missesInWindow;
+    uint32_t worstInWindow;
+    int calmWindows;
+    // Windows since the last step up, -1 once it has held for two
+    int windowsSinceUp;
+    // Calm windows needed before stepping up to each level
+    int upDelay[QUALITY_LEVEL_COUNT];
+    char lastTransition[128];
+
+    void step(QualityLevel to);
+    void startWindow();
+
+public:
+    explicit QualityGovernor(int targetFps = 30);
+
+    void setTargetFps(int fps);
+    // Disabled, update() leaves the level alone
+    void setEnabled(bool on) { enabled = on; }
+    // Back to a level with fresh windows and delays
+    void reset(QualityLevel level = QUALITY_FULL);
+
+    // One frame's work time; true if the level changed, transition() says why
+    bool update(uint32_t workUs);
+
+    QualityLevel level() const { return current; }
+    uint32_t budget() const { return budgetUs; }
+    // e.g. "full -> plain lines: 3 of 12 frames over the 33.3 ms deadline"
+    const char* transition() const { return lastTransition; }
+
+    static const char* levelName(QualityLevel level);
+};
+
+#endif // QUALITY_GOVERNOR_H
@@ -40,6 +40,11 @@ struct SensorConfig {
     // Data collection
     int maxDataPoints = 200;       // Maximum number of data points to store
     int updateIntervalMs = 50;     // Update interval in milliseconds
+    
+    // Display
+    bool showHud = false;          // Frame timing overlay ('h' toggles)
+    int targetFps = 30;            // Frame deadline the render loop paces to
+    bool adaptiveQuality = true;   // Drop drawing quality when frames miss it (QualityGovernor.h)
 };
 
 #endif // SENSOR_DATA_H
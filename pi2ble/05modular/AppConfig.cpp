@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <yaml-cpp/yaml.h>
@@ -10,17 +11,89 @@ const std::string APP_CONFIG_FILE = "AppConfig.yaml";
 
 // Function to load AppConfig from YAML file
 AppConfig loadAppConfig(const std::string& filename) {
+    YAML::Node yamlFile;
+    try {
+        yamlFile = YAML::LoadFile(filename);
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading YAML file: " << e.what() << std::endl;
+        throw;
+    }
+    return loadAppConfig(yamlFile, filename);
+}
+
+AppConfig loadAppConfig(const YAML::Node& yamlFile, const std::string& filename) {
     AppConfig config;
     
     try {
-        YAML::Node yamlFile = YAML::LoadFile(filename);
-        
         // Load video configuration
         if (yamlFile["video"]) {
             YAML::Node videoNode = yamlFile["video"];
             config.video.width = videoNode["width"].as<int>();
             config.video.height = videoNode["height"].as<int>();
             config.video.framerate = videoNode["framerate"].as<int>();
+            if (videoNode["showLatency"]) config.video.showLatency = videoNode["showLatency"].as<bool>();
+        }
+        
+        // Load OBD-II adapter configuration
+        if (yamlFile["obd"]) {
+            YAML::Node obdNode = yamlFile["obd"];
+            if (obdNode["device"]) config.obd.device = obdNode["device"].as<std::string>();
+            if (obdNode["baud"]) config.obd.baud = obdNode["baud"].as<int>();
+            if (obdNode["maxPidsPerRequest"]) config.obd.maxPidsPerRequest = obdNode["maxPidsPerRequest"].as<int>();
+            if (obdNode["maxInFlight"]) config.obd.maxInFlight = obdNode["maxInFlight"].as<int>();
+            if (obdNode["timeoutMs"]) config.obd.timeoutMs = obdNode["timeoutMs"].as<int>();
+        }
+        
+        // Load CAN ingress configuration
+        if (yamlFile["can"]) {
+            YAML::Node canNode = yamlFile["can"];
+            if (canNode["interface"]) config.can.interface = canNode["interface"].as<std::string>();
+            if (canNode["signals"]) config.can.signals = canNode["signals"].as<std::string>();
+        }
+        
+        // Load Pi 5 -> Pi Zero 2 link configuration
+        if (yamlFile["link"]) {
+            YAML::Node linkNode = yamlFile["link"];
+            if (linkNode["host"]) config.link.host = linkNode["host"].as<std::string>();
+            if (linkNode["port"]) config.link.port = linkNode["port"].as<int>();
+            if (linkNode["resolution"]) config.link.resolution = linkNode["resolution"].as<double>();
+            if (linkNode["keyframeInterval"]) config.link.keyframeInterval = linkNode["keyframeInterval"].as<int>();
+        }
+        
+        // Load shared memory bus configuration
+        if (yamlFile["bus"]) {
+            YAML::Node busNode = yamlFile["bus"];
+            if (busNode["name"]) config.bus.name = busNode["name"].as<std::string>();
+            if (busNode["ringCapacity"]) config.bus.ringCapacity = busNode["ringCapacity"].as<int>();
+        }
+        
+        // Load session recorder configuration
+        if (yamlFile["recorder"]) {
+            YAML::Node recorderNode = yamlFile["recorder"];
+            if (recorderNode["directory"]) config.recorder.directory = recorderNode["directory"].as<std::string>();
+            if (recorderNode["prefix"]) config.recorder.prefix = recorderNode["prefix"].as<std::string>();
+            if (recorderNode["segmentMB"]) config.recorder.segmentMB = recorderNode["segmentMB"].as<int>();
+            if (recorderNode["blockSamples"]) config.recorder.blockSamples = recorderNode["blockSamples"].as<int>();
+            if (recorderNode["blockMaxAgeMs"]) config.recorder.blockMaxAgeMs = recorderNode["blockMaxAgeMs"].as<int>();
+            if (recorderNode["syncIntervalMs"]) config.recorder.syncIntervalMs = recorderNode["syncIntervalMs"].as<int>();
+            if (recorderNode["queueCapacity"]) config.recorder.queueCapacity = recorderNode["queueCapacity"].as<int>();
+            if (recorderNode["encoding"]) config.recorder.encoding = recorderNode["encoding"].as<std::string>();
+            if (config.recorder.segmentMB < 1 || config.recorder.blockSamples < 1 || config.recorder.queueCapacity < 1) {
+                throw std::runtime_error(filename +
+                                         ": recorder segmentMB, blockSamples and queueCapacity must be at least 1");
+            }
+        }
+        
+        // Load realtime mode configuration
+        if (yamlFile["realtime"]) {
+            YAML::Node realtimeNode = yamlFile["realtime"];
+            if (realtimeNode["enabled"]) config.realtime.enabled = realtimeNode["enabled"].as<bool>();
+            if (realtimeNode["renderCpu"]) config.realtime.renderCpu = realtimeNode["renderCpu"].as<int>();
+            if (realtimeNode["ingestCpu"]) config.realtime.ingestCpu = realtimeNode["ingestCpu"].as<int>();
+            if (realtimeNode["renderPriority"]) config.realtime.renderPriority = realtimeNode["renderPriority"].as<int>();
+            if (realtimeNode["ingestPriority"]) config.realtime.ingestPriority = realtimeNode["ingestPriority"].as<int>();
+            if (realtimeNode["lockMemory"]) config.realtime.lockMemory = realtimeNode["lockMemory"].as<bool>();
+            if (realtimeNode["prefaultStackKB"]) config.realtime.prefaultStackKB = realtimeNode["prefaultStackKB"].as<int>();
         }
         
         // Load telemetry configurations
@@ -54,6 +127,14 @@ AppConfig loadAppConfig(const std::string& filename) {
                     } else {
                         telemetryConfig.ingress.baud = 0; // or some default value
                     }
+
+                    // OBD-II PID and target rate, only used by type: obd
+                    if (ingressNode["pid"]) {
+                        telemetryConfig.ingress.pid = ingressNode["pid"].as<int>();
+                    }
+                    if (ingressNode["rate"]) {
+                        telemetryConfig.ingress.rate = ingressNode["rate"].as<double>();
+                    }
                 }
                 
                 config.telemetry[telemetryName] = telemetryConfig;
@@ -77,6 +158,53 @@ void printAppConfig(const AppConfig& config) {
     std::cout << "  width: " << config.video.width << std::endl;
     std::cout << "  height: " << config.video.height << std::endl;
     std::cout << "  framerate: " << config.video.framerate << std::endl;
+    std::cout << "  showLatency: " << (config.video.showLatency ? "true" : "false") << std::endl;
+    
+    // Print OBD config
+    std::cout << "OBD:" << std::endl;
+    std::cout << "  device: " << config.obd.device << std::endl;
+    std::cout << "  baud: " << config.obd.baud << std::endl;
+    std::cout << "  maxPidsPerRequest: " << config.obd.maxPidsPerRequest << std::endl;
+    std::cout << "  maxInFlight: " << config.obd.maxInFlight << std::endl;
+    std::cout << "  timeoutMs: " << config.obd.timeoutMs << std::endl;
+    
+    // Print CAN config
+    std::cout << "CAN:" << std::endl;
+    std::cout << "  interface: " << config.can.interface << std::endl;
+    std::cout << "  signals: " << config.can.signals << std::endl;
+    
+    // Print link config
+    std::cout << "Link:" << std::endl;
+    std::cout << "  host: " << config.link.host << std::endl;
+    std::cout << "  port: " << config.link.port << std::endl;
+    std::cout << "  resolution: " << config.link.resolution << std::endl;
+    std::cout << "  keyframeInterval: " << config.link.keyframeInterval << std::endl;
+    
+    // Print bus config
+    std::cout << "Bus:" << std::endl;
+    std::cout << "  name: " << config.bus.name << std::endl;
+    std::cout << "  ringCapacity: " << config.bus.ringCapacity << std::endl;
+    
+    // Print recorder config
+    std::cout << "Recorder:" << std::endl;
+    std::cout << "  directory: " << config.recorder.directory << std::endl;
+    std::cout << "  prefix: " << config.recorder.prefix << std::endl;
+    std::cout << "  segmentMB: " << config.recorder.segmentMB << std::endl;
+    std::cout << "  blockSamples: " << config.recorder.blockSamples << std::endl;
+    std::cout << "  blockMaxAgeMs: " << config.recorder.blockMaxAgeMs << std::endl;
+    std::cout << "  syncIntervalMs: " << config.recorder.syncIntervalMs << std::endl;
+    std::cout << "  queueCapacity: " << config.recorder.queueCapacity << std::endl;
+    std::cout << "  encoding: " << config.recorder.encoding << std::endl;
+    
+    // Print realtime config
+    std::cout << "Realtime:" << std::endl;
+    std::cout << "  enabled: " << (config.realtime.enabled ? "true" : "false") << std::endl;
+    std::cout << "  renderCpu: " << config.realtime.renderCpu << std::endl;
+    std::cout << "  ingestCpu: " << config.realtime.ingestCpu << std::endl;
+    std::cout << "  renderPriority: " << config.realtime.renderPriority << std::endl;
+    std::cout << "  ingestPriority: " << config.realtime.ingestPriority << std::endl;
+    std::cout << "  lockMemory: " << (config.realtime.lockMemory ? "true" : "false") << std::endl;
+    std::cout << "  prefaultStackKB: " << config.realtime.prefaultStackKB << std::endl;
     
     // Print telemetry configs
     std::cout << "Telemetry:" << std::endl;
@@ -95,31 +223,9 @@ void printAppConfig(const AppConfig& config) {
         std::cout << "      key: " << telemetry.ingress.key << std::endl;
         std::cout << "      type: " << telemetry.ingress.type << std::endl;
         std::cout << "      baud: " << telemetry.ingress.baud << std::endl;
-    }
-}
-
-int main() {
-    try {
-        // Load configuration from YAML
-        AppConfig appConfig = loadAppConfig();
-        
-        // Print the loaded configuration
-        printAppConfig(appConfig);
-        
-        // Example of using the configuration
-        std::cout << "\n=== Usage Examples ===" << std::endl;
-        std::cout << "Video resolution: " << appConfig.video.width << "x" << appConfig.video.height << std::endl;
-        
-        if (appConfig.telemetry.find("velocity") != appConfig.telemetry.end()) {
-            const auto& velocity = appConfig.telemetry.at("velocity");
-            std::cout << "Velocity display at: (" << velocity.x << ", " << velocity.y << ")" << std::endl;
-            std::cout << "Velocity format: " << velocity.format << std::endl;
+        if (telemetry.ingress.pid >= 0) {
+            std::cout << "      pid: " << telemetry.ingress.pid << std::endl;
+            std::cout << "      rate: " << telemetry.ingress.rate << std::endl;
         }
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
     }
-    
-    return 0;
 }
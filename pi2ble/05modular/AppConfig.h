@@ -26,22 +26,62 @@
 //     ingress:
 //       key: rpm
 //       baud: null
-//       type: ble
+//       type: obd
+//       pid: 0x0C
+//       rate: 20
 // video:
 //   width: 640
 //   height: 480
 //   framerate: 30
+//   showLatency: false
+// obd:
+//   device: /dev/ttyUSB0
+//   baud: 38400
+//   maxPidsPerRequest: 6
+//   maxInFlight: 1
+//   timeoutMs: 250
+// can:
+//   interface: can0
+//   signals: CanSignals.yaml
+// link:
+//   host: 127.0.0.1
+//   port: 5600
+//   resolution: 0.01
+//   keyframeInterval: 50
+// bus:
+//   name: /incartel-telemetry
+//   ringCapacity: 256
+// recorder:
+//   directory: sessions
+//   prefix: session
+//   segmentMB: 64
+//   blockSamples: 4096
+//   blockMaxAgeMs: 250
+//   syncIntervalMs: 1000
+//   queueCapacity: 65536
+//   encoding: gorilla
+// realtime:
+//   enabled: false
+//   renderCpu: 3
+//   ingestCpu: 2
+//   renderPriority: 50
+//   ingestPriority: 40
+//   lockMemory: true
+//   prefaultStackKB: 256
 
 struct VideoConfig {
     int width;
     int height;
     int framerate;
+    bool showLatency = false; // age-at-display p50/p99 per channel, drawn by LiveOverlay, printed by LatencyProbe
 };
 
 struct TelemetryIngressConfig {
     std::string key;
     int baud;
     std::string type;
+    int pid = -1;       // OBD-II mode 01 PID, only for type: obd
+    double rate = 0.0;  // target refresh rate in Hz, only for type: obd
 };
 
 struct TelemetryConfig {
@@ -52,13 +92,69 @@ struct TelemetryConfig {
     TelemetryIngressConfig ingress;
 };
 
+struct ObdConfig {
+    std::string device = "/dev/ttyUSB0";
+    int baud = 38400;
+    int maxPidsPerRequest = 6; // mode 01 allows up to 6 PIDs per request on CAN
+    int maxInFlight = 1;       // a stock ELM327 only handles one request at a time
+    int timeoutMs = 250;
+};
+
+struct CanConfig {
+    std::string interface = "can0";
+    std::string signals = "CanSignals.yaml"; // signal table, see CanDecoder.h
+};
+
+struct LinkConfig {
+    std::string host = "127.0.0.1"; // Pi Zero 2 address, as seen from the Pi 5
+    int port = 5600;
+    double resolution = 0.01;      // values are sent as integer multiples of this
+    int keyframeInterval = 50;     // frames between full resyncs
+};
+
+struct BusConfig {
+    std::string name = "/incartel-telemetry"; // POSIX shared memory object
+    int ringCapacity = 256;                    // samples kept per channel, power of two
+};
+
+struct RecorderConfig {
+    std::string directory = "sessions";
+    std::string prefix = "session";
+    int segmentMB = 64;          // preallocated size of each segment file
+    int blockSamples = 4096;     // samples per block
+    int blockMaxAgeMs = 250;     // write a partial block after this long
+    int syncIntervalMs = 1000;   // msync batching
+    int queueCapacity = 65536;   // producer queue, power of two
+    std::string encoding = "gorilla"; // block encoding: raw or gorilla
+};
+
+// Render loop and ingest pinned to their own cores at SCHED_FIFO, memory
+// locked; see Realtime.h. Without the privileges it runs as normal.
+struct RealtimeConfig {
+    bool enabled = false;
+    int renderCpu = 3;           // -1 leaves the thread unpinned
+    int ingestCpu = 2;
+    int renderPriority = 50;     // SCHED_FIFO 1..99, 0 stays SCHED_OTHER
+    int ingestPriority = 40;
+    bool lockMemory = true;      // mlockall, no page faults on the hot path
+    int prefaultStackKB = 256;   // stack touched per realtime thread
+};
+
 struct AppConfig {
     std::map<std::string, TelemetryConfig> telemetry;
     VideoConfig video;
+    ObdConfig obd;
+    CanConfig can;
+    LinkConfig link;
+    BusConfig bus;
+    RecorderConfig recorder;
+    RealtimeConfig realtime;
 };
 
 // Function declarations
 AppConfig loadAppConfig(const std::string& filename = "AppConfig.yaml");
+// From YAML that is already parsed; filename only goes into error messages
+AppConfig loadAppConfig(const YAML::Node& yamlFile, const std::string& filename);
 void printAppConfig(const AppConfig& config);
 
 #endif // APPCONFIG_H
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "AppConfig.h"
+#include "ConfigCache.h"
+
+// Mean microseconds per call of load over runs calls
+template <typename Load>
+static double timeLoads(int runs, Load load) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        load();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+// Startup cost of the config, parsed against compiled: YAML parse into an
+// AppConfig, opening the compiled cache (mmap, checks) and reading it in
+// place, and the cache converted back to an AppConfig
+static void compareLoads(int runs) {
+    openConfigCache(); // compiled now if it is missing or stale
+
+    size_t sink = 0;
+    double yaml = timeLoads(runs, [&] { sink += loadAppConfig().telemetry.size(); });
+    double mapped = timeLoads(runs, [&] { sink += openConfigCache()->channelCount(); });
+    double converted = timeLoads(runs, [&] { sink += loadAppConfigCached().telemetry.size(); });
+
+    std::cout << runs << " loads of AppConfig.yaml, mean per load" << std::endl;
+    std::cout << "  YAML parse (loadAppConfig):        " << yaml << " us" << std::endl;
+    std::cout << "  compiled cache (openConfigCache):  " << mapped << " us  (" << yaml / mapped << "x)" << std::endl;
+    std::cout << "  cache to AppConfig (toAppConfig):  " << converted << " us  (" << yaml / converted << "x)"
+              << std::endl;
+    if (sink == 0) std::cout << "  (no telemetry channels)" << std::endl;
+}
+
+// Usage: ./AppConfig [--cached] [--time runs]
+//   prints AppConfig.yaml as loaded, through the compiled cache with --cached
+//   --time compares parsing the YAML with the compiled cache instead
+int main(int argc, char* argv[]) {
+    bool cached = false;
+    int timeRuns = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cached") {
+            cached = true;
+        } else if (arg == "--time" && i + 1 < argc) {
+            timeRuns = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--cached] [--time runs]" << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        if (timeRuns > 0) {
+            compareLoads(timeRuns);
+            return 0;
+        }
+
+        // Load configuration from YAML
+        AppConfig appConfig = cached ? loadAppConfigCached() : loadAppConfig();
+
+        // Print the loaded configuration
+        printAppConfig(appConfig);
+
+        // Example of using the configuration
+        std::cout << "\n=== Usage Examples ===" << std::endl;
+        std::cout << "Video resolution: " << appConfig.video.width << "x" << appConfig.video.height << std::endl;
+
+        if (appConfig.telemetry.find("velocity") != appConfig.telemetry.end()) {
+            const auto& velocity = appConfig.telemetry.at("velocity");
+            std::cout << "Velocity display at: (" << velocity.x << ", " << velocity.y << ")" << std::endl;
+            std::cout << "Velocity format: " << velocity.format << std::endl;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
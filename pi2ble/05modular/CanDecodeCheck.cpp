@@ -0,0 +1,122 @@
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+#include "CanDecoder.h"
+#include "CanFrameSource.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+static CanSignalDef signal(uint32_t messageId, const std::string& name, int startBit, int length, bool bigEndian,
+                           bool isSigned, double scale) {
+    CanSignalDef def;
+    def.messageId = messageId;
+    def.name = name;
+    def.startBit = startBit;
+    def.length = length;
+    def.bigEndian = bigEndian;
+    def.isSigned = isSigned;
+    def.scale = scale;
+    return def;
+}
+
+static CanFrame frame(uint32_t id, std::initializer_list<uint8_t> data) {
+    CanFrame f;
+    f.id = id;
+    for (uint8_t byte : data) f.data[f.dlc++] = byte;
+    return f;
+}
+
+static bool parses(const char* line, CanFrame& f) {
+    double logTime = 0.0;
+    bool hasLogTime = false;
+    return CanReplaySource::parseLine(line, f, logTime, hasLogTime);
+}
+
+// Decoding of little and big endian, signed and 29-bit id signals, that
+// remote and error frames publish nothing, and that the replay parser and
+// the signal table reject ids wider than 29 bits.
+//
+// Usage: ./CanDecodeCheck
+int main() {
+    try {
+        AppConfig appConfig;
+        for (const char* name : {"throttle", "steering", "fuel"}) {
+            appConfig.telemetry[name].ingress.type = "can";
+            appConfig.telemetry[name].ingress.key = name;
+        }
+        const uint32_t fuelId = 0x18FEF100 | CAN_EXTENDED_FLAG;
+        std::vector<CanSignalDef> table{
+            signal(0x0C9, "throttle", 8, 8, false, false, 0.5),
+            signal(0x1E5, "steering", 7, 16, true, true, 0.1),
+            signal(fuelId, "fuel", 0, 8, false, false, 1.0),
+        };
+        TelemetryStore store(appConfig);
+        CanDecoder decoder(appConfig, table, store);
+        const int throttle = store.channelId("throttle");
+        const int steering = store.channelId("steering");
+        const int fuel = store.channelId("fuel");
+
+        check(decoder.decode(frame(0x0C9, {0x00, 200}), Clock::now()) == 1 && store.latest(throttle).value == 100.0,
+              "little endian signal decoded and scaled");
+        check(decoder.decode(frame(0x1E5, {0xFF, 0x9C}), Clock::now()) == 1 && store.latest(steering).value == -10.0,
+              "big endian signed signal decoded");
+        check(decoder.decode(frame(fuelId, {42}), Clock::now()) == 1 && store.latest(fuel).value == 42.0,
+              "29-bit id decoded");
+
+        uint64_t updates = store.latest(throttle).updates;
+        check(decoder.decode(frame(0x0C9 | CAN_REMOTE_FLAG, {0x00, 10}), Clock::now()) == 0 &&
+                  store.latest(throttle).updates == updates,
+              "remote frame publishes nothing");
+        check(decoder.decode(frame(0x0C9 | CAN_ERROR_FLAG, {0x00, 10}), Clock::now()) == 0 &&
+                  store.latest(throttle).updates == updates,
+              "error frame publishes nothing");
+        check(decoder.decode(frame(0x8C9, {0x00, 10}), Clock::now()) == 0,
+              "standard id wider than 11 bits doesn't alias onto 0x0C9");
+        check(decoder.decode(frame(0x0C9, {0x00}), Clock::now()) == 0, "frame too short for its signals skipped");
+
+        CanFrame parsed;
+        check(parses("(1436509052.249713) can0 0C9#00C8", parsed) && parsed.id == 0x0C9 && parsed.dlc == 2 &&
+                  parsed.data[1] == 200,
+              "candump -l line parsed");
+        check(parses("1FFFFFFF#01", parsed) && parsed.id == (0x1FFFFFFF | CAN_EXTENDED_FLAG),
+              "largest 29-bit id parsed as extended");
+        check(!parses("20000000#01", parsed), "id over 29 bits rejected");
+        check(!parses("FFFFFFFF#01", parsed), "id with the flag bits set rejected");
+        check(!parses("FFF#01", parsed), "3-digit id over 11 bits rejected");
+        check(!parses("0C9#R", parsed), "remote frame line skipped");
+
+        const std::string path = "CanDecodeCheck-" + std::to_string(getpid()) + ".yaml";
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) throw std::runtime_error("Could not write " + path);
+        std::fputs("messages:\n  - id: 0x20000000\n    signals:\n      - {name: a, startBit: 0, length: 8}\n",
+                   file);
+        std::fclose(file);
+        bool rejected = false;
+        try {
+            loadCanSignals(path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        std::remove(path.c_str());
+        check(rejected, "signal table with an id over 29 bits rejected");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
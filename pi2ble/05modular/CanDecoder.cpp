@@ -0,0 +1,173 @@
+#include "CanDecoder.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <yaml-cpp/yaml.h>
+
+std::vector<CanSignalDef> loadCanSignals(const std::string& filename) {
+    std::vector<CanSignalDef> table;
+
+    try {
+        YAML::Node yamlFile = YAML::LoadFile(filename);
+
+        for (const auto& messageNode : yamlFile["messages"]) {
+            uint32_t id = messageNode["id"].as<uint32_t>();
+            bool extended = messageNode["extended"] && messageNode["extended"].as<bool>();
+            if (id > CAN_EXTENDED_ID_MASK) {
+                throw std::runtime_error("CAN id " + std::to_string(id) + " is wider than 29 bits");
+            }
+            if (extended || id > 0x7FF) id |= CAN_EXTENDED_FLAG;
+
+            for (const auto& signalNode : messageNode["signals"]) {
+                CanSignalDef def;
+                def.messageId = id;
+                def.name = signalNode["name"].as<std::string>();
+                def.startBit = signalNode["startBit"].as<int>();
+                def.length = signalNode["length"].as<int>();
+                if (signalNode["endian"]) def.bigEndian = signalNode["endian"].as<std::string>() == "big";
+                if (signalNode["signed"]) def.isSigned = signalNode["signed"].as<bool>();
+                if (signalNode["scale"]) def.scale = signalNode["scale"].as<double>();
+                if (signalNode["offset"]) def.offset = signalNode["offset"].as<double>();
+                table.push_back(def);
+            }
+        }
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading CAN signal file: " << e.what() << std::endl;
+        throw;
+    }
+
+    return table;
+}
+
+CanDecoder::CanDecoder(const AppConfig& appConfig, const std::vector<CanSignalDef>& table, TelemetryStore& telemetryStore)
+    : store(telemetryStore), standardIndex(2048, NO_MESSAGE) {
+
+    // Signal name -> telemetry channel, only for entries fed by CAN
+    std::map<std::string, int> channels;
+    for (const auto& [name, telemetry] : appConfig.telemetry) {
+        if (telemetry.ingress.type == "can") {
+            channels[telemetry.ingress.key] = store.channelId(name);
+        }
+    }
+
+    // Group the used signals by message id
+    std::map<uint32_t, std::vector<CompiledSignal>> byMessage;
+    std::map<uint32_t, uint8_t> minDlc;
+    for (const auto& def : table) {
+        auto channel = channels.find(def.name);
+        if (channel == channels.end()) continue;
+
+        if (def.length < 1 || def.length > 64) {
+            throw std::runtime_error("CAN signal " + def.name + " has invalid length");
+        }
+
+        CompiledSignal sig{};
+        sig.mask = def.length == 64 ? ~0ull : (1ull << def.length) - 1;
+        sig.length = static_cast<uint8_t>(def.length);
+        sig.bigEndian = def.bigEndian;
+        sig.isSigned = def.isSigned;
+        sig.scale = def.scale;
+        sig.offset = def.offset;
+        sig.channelId = channel->second;
+
+        int lastByte;
+        if (def.bigEndian) {
+            // DBC Motorola start bit is the MSB; count bits MSB-first across
+            // the frame so the signal becomes a plain shift of the big-endian word
+            int msb = (def.startBit / 8) * 8 + (7 - def.startBit % 8);
+            int lsb = msb + def.length - 1;
+            if (lsb > 63) throw std::runtime_error("CAN signal " + def.name + " does not fit in 8 bytes");
+            sig.shift = static_cast<uint8_t>(63 - lsb);
+            lastByte = lsb / 8;
+        } else {
+            if (def.startBit + def.length > 64) {
+                throw std::runtime_error("CAN signal " + def.name + " does not fit in 8 bytes");
+            }
+            sig.shift = static_cast<uint8_t>(def.startBit);
+            lastByte = (def.startBit + def.length - 1) / 8;
+        }
+
+        byMessage[def.messageId].push_back(sig);
+        minDlc[def.messageId] = std::max<uint8_t>(minDlc[def.messageId], static_cast<uint8_t>(lastByte + 1));
+    }
+
+    // std::map iterates in id order, extended ids carry bit 31 so they sort last
+    for (const auto& [id, messageSignals] : byMessage) {
+        CompiledMessage message{};
+        message.id = id;
+        message.minDlc = minDlc[id];
+        message.firstSignal = static_cast<uint32_t>(signals.size());
+        message.signalCount = static_cast<uint32_t>(messageSignals.size());
+        signals.insert(signals.end(), messageSignals.begin(), messageSignals.end());
+
+        if (!(id & CAN_EXTENDED_FLAG)) {
+            standardIndex[id] = static_cast<uint16_t>(messages.size());
+        }
+        messages.push_back(message);
+    }
+}
+
+const CanDecoder::CompiledMessage* CanDecoder::findMessage(uint32_t id) const {
+    if (!(id & CAN_EXTENDED_FLAG)) {
+        if (id > 0x7FF) return nullptr;
+        uint16_t index = standardIndex[id];
+        return index == NO_MESSAGE ? nullptr : &messages[index];
+    }
+
+    auto it = std::lower_bound(messages.begin(), messages.end(), id,
+                               [](const CompiledMessage& m, uint32_t value) { return m.id < value; });
+    return (it != messages.end() && it->id == id) ? &*it : nullptr;
+}
+
+int CanDecoder::decode(const CanFrame& frame, std::chrono::steady_clock::time_point timestamp) {
+    framesSeen++;
+    if (frame.id & (CAN_REMOTE_FLAG | CAN_ERROR_FLAG)) {
+        framesSkipped++;
+        return 0;
+    }
+
+    const CompiledMessage* message = findMessage(frame.id);
+    if (!message) return 0;
+    if (frame.dlc < message->minDlc) {
+        framesTooShort++;
+        return 0;
+    }
+
+    // The whole payload as one word in each byte order
+    uint64_t little = 0;
+    uint64_t big = 0;
+    for (int i = 0; i < 8; ++i) {
+        little |= static_cast<uint64_t>(frame.data[i]) << (8 * i);
+        big = (big << 8) | frame.data[i];
+    }
+
+    const CompiledSignal* sig = &signals[message->firstSignal];
+    for (uint32_t i = 0; i < message->signalCount; ++i, ++sig) {
+        uint64_t raw = ((sig->bigEndian ? big : little) >> sig->shift) & sig->mask;
+
+        double value;
+        if (sig->isSigned && sig->length < 64 && (raw >> (sig->length - 1)) & 1) {
+            value = static_cast<double>(static_cast<int64_t>(raw | ~sig->mask));
+        } else if (sig->isSigned) {
+            value = static_cast<double>(static_cast<int64_t>(raw));
+        } else {
+            value = static_cast<double>(raw);
+        }
+
+        store.publish(sig->channelId, value * sig->scale + sig->offset, timestamp);
+    }
+
+    framesDecoded++;
+    signalsDecoded += message->signalCount;
+    return static_cast<int>(message->signalCount);
+}
+
+void CanDecoder::printStats(std::ostream& out) const {
+    out << "=== CAN decoding ===" << std::endl;
+    out << "messages: " << messages.size() << ", signals: " << signals.size() << std::endl;
+    out << "frames seen: " << framesSeen << ", decoded: " << framesDecoded
+        << ", too short: " << framesTooShort << ", remote/error: " << framesSkipped
+        << ", signals published: " << signalsDecoded << std::endl;
+}
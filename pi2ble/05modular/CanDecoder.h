@@ -0,0 +1,94 @@
+#ifndef CAN_DECODER_H
+#define CAN_DECODER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+#include "TelemetryStore.h"
+
+// Same layout as SocketCAN's struct can_frame (classic CAN, 8 data bytes)
+struct CanFrame {
+    uint32_t id = 0;  // CAN_EFF_FLAG (bit 31) set for 29-bit ids
+    uint8_t dlc = 0;
+    uint8_t pad[3] = {0, 0, 0};
+    uint8_t data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+};
+
+constexpr uint32_t CAN_EXTENDED_FLAG = 0x80000000u;
+constexpr uint32_t CAN_REMOTE_FLAG = 0x40000000u; // RTR: a request, no data
+constexpr uint32_t CAN_ERROR_FLAG = 0x20000000u;  // error frame from the controller
+constexpr uint32_t CAN_EXTENDED_ID_MASK = 0x1FFFFFFFu;
+
+// One row of the signal table, as written in CanSignals.yaml
+struct CanSignalDef {
+    uint32_t messageId = 0;
+    std::string name;
+    int startBit = 0;
+    int length = 8;
+    bool bigEndian = false;
+    bool isSigned = false;
+    double scale = 1.0;
+    double offset = 0.0;
+};
+
+std::vector<CanSignalDef> loadCanSignals(const std::string& filename = "CanSignals.yaml");
+
+// Decodes raw frames into telemetry channels.
+//
+// The signal table is compiled once: each signal becomes a shift/mask pair
+// on the frame read as one 64-bit word, and message ids index straight into
+// a dispatch array (binary search for 29-bit ids). decode() is a table
+// lookup plus bit extraction and never allocates.
+//
+// A signal is only decoded when a telemetry entry with `ingress.type: can`
+// uses its name as `ingress.key`.
+class CanDecoder {
+private:
+    struct CompiledSignal {
+        uint64_t mask;
+        uint8_t shift;
+        uint8_t length;
+        bool bigEndian;
+        bool isSigned;
+        double scale;
+        double offset;
+        int channelId;
+    };
+
+    struct CompiledMessage {
+        uint32_t id;
+        uint8_t minDlc; // frames shorter than this can't hold every signal
+        uint32_t firstSignal;
+        uint32_t signalCount;
+    };
+
+    static constexpr uint16_t NO_MESSAGE = 0xFFFF;
+
+    TelemetryStore& store;
+    std::vector<CompiledSignal> signals;
+    std::vector<CompiledMessage> messages; // sorted by id, 29-bit ids last
+    std::vector<uint16_t> standardIndex;   // 2048 entries, 11-bit id -> message
+
+    uint64_t framesSeen = 0;
+    uint64_t framesDecoded = 0;
+    uint64_t signalsDecoded = 0;
+    uint64_t framesTooShort = 0;
+    uint64_t framesSkipped = 0; // remote and error frames
+
+public:
+    CanDecoder(const AppConfig& appConfig, const std::vector<CanSignalDef>& table, TelemetryStore& store);
+
+    // Returns the number of signals published from this frame; remote and
+    // error frames carry no signal data and publish nothing
+    int decode(const CanFrame& frame, std::chrono::steady_clock::time_point timestamp);
+
+    size_t signalCount() const { return signals.size(); }
+    void printStats(std::ostream& out) const;
+
+private:
+    const CompiledMessage* findMessage(uint32_t id) const;
+};
+
+#endif // CAN_DECODER_H
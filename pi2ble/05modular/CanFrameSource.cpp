@@ -0,0 +1,152 @@
+#include "CanFrameSource.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+static_assert(sizeof(CanFrame) == sizeof(can_frame), "CanFrame must match struct can_frame");
+static_assert(CAN_EXTENDED_FLAG == CAN_EFF_FLAG && CAN_REMOTE_FLAG == CAN_RTR_FLAG && CAN_ERROR_FLAG == CAN_ERR_FLAG &&
+                  CAN_EXTENDED_ID_MASK == CAN_EFF_MASK,
+              "CanFrame ids use the SocketCAN flag bits");
+
+using Clock = std::chrono::steady_clock;
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+CanReplaySource::CanReplaySource(const std::string& path, bool replayRealtime)
+    : realtime(replayRealtime) {
+    if (path == "-") {
+        file = stdin;
+    } else {
+        file = std::fopen(path.c_str(), "r");
+        if (!file) {
+            throw std::runtime_error("Could not open CAN log " + path + ": " + std::strerror(errno));
+        }
+        ownsFile = true;
+    }
+}
+
+CanReplaySource::~CanReplaySource() {
+    if (ownsFile && file) std::fclose(file);
+}
+
+bool CanReplaySource::parseLine(const char* p, CanFrame& frame, double& logTime, bool& hasLogTime) {
+    hasLogTime = false;
+    while (*p == ' ' || *p == '\t') p++;
+
+    // Optional "(seconds.micros) iface " prefix from candump -l
+    if (*p == '(') {
+        char* end;
+        logTime = std::strtod(p + 1, &end);
+        if (*end != ')') return false;
+        hasLogTime = true;
+        p = end + 1;
+        while (*p == ' ') p++;
+        while (*p && *p != ' ') p++; // interface name
+        while (*p == ' ') p++;
+    }
+
+    // <id>#<data>, 3 hex digits for 11-bit ids and 8 for 29-bit ids
+    uint32_t id = 0;
+    int digits = 0;
+    int v;
+    while ((v = hexDigit(*p)) >= 0) {
+        id = (id << 4) | static_cast<uint32_t>(v);
+        digits++;
+        p++;
+    }
+    if (*p != '#' || digits == 0 || digits > 8) return false;
+    if (digits > 3 ? id > CAN_EXTENDED_ID_MASK : id > 0x7FF) return false; // wider than 29 / 11 bits
+    p++;
+    if (*p == 'R' || *p == '#') return false; // remote or CAN FD frame
+
+    frame.id = digits > 3 ? (id | CAN_EXTENDED_FLAG) : id;
+    frame.dlc = 0;
+    std::memset(frame.data, 0, sizeof(frame.data));
+    while (frame.dlc < 8) {
+        int high = hexDigit(p[0]);
+        if (high < 0) break;
+        int low = hexDigit(p[1]);
+        if (low < 0) return false;
+        frame.data[frame.dlc++] = static_cast<uint8_t>(high * 16 + low);
+        p += 2;
+        if (*p == '.') p++; // optional byte separator
+    }
+    return true;
+}
+
+bool CanReplaySource::next(CanFrame& frame, Clock::time_point& timestamp) {
+    while (std::fgets(line, sizeof(line), file)) {
+        double logTime = 0.0;
+        bool hasLogTime = false;
+        if (!parseLine(line, frame, logTime, hasLogTime)) {
+            if (line[0] != '\n' && line[0] != '#') badLines++;
+            continue;
+        }
+
+        if (realtime && hasLogTime) {
+            if (!haveFirstTime) {
+                haveFirstTime = true;
+                firstLogTime = logTime;
+                startTime = Clock::now();
+            }
+            auto due = startTime + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(logTime - firstLogTime));
+            std::this_thread::sleep_until(due);
+        }
+
+        timestamp = Clock::now();
+        return true;
+    }
+    return false;
+}
+
+SocketCanSource::SocketCanSource(const std::string& interface) {
+    fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Could not create CAN socket: ") + std::strerror(errno));
+    }
+
+    ifreq ifr{};
+    std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    if (::ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Unknown CAN interface " + interface);
+    }
+
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not bind to CAN interface " + interface);
+    }
+}
+
+SocketCanSource::~SocketCanSource() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool SocketCanSource::next(CanFrame& frame, Clock::time_point& timestamp) {
+    while (true) {
+        ssize_t n = ::read(fd, &frame, sizeof(frame));
+        if (n < 0 && errno == EINTR) continue;
+        if (n != static_cast<ssize_t>(sizeof(frame))) return false;
+        if (frame.id & (CAN_RTR_FLAG | CAN_ERR_FLAG)) continue; // remote and error frames
+
+        timestamp = Clock::now();
+        return true;
+    }
+}
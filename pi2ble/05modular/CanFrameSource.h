@@ -0,0 +1,56 @@
+#ifndef CAN_FRAME_SOURCE_H
+#define CAN_FRAME_SOURCE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "CanDecoder.h"
+
+// Where raw CAN frames come from. next() blocks until a frame is available
+// and returns false at end of stream.
+class CanFrameSource {
+public:
+    virtual ~CanFrameSource() = default;
+    virtual bool next(CanFrame& frame, std::chrono::steady_clock::time_point& timestamp) = 0;
+};
+
+// Replays a candump log from a file, or from a pipe when path is "-".
+// Accepts both `candump -l` lines "(1436509052.249713) can0 123#DEADBEEF"
+// and bare "123#DEADBEEF". Remote and CAN FD frames are skipped.
+// With realtime set, frames are released on the log's own timeline.
+class CanReplaySource : public CanFrameSource {
+private:
+    FILE* file = nullptr;
+    bool ownsFile = false;
+    bool realtime;
+    char line[256];
+    bool haveFirstTime = false;
+    double firstLogTime = 0.0;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t badLines = 0;
+
+public:
+    explicit CanReplaySource(const std::string& path, bool realtime = false);
+    ~CanReplaySource() override;
+
+    bool next(CanFrame& frame, std::chrono::steady_clock::time_point& timestamp) override;
+    uint64_t getBadLines() const { return badLines; }
+
+    // Parses one log line, returns false if it holds no classic data frame
+    static bool parseLine(const char* text, CanFrame& frame, double& logTime, bool& hasLogTime);
+};
+
+// Live frames from a SocketCAN interface (e.g. can0 on an MCP2515 hat)
+class SocketCanSource : public CanFrameSource {
+private:
+    int fd = -1;
+
+public:
+    explicit SocketCanSource(const std::string& interface);
+    ~SocketCanSource() override;
+
+    bool next(CanFrame& frame, std::chrono::steady_clock::time_point& timestamp) override;
+};
+
+#endif // CAN_FRAME_SOURCE_H
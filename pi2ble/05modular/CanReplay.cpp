@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include "AppConfig.h"
+#include "CanDecoder.h"
+#include "CanFrameSource.h"
+#include "TelemetryStore.h"
+
+// Writes a synthetic candump -l log to stdout: the signals from
+// CanSignals.yaml plus unrelated broadcast traffic, at 100 Hz per message.
+static void generateLog(long frames) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> noiseId(0x200, 0x7FF);
+    std::uniform_int_distribution<int> noiseByte(0, 255);
+
+    for (long i = 0; i < frames; ++i) {
+        uint8_t data[8] = {0};
+        unsigned id;
+        double seconds = i / 400.0; // 4 frames per 10 ms
+
+        switch (i % 4) {
+            case 0: { // 0x0C9: throttle byte 1, brake 12 bits from bit 20
+                id = 0x0C9;
+                int throttle = static_cast<int>((50.0 + 45.0 * std::sin(2 * M_PI * 0.3 * seconds)) / 0.392157);
+                int brake = static_cast<int>((20.0 + 20.0 * std::sin(2 * M_PI * 0.1 * seconds)) / 0.1);
+                data[1] = static_cast<uint8_t>(throttle);
+                data[2] = static_cast<uint8_t>((brake & 0x0F) << 4);
+                data[3] = static_cast<uint8_t>(brake >> 4);
+                break;
+            }
+            case 1: { // 0x1E5: big endian signed steering angle in bytes 0-1
+                id = 0x1E5;
+                int16_t angle = static_cast<int16_t>(std::lround(90.0 * std::sin(2 * M_PI * 0.2 * seconds) / 0.1));
+                data[0] = static_cast<uint8_t>(static_cast<uint16_t>(angle) >> 8);
+                data[1] = static_cast<uint8_t>(angle & 0xFF);
+                break;
+            }
+            default:
+                id = static_cast<unsigned>(noiseId(generator));
+                for (auto& b : data) b = static_cast<uint8_t>(noiseByte(generator));
+                break;
+        }
+
+        std::printf("(%.6f) can0 %03X#", 1700000000.0 + seconds, id);
+        for (uint8_t b : data) std::printf("%02X", b);
+        std::printf("\n");
+    }
+}
+
+// Decodes CAN frames from a candump log, a pipe or a SocketCAN interface
+// and reports decode throughput.
+//
+// Usage: ./CanReplay [log file | -] [--realtime]
+//        ./CanReplay --socketcan
+//        ./CanReplay --generate <frames> > drive.log
+int main(int argc, char* argv[]) {
+    try {
+        std::string source = argc > 1 ? argv[1] : "-";
+        if (source == "--generate") {
+            generateLog(argc > 2 ? std::stol(argv[2]) : 100000);
+            return 0;
+        }
+        bool realtime = argc > 2 && std::string(argv[2]) == "--realtime";
+
+        AppConfig appConfig = loadAppConfig();
+        std::vector<CanSignalDef> table = loadCanSignals(appConfig.can.signals);
+
+        TelemetryStore store(appConfig);
+        CanDecoder decoder(appConfig, table, store);
+
+        std::unique_ptr<CanFrameSource> frames;
+        if (source == "--socketcan") {
+            std::cout << "Listening on " << appConfig.can.interface << std::endl;
+            frames.reset(new SocketCanSource(appConfig.can.interface));
+        } else {
+            frames.reset(new CanReplaySource(source, realtime));
+        }
+
+        CanFrame frame;
+        std::chrono::steady_clock::time_point timestamp;
+        uint64_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration decodeTime{};
+
+        while (frames->next(frame, timestamp)) {
+            auto before = std::chrono::steady_clock::now();
+            decoder.decode(frame, timestamp);
+            decodeTime += std::chrono::steady_clock::now() - before;
+            count++;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double decodeNs = count > 0 ? std::chrono::duration<double, std::nano>(decodeTime).count() / count : 0.0;
+
+        decoder.printStats(std::cout);
+        std::cout << std::fixed << std::setprecision(1)
+                  << "frames: " << count << " in " << seconds << " s ("
+                  << (seconds > 0 ? count / seconds : 0.0) << " frames/s incl. parsing), "
+                  << decodeNs << " ns/frame decode" << std::endl;
+
+        std::cout << "Latest values:" << std::endl;
+        for (size_t id = 0; id < store.channelCount(); ++id) {
+            TelemetrySample sample = store.latest(static_cast<int>(id));
+            if (sample.updates == 0) continue;
+            std::cout << "  " << store.channelName(static_cast<int>(id)) << ": " << sample.value
+                      << " (" << sample.updates << " updates)" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
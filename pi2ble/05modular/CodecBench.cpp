@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "SessionLog.h"
+#include "TimeSeriesCodec.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Block {
+    int64_t firstNs = 0;
+    std::vector<double> values;
+    std::vector<uint32_t> offsetsUs;
+    std::vector<uint16_t> channels;
+};
+
+struct CodecStats {
+    uint64_t samples = 0;
+    uint64_t rawBytes = 0;
+    uint64_t gorillaBytes = 0;
+    uint64_t mismatches = 0;
+    Clock::duration encodeTime{};
+    Clock::duration decodeTime{};
+};
+
+// Like SensorSimulator (sine + gaussian noise doubles) plus OBD style
+// channels that only take exact steps: speed in km/h, rpm in 1/4 rpm,
+// coolant in degrees. Each channel at its own rate with a little jitter.
+static std::vector<Block> simulatedBlocks(int seconds, size_t blockSamples) {
+    struct Channel {
+        double rateHz;
+        double step; // 0 = full precision
+        double base, amplitude, frequency;
+    };
+    const std::vector<Channel> channels = {
+        {20, 0, 20.0, 15.0, 0.10},   // temperature
+        {20, 0, 15.0, 10.0, 0.15},   // wind speed
+        {20, 0, 60.0, 25.0, 0.08},   // humidity
+        {20, 1, 80.0, 60.0, 0.05},   // speed
+        {20, 0.25, 3000.0, 2500.0, 0.2}, // rpm
+        {1, 1, 85.0, 10.0, 0.01},    // coolant
+        {100, 0.1, 0.0, 450.0, 0.3}, // steering, CAN raw * 0.1
+        {100, 1, 40.0, 40.0, 0.5},   // throttle %
+    };
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.5);
+    std::uniform_int_distribution<int> jitterUs(-300, 300);
+
+    struct Event {
+        int64_t timeUs;
+        uint16_t channel;
+        double value;
+    };
+    std::vector<Event> events;
+    for (size_t c = 0; c < channels.size(); ++c) {
+        const Channel& ch = channels[c];
+        int64_t periodUs = static_cast<int64_t>(1e6 / ch.rateHz);
+        for (int64_t t = 0; t < seconds * 1000000LL; t += periodUs) {
+            double s = t / 1e6;
+            double v = ch.base + ch.amplitude * std::sin(2 * M_PI * ch.frequency * s);
+            v = ch.step > 0 ? std::round(v / ch.step) * ch.step : v + noise(rng);
+            events.push_back({std::max<int64_t>(0, t + jitterUs(rng)), static_cast<uint16_t>(c), v});
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.timeUs < b.timeUs; });
+
+    std::vector<Block> blocks;
+    for (size_t i = 0; i < events.size(); i += blockSamples) {
+        Block block;
+        block.firstNs = events[i].timeUs * 1000;
+        for (size_t j = i; j < std::min(events.size(), i + blockSamples); ++j) {
+            block.values.push_back(events[j].value);
+            block.offsetsUs.push_back(static_cast<uint32_t>(events[j].timeUs - events[i].timeUs));
+            block.channels.push_back(events[j].channel);
+        }
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+// Every block of recorded session segments, whatever their encoding
+static std::vector<Block> recordedBlocks(const std::vector<std::string>& paths) {
+    std::vector<Block> blocks;
+    DecodedBlock decoded;
+    for (const auto& path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        SessionSegmentHeader header{};
+        if (data.size() < sizeof(header)) continue;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != SESSION_LOG_MAGIC) {
+            std::cerr << path << ": not a session segment" << std::endl;
+            continue;
+        }
+
+        size_t offset = header.headerBytes;
+        size_t end = std::min<size_t>(header.usedBytes, data.size());
+        while (offset + sizeof(SessionBlockHeader) <= end) {
+            SessionBlockHeader blockHeader;
+            std::memcpy(&blockHeader, data.data() + offset, sizeof(blockHeader));
+            offset += sizeof(blockHeader);
+            if (offset + blockHeader.payloadBytes > end ||
+                !decodeSessionBlock(blockHeader, data.data() + offset, decoded)) {
+                std::cerr << path << ": bad block" << std::endl;
+                break;
+            }
+            offset += blockHeader.payloadBytes;
+
+            Block block;
+            block.firstNs = blockHeader.firstTimestampNs;
+            block.values = decoded.values;
+            block.channels = decoded.channels;
+            for (int64_t t : decoded.timestampsNs) {
+                block.offsetsUs.push_back(static_cast<uint32_t>((t - block.firstNs) / 1000));
+            }
+            blocks.push_back(std::move(block));
+        }
+    }
+    return blocks;
+}
+
+using SampleKey = std::tuple<int64_t, uint16_t, uint64_t>;
+
+static void sortedKeys(const std::vector<int64_t>& timestamps, const std::vector<uint16_t>& channels,
+                       const std::vector<double>& values, std::vector<SampleKey>& keys) {
+    keys.clear();
+    for (size_t i = 0; i < values.size(); ++i) {
+        uint64_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        keys.emplace_back(timestamps[i], channels[i], bits);
+    }
+    std::sort(keys.begin(), keys.end());
+}
+
+static CodecStats run(const std::vector<Block>& blocks) {
+    CodecStats stats;
+    GorillaBlockEncoder encoder;
+    DecodedBlock decoded;
+    std::vector<uint8_t> buffer;
+    std::vector<int64_t> expectedTimestamps;
+    std::vector<SampleKey> expected, actual;
+
+    for (const Block& block : blocks) {
+        size_t n = block.values.size();
+        size_t rawPayload = sessionRawPayloadBytes(n);
+        buffer.resize(rawPayload);
+
+        auto before = Clock::now();
+        size_t payload = encoder.encode(block.values.data(), block.offsetsUs.data(), block.channels.data(), n,
+                                        buffer.data(), buffer.size());
+        stats.encodeTime += Clock::now() - before;
+
+        SessionBlockHeader header{};
+        header.magic = SESSION_BLOCK_MAGIC;
+        header.sampleCount = static_cast<uint32_t>(n);
+        header.firstTimestampNs = block.firstNs;
+        if (payload == 0) {
+            // Bigger than raw: the recorder would store it raw
+            payload = rawPayload;
+            header.encoding = SESSION_BLOCK_RAW;
+            std::memcpy(buffer.data(), block.values.data(), n * sizeof(double));
+            std::memcpy(buffer.data() + n * sizeof(double), block.offsetsUs.data(), n * sizeof(uint32_t));
+            std::memcpy(buffer.data() + n * (sizeof(double) + sizeof(uint32_t)), block.channels.data(),
+                        n * sizeof(uint16_t));
+        } else {
+            header.encoding = SESSION_BLOCK_GORILLA;
+        }
+        header.payloadBytes = static_cast<uint32_t>(payload);
+
+        before = Clock::now();
+        bool ok = decodeSessionBlock(header, buffer.data(), decoded);
+        stats.decodeTime += Clock::now() - before;
+
+        stats.samples += n;
+        stats.rawBytes += sizeof(SessionBlockHeader) + rawPayload;
+        stats.gorillaBytes += sizeof(SessionBlockHeader) + payload;
+
+        expectedTimestamps.clear();
+        for (uint32_t offsetUs : block.offsetsUs) expectedTimestamps.push_back(block.firstNs + offsetUs * 1000LL);
+        sortedKeys(expectedTimestamps, block.channels, block.values, expected);
+        if (ok) sortedKeys(decoded.timestampsNs, decoded.channels, decoded.values, actual);
+        if (!ok || expected != actual) stats.mismatches++;
+    }
+    return stats;
+}
+
+static void printStats(const std::string& label, const CodecStats& stats) {
+    double encodeSeconds = std::chrono::duration<double>(stats.encodeTime).count();
+    double decodeSeconds = std::chrono::duration<double>(stats.decodeTime).count();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== " << label << ": " << stats.samples << " samples ===" << std::endl;
+    std::cout << "raw blocks:     " << stats.rawBytes / static_cast<double>(stats.samples) << " B/sample" << std::endl;
+    std::cout << "gorilla blocks: " << stats.gorillaBytes / static_cast<double>(stats.samples) << " B/sample ("
+              << static_cast<double>(stats.rawBytes) / stats.gorillaBytes << "x vs raw blocks, "
+              << 8.0 * stats.samples / stats.gorillaBytes << "x vs bare doubles)" << std::endl;
+    std::cout << std::setprecision(1) << "encode: " << stats.samples / encodeSeconds / 1e6 << " M samples/s, decode: "
+              << stats.samples / decodeSeconds / 1e6 << " M samples/s" << std::endl;
+    std::cout << "round trip: " << (stats.mismatches ? "MISMATCH in " + std::to_string(stats.mismatches) + " blocks"
+                                                     : std::string("lossless"))
+              << std::endl;
+}
+
+// Compression ratio and throughput of the GORILLA block encoding.
+//
+// Usage: ./CodecBench [seconds]              simulated channels
+//        ./CodecBench session-...-0000.tlog  recorded segments
+int main(int argc, char* argv[]) {
+    try {
+        std::vector<std::string> paths;
+        int seconds = 600;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.size() > 5 && arg.compare(arg.size() - 5, 5, ".tlog") == 0) {
+                paths.push_back(arg);
+            } else {
+                seconds = std::stoi(arg);
+            }
+        }
+
+        CodecStats stats;
+        if (paths.empty()) {
+            stats = run(simulatedBlocks(seconds, 4096));
+            printStats("simulated, " + std::to_string(seconds) + " s of 8 channels", stats);
+        } else {
+            stats = run(recordedBlocks(paths));
+            printStats("recorded", stats);
+        }
+        if (stats.mismatches) return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+#include "TimeSeriesCodec.h"
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+static uint64_t bitsOf(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Samples of a block in the order the recorder hands them over
+struct Block {
+    std::vector<double> values;
+    std::vector<uint32_t> offsetsUs;
+    std::vector<uint16_t> channels;
+
+    void add(uint16_t channel, uint32_t offsetUs, double value) {
+        channels.push_back(channel);
+        offsetsUs.push_back(offsetUs);
+        values.push_back(value);
+    }
+};
+
+static SessionBlockHeader headerFor(const Block& block, SessionBlockEncoding encoding, int64_t firstNs,
+                                    size_t payloadBytes) {
+    SessionBlockHeader header{};
+    header.magic = SESSION_BLOCK_MAGIC;
+    header.encoding = encoding;
+    header.sampleCount = static_cast<uint32_t>(block.values.size());
+    header.payloadBytes = static_cast<uint32_t>(payloadBytes);
+    header.firstTimestampNs = firstNs;
+    header.lastTimestampNs = firstNs + *std::max_element(block.offsetsUs.begin(), block.offsetsUs.end()) * 1000LL;
+    return header;
+}
+
+// Every sample comes back once, value bit for bit, at first + offset us.
+// Offsets are distinct, so matching by timestamp is unambiguous; raw
+// blocks decode in stored order, gorilla blocks in timestamp order.
+static bool matches(const Block& block, int64_t firstNs, const DecodedBlock& decoded) {
+    size_t count = block.values.size();
+    if (decoded.size() != count) return false;
+    std::vector<size_t> expected(count), actual(count);
+    for (size_t i = 0; i < count; ++i) expected[i] = actual[i] = i;
+    std::sort(expected.begin(), expected.end(),
+              [&](size_t a, size_t b) { return block.offsetsUs[a] < block.offsetsUs[b]; });
+    std::sort(actual.begin(), actual.end(),
+              [&](size_t a, size_t b) { return decoded.timestampsNs[a] < decoded.timestampsNs[b]; });
+    for (size_t i = 0; i < count; ++i) {
+        size_t j = expected[i], k = actual[i];
+        if (decoded.channels[k] != block.channels[j] || bitsOf(decoded.values[k]) != bitsOf(block.values[j]) ||
+            decoded.timestampsNs[k] != firstNs + static_cast<int64_t>(block.offsetsUs[j]) * 1000) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool gorillaRoundTrip(GorillaBlockEncoder& encoder, const Block& block, int64_t firstNs) {
+    size_t count = block.values.size();
+    // Room for the channel records, which a raw-sized payload lacks for tiny blocks
+    std::vector<uint8_t> payload(sessionRawPayloadBytes(count) + 1024);
+    size_t bytes = encoder.encode(block.values.data(), block.offsetsUs.data(), block.channels.data(), count,
+                                  payload.data(), payload.size());
+    if (bytes == 0) return false;
+    DecodedBlock decoded;
+    return decodeSessionBlock(headerFor(block, SESSION_BLOCK_GORILLA, firstNs, bytes), payload.data(), decoded) &&
+           matches(block, firstNs, decoded);
+}
+
+static bool rawRoundTrip(const Block& block, int64_t firstNs) {
+    size_t count = block.values.size();
+    std::vector<uint8_t> payload(sessionRawPayloadBytes(count));
+    uint8_t* p = payload.data();
+    std::memcpy(p, block.values.data(), count * sizeof(double));
+    p += count * sizeof(double);
+    std::memcpy(p, block.offsetsUs.data(), count * sizeof(uint32_t));
+    p += count * sizeof(uint32_t);
+    std::memcpy(p, block.channels.data(), count * sizeof(uint16_t));
+    DecodedBlock decoded;
+    SessionBlockHeader header = headerFor(block, SESSION_BLOCK_RAW, firstNs, payload.size());
+    return decodeSessionBlock(header, payload.data(), decoded) && matches(block, firstNs, decoded);
+}
+
+// Gorilla (XOR, quantized and CAN-scaled channels) and raw session blocks
+// decode to exactly what was encoded.
+//
+// Usage: ./CodecCheck
+int main() {
+    const int64_t firstNs = 1234567890123LL;
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    GorillaBlockEncoder encoder;
+
+    // Interleaved channels, jittered 1 ms steps, out of order within a step
+    Block mixed;
+    for (uint32_t i = 0; i < 4096; ++i) {
+        uint32_t t = i * 1000 + (rng() % 500) * 2;
+        uint16_t channel = static_cast<uint16_t>(i % 4);
+        switch (channel) {
+            case 0: mixed.add(0, t, 90.0 + noise(rng)); break;                              // XOR
+            case 1: mixed.add(1, t, std::round(3000.0 + 500.0 * noise(rng)) / 4.0); break; // rpm / 4
+            case 2: mixed.add(2, t, static_cast<int>(200.0 * noise(rng)) * 0.1); break;    // CAN raw * 0.1
+            default: mixed.add(3, t, 55.0); break;                                         // constant
+        }
+    }
+    std::swap(mixed.values[10], mixed.values[14]);
+    std::swap(mixed.offsetsUs[10], mixed.offsetsUs[14]);
+    check(gorillaRoundTrip(encoder, mixed, firstNs), "gorilla: XOR, quantized, CAN-scaled and constant channels");
+
+    Block special;
+    const double values[] = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+                             -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+                             std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max(), 1e-300};
+    for (uint32_t i = 0; i < 8; ++i) special.add(0, i * 7, values[i]);
+    check(gorillaRoundTrip(encoder, special, firstNs), "gorilla: signed zero, infinities, NaN, denormals");
+
+    Block spread;
+    spread.add(0, 0, 1.0);
+    spread.add(0, 1, 2.0);
+    spread.add(0, 4000000000u, 3.0);
+    spread.add(1, 5, 0.25);
+    check(gorillaRoundTrip(encoder, spread, firstNs), "gorilla: offsets 1 us apart and over an hour apart");
+
+    Block single;
+    single.add(9, 0, 42.5);
+    check(gorillaRoundTrip(encoder, single, firstNs), "gorilla: one sample on a high channel id");
+
+    check(gorillaRoundTrip(encoder, mixed, firstNs), "gorilla: encoder reused for another block");
+    check(rawRoundTrip(mixed, firstNs), "raw block");
+
+    std::vector<uint8_t> small(64);
+    check(encoder.encode(mixed.values.data(), mixed.offsetsUs.data(), mixed.channels.data(), mixed.values.size(),
+                         small.data(), small.size()) == 0,
+          "gorilla: a payload that doesn't fit returns 0");
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,264 @@
+#include <opencv2/opencv.hpp>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "ConfigCache.h"
+#include "FramebufferOut.h"
+#include "OverlayDraw.h"
+#include "StartupProfile.h"
+#include "TelemetryStore.h"
+
+// Static layer packed in the framebuffer's format, for the lean start.
+// Only used when the screen and the config file are the ones it was made
+// for; the config is matched by size and mtime without parsing it.
+struct LayerCacheHeader {
+    char magic[8];
+    uint32_t width;
+    uint32_t height;
+    uint32_t bitsPerPixel;
+    uint32_t stride;
+    int64_t configSize;
+    int64_t configMtimeNs;
+};
+
+static const char LAYER_MAGIC[8] = {'C', 'S', 'L', 'A', 'Y', 'E', 'R', '1'};
+
+// Everything the heavy part of startup produces
+struct Overlay {
+    std::unique_ptr<TelemetryStore> store;
+    std::vector<OverlayItem> items;
+    cv::Mat staticLayer;
+};
+
+static bool configStamp(const std::string& path, int64_t& size, int64_t& mtimeNs) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    size = info.st_size;
+    mtimeNs = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    return true;
+}
+
+static LayerCacheHeader cacheHeader(const FramebufferOut& fb, int64_t configSize, int64_t configMtimeNs) {
+    LayerCacheHeader header;
+    std::memcpy(header.magic, LAYER_MAGIC, sizeof(LAYER_MAGIC));
+    header.width = fb.width();
+    header.height = fb.height();
+    header.bitsPerPixel = fb.bitsPerPixel();
+    header.stride = static_cast<uint32_t>(fb.stride());
+    header.configSize = configSize;
+    header.configMtimeNs = configMtimeNs;
+    return header;
+}
+
+// Reads a matching cached layer straight into the framebuffer; false if
+// there is none or it is stale
+static bool showCachedLayer(const std::string& cachePath, const std::string& configPath, FramebufferOut& fb) {
+    int64_t configSize, configMtimeNs;
+    if (!configStamp(configPath, configSize, configMtimeNs)) return false;
+    LayerCacheHeader expected = cacheHeader(fb, configSize, configMtimeNs);
+
+    int fd = ::open(cachePath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    LayerCacheHeader header;
+    bool shown = ::read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+                 std::memcmp(&header, &expected, sizeof(header)) == 0 &&
+                 ::read(fd, fb.pixels(), fb.bytes()) == static_cast<ssize_t>(fb.bytes());
+    ::close(fd);
+    return shown;
+}
+
+// Written to a temporary file and renamed, so a power cut mid-write never
+// leaves a torn layer for the next start
+static void writeLayerCache(const std::string& cachePath, const std::string& configPath, const FramebufferOut& fb,
+                            const cv::Mat& staticLayer) {
+    int64_t configSize, configMtimeNs;
+    if (!configStamp(configPath, configSize, configMtimeNs)) return;
+    LayerCacheHeader header = cacheHeader(fb, configSize, configMtimeNs);
+    std::vector<uint8_t> packed(fb.bytes());
+    fb.pack(staticLayer, packed.data());
+
+    std::string tmpPath = cachePath + ".tmp";
+    std::FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) throw std::runtime_error("Could not write " + tmpPath);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(packed.data(), 1, packed.size(), file) == packed.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Could not write " + cachePath);
+    }
+}
+
+// Config, store, OpenCV's lazy setup and the static layer: the part of
+// startup that doesn't need the screen. The config comes from the compiled
+// cache (see ConfigCache.h) unless parseYaml.
+static void initialize(Overlay& overlay, const std::string& configPath, bool parseYaml, int width, int height) {
+    std::unique_ptr<CompiledConfig> compiled;
+    if (parseYaml) {
+        // Compiled in memory, the rest of startup is the same
+        StartupProfile::Phase phase("config (YAML)");
+        compiled.reset(new CompiledConfig(compileConfig(loadAppConfig(configPath), 0, 0, 0)));
+    } else {
+        StartupProfile::Phase phase("config (compiled cache)");
+        compiled = openConfigCache(configPath);
+    }
+    {
+        StartupProfile::Phase phase("telemetry store");
+        overlay.store.reset(new TelemetryStore(compiled->channelNames()));
+        overlay.items = overlayItems(*compiled, *overlay.store);
+    }
+    {
+        // First allocation, fill and parallel resize start OpenCV's
+        // allocator, dispatch tables and thread pool
+        StartupProfile::Phase phase("OpenCV warm-up");
+        cv::Mat frame(height, width, CV_8UC3);
+        frame.setTo(cv::Scalar(0, 0, 0));
+        cv::Mat half;
+        cv::resize(frame, half, cv::Size(width / 2, height / 2), 0, 0, cv::INTER_AREA);
+    }
+    {
+        // The first putText builds the Hershey font tables
+        StartupProfile::Phase phase("fonts + static layer");
+        overlay.staticLayer.create(height, width, CV_8UC3);
+        overlay.staticLayer.setTo(cv::Scalar(20, 20, 20));
+        drawOverlayLabels(overlay.staticLayer, overlay.items);
+    }
+}
+
+// Time to first frame of the telemetry overlay, split by phase: dynamic
+// linking, shared library init (OpenCV's static initializers), config,
+// OpenCV's lazy setup, fonts, framebuffer open. Draws one frame and exits.
+//
+// The config is read from the compiled cache next to the YAML, compiled
+// first if the YAML changed; --yaml parses AppConfig.yaml instead, to
+// compare the two.
+//
+// --lean shows the static layer cached by the previous run first, read
+// straight into the framebuffer, and does the rest on a background
+// thread; the first live frame follows when that is done. A run without
+// a valid cache writes it after its first live frame.
+//
+// Only opencv_core and opencv_imgproc are linked: every module linked is
+// loaded, relocated and statically initialized before main, and videoio
+// or highgui pull in codec and GUI libraries the overlay doesn't use.
+//
+// Usage: ./ColdStart [--lean] [--yaml] [--fb /dev/fb0|none] [--config AppConfig.yaml] [--cache ColdStart.layer]
+//                    [--hold seconds]
+//   --fb none draws into a 640x480 framebuffer in memory
+//   measure a real cold start after: sync; echo 3 > /proc/sys/vm/drop_caches
+int main(int argc, char* argv[]) {
+    StartupProfile::enterMain();
+
+    bool lean = false;
+    bool parseYaml = false;
+    std::string device = "/dev/fb0";
+    std::string configPath = "AppConfig.yaml";
+    std::string cachePath = "ColdStart.layer";
+    double holdSeconds = 0.0;
+    bool usage = false;
+    for (int i = 1; i < argc && !usage; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--lean") {
+            lean = true;
+        } else if (arg == "--yaml") {
+            parseYaml = true;
+        } else if (arg == "--fb" && i + 1 < argc) {
+            device = argv[++i];
+        } else if (arg == "--config" && i + 1 < argc) {
+            configPath = argv[++i];
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cachePath = argv[++i];
+        } else if (arg == "--hold" && i + 1 < argc) {
+            char* end = nullptr;
+            holdSeconds = std::strtod(argv[++i], &end);
+            usage = end == argv[i] || *end != '\0' || !std::isfinite(holdSeconds) || holdSeconds < 0;
+        } else {
+            usage = true;
+        }
+    }
+    if (usage) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--lean] [--yaml] [--fb /dev/fb0|none] [--config AppConfig.yaml] [--cache ColdStart.layer]"
+                     " [--hold seconds]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        std::unique_ptr<FramebufferOut> fb;
+        {
+            StartupProfile::Phase phase("fb open");
+            if (device == "none") {
+                fb.reset(new FramebufferOut(640, 480, 32));
+            } else {
+                fb.reset(new FramebufferOut(device));
+            }
+        }
+
+        bool cachedLayerShown = false;
+        if (lean) {
+            StartupProfile::Phase phase("cached static layer");
+            cachedLayerShown = showCachedLayer(cachePath, configPath, *fb);
+        }
+        if (cachedLayerShown) StartupProfile::firstFrame();
+
+        Overlay overlay;
+        if (lean) {
+            std::exception_ptr error;
+            std::thread init([&] {
+                try {
+                    initialize(overlay, configPath, parseYaml, fb->width(), fb->height());
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            });
+            {
+                // Ingress would start here; nothing else to do in this tool
+                StartupProfile::Phase phase("waiting for init");
+                init.join();
+            }
+            if (error) std::rethrow_exception(error);
+        } else {
+            initialize(overlay, configPath, parseYaml, fb->width(), fb->height());
+        }
+
+        {
+            StartupProfile::Phase phase("first live frame");
+            cv::Mat frame;
+            overlay.staticLayer.copyTo(frame);
+            drawOverlayValues(frame, overlay.items, *overlay.store);
+            fb->show(frame);
+        }
+        StartupProfile::firstFrame();
+
+        if (!cachedLayerShown) {
+            StartupProfile::Phase phase("write layer cache");
+            writeLayerCache(cachePath, configPath, *fb, overlay.staticLayer);
+        }
+
+        StartupProfile::print(std::cout);
+        if (lean && !cachedLayerShown) {
+            std::cout << "No cached layer for this screen and config yet, written for the next start" << std::endl;
+        }
+        if (holdSeconds > 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(holdSeconds));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
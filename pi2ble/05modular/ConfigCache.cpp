@@ -0,0 +1,346 @@
+#include "ConfigCache.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <yaml-cpp/yaml.h>
+
+// CRC-32 (IEEE, reflected poly 0xEDB88320)
+struct Crc32Table {
+    uint32_t entries[256];
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+static const Crc32Table CRC32_TABLE;
+
+static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0xFFFFFFFFu) {
+    for (size_t i = 0; i < length; ++i) {
+        crc = (crc >> 8) ^ CRC32_TABLE.entries[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+// Over the whole blob, the checksum field counted as zero
+static uint32_t blobChecksum(const uint8_t* data, size_t size) {
+    const size_t field = offsetof(ConfigCacheHeader, checksum);
+    const uint8_t zero[sizeof(uint32_t)] = {};
+    uint32_t crc = crc32(data, field);
+    crc = crc32(zero, sizeof(zero), crc);
+    crc = crc32(data + field + sizeof(uint32_t), size - field - sizeof(uint32_t), crc);
+    return ~crc;
+}
+
+static uint64_t fnv1a(const std::string& bytes) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : bytes) {
+        hash = (hash ^ c) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static bool yamlStamp(const std::string& path, int64_t& size, int64_t& mtimeNs) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    size = info.st_size;
+    mtimeNs = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    return true;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Could not open " + path);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Strings deduplicated into one table, "" at offset 0
+class StringTable {
+private:
+    std::string table;
+
+public:
+    StringTable() : table(1, '\0') {}
+
+    uint32_t add(const std::string& text) {
+        if (text.empty()) return 0;
+        std::string entry = text + '\0';
+        size_t found = table.find(entry);
+        // Only a match at the start of an entry is the same string
+        while (found != std::string::npos && found > 0 && table[found - 1] != '\0') {
+            found = table.find(entry, found + 1);
+        }
+        if (found != std::string::npos) return static_cast<uint32_t>(found);
+        uint32_t offset = static_cast<uint32_t>(table.size());
+        table += entry;
+        return offset;
+    }
+
+    const std::string& bytes() const { return table; }
+};
+
+CompiledConfig::CompiledConfig(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ConfigCacheHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Config cache " + path + " is truncated");
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + path);
+    }
+    data = static_cast<const uint8_t*>(mapping);
+    mapped = true;
+    try {
+        validate(path);
+    } catch (...) {
+        munmap(const_cast<uint8_t*>(data), size);
+        throw;
+    }
+}
+
+CompiledConfig::CompiledConfig(std::vector<uint8_t> bytes) : memory(std::move(bytes)) {
+    data = memory.data();
+    size = memory.size();
+    if (size < sizeof(ConfigCacheHeader)) throw std::runtime_error("Compiled config is truncated");
+    validate("compiled config");
+}
+
+CompiledConfig::~CompiledConfig() {
+    if (mapped) munmap(const_cast<uint8_t*>(data), size);
+}
+
+void CompiledConfig::validate(const std::string& what) const {
+    const ConfigCacheHeader& h = header();
+    if (h.magic != CONFIG_CACHE_MAGIC || h.version != CONFIG_CACHE_VERSION) {
+        throw std::runtime_error(what + " is not a version " + std::to_string(CONFIG_CACHE_VERSION) + " config cache");
+    }
+    uint64_t channelsEnd = sizeof(ConfigCacheHeader) + static_cast<uint64_t>(h.channelCount) * sizeof(ConfigCacheChannel);
+    if (h.totalBytes != size || h.stringsOffset < channelsEnd || h.stringsOffset >= size || data[size - 1] != '\0') {
+        throw std::runtime_error(what + " is truncated");
+    }
+    if (blobChecksum(data, size) != h.checksum) {
+        throw std::runtime_error(what + " fails its checksum");
+    }
+    if (h.recorderSegmentMB < 1 || h.recorderBlockSamples < 1 || h.recorderQueueCapacity < 1) {
+        throw std::runtime_error(what + " has a recorder segment, block or queue size below 1");
+    }
+}
+
+std::vector<std::string> CompiledConfig::channelNames() const {
+    std::vector<std::string> names;
+    for (size_t id = 0; id < channelCount(); ++id) names.push_back(string(channel(id).name));
+    return names;
+}
+
+AppConfig CompiledConfig::toAppConfig() const {
+    const ConfigCacheHeader& h = header();
+    AppConfig config;
+    config.video.width = h.videoWidth;
+    config.video.height = h.videoHeight;
+    config.video.framerate = h.videoFramerate;
+    config.video.showLatency = h.videoShowLatency != 0;
+    config.obd.device = string(h.obdDevice);
+    config.obd.baud = h.obdBaud;
+    config.obd.maxPidsPerRequest = h.obdMaxPidsPerRequest;
+    config.obd.maxInFlight = h.obdMaxInFlight;
+    config.obd.timeoutMs = h.obdTimeoutMs;
+    config.can.interface = string(h.canInterface);
+    config.can.signals = string(h.canSignals);
+    config.link.host = string(h.linkHost);
+    config.link.port = h.linkPort;
+    config.link.resolution = h.linkResolution;
+    config.link.keyframeInterval = h.linkKeyframeInterval;
+    config.bus.name = string(h.busName);
+    config.bus.ringCapacity = h.busRingCapacity;
+    config.recorder.directory = string(h.recorderDirectory);
+    config.recorder.prefix = string(h.recorderPrefix);
+    config.recorder.segmentMB = h.recorderSegmentMB;
+    config.recorder.blockSamples = h.recorderBlockSamples;
+    config.recorder.blockMaxAgeMs = h.recorderBlockMaxAgeMs;
+    config.recorder.syncIntervalMs = h.recorderSyncIntervalMs;
+    config.recorder.queueCapacity = h.recorderQueueCapacity;
+    config.recorder.encoding = string(h.recorderEncoding);
+    config.realtime.enabled = h.realtimeEnabled != 0;
+    config.realtime.renderCpu = h.realtimeRenderCpu;
+    config.realtime.ingestCpu = h.realtimeIngestCpu;
+    config.realtime.renderPriority = h.realtimeRenderPriority;
+    config.realtime.ingestPriority = h.realtimeIngestPriority;
+    config.realtime.lockMemory = h.realtimeLockMemory != 0;
+    config.realtime.prefaultStackKB = h.realtimePrefaultStackKB;
+
+    for (size_t id = 0; id < channelCount(); ++id) {
+        const ConfigCacheChannel& c = channel(id);
+        TelemetryConfig telemetry;
+        telemetry.x = c.x;
+        telemetry.y = c.y;
+        telemetry.color.assign(c.color, c.color + c.colorCount);
+        telemetry.format = string(c.format);
+        telemetry.ingress.key = string(c.ingressKey);
+        telemetry.ingress.type = string(c.ingressType);
+        telemetry.ingress.baud = c.ingressBaud;
+        telemetry.ingress.pid = c.ingressPid;
+        telemetry.ingress.rate = c.ingressRate;
+        config.telemetry[string(c.name)] = telemetry;
+    }
+    return config;
+}
+
+std::vector<uint8_t> compileConfig(const AppConfig& config, int64_t yamlSize, int64_t yamlMtimeNs, uint64_t yamlHash) {
+    StringTable strings;
+    ConfigCacheHeader h;
+    std::memset(&h, 0, sizeof(h));
+    h.magic = CONFIG_CACHE_MAGIC;
+    h.version = CONFIG_CACHE_VERSION;
+    h.channelCount = static_cast<uint32_t>(config.telemetry.size());
+    h.yamlSize = yamlSize;
+    h.yamlMtimeNs = yamlMtimeNs;
+    h.yamlHash = yamlHash;
+    h.videoWidth = config.video.width;
+    h.videoHeight = config.video.height;
+    h.videoFramerate = config.video.framerate;
+    h.videoShowLatency = config.video.showLatency ? 1 : 0;
+    h.obdDevice = strings.add(config.obd.device);
+    h.obdBaud = config.obd.baud;
+    h.obdMaxPidsPerRequest = config.obd.maxPidsPerRequest;
+    h.obdMaxInFlight = config.obd.maxInFlight;
+    h.obdTimeoutMs = config.obd.timeoutMs;
+    h.canInterface = strings.add(config.can.interface);
+    h.canSignals = strings.add(config.can.signals);
+    h.linkHost = strings.add(config.link.host);
+    h.linkResolution = config.link.resolution;
+    h.linkPort = config.link.port;
+    h.linkKeyframeInterval = config.link.keyframeInterval;
+    h.busName = strings.add(config.bus.name);
+    h.busRingCapacity = config.bus.ringCapacity;
+    h.recorderDirectory = strings.add(config.recorder.directory);
+    h.recorderPrefix = strings.add(config.recorder.prefix);
+    h.recorderSegmentMB = config.recorder.segmentMB;
+    h.recorderBlockSamples = config.recorder.blockSamples;
+    h.recorderBlockMaxAgeMs = config.recorder.blockMaxAgeMs;
+    h.recorderSyncIntervalMs = config.recorder.syncIntervalMs;
+    h.recorderQueueCapacity = config.recorder.queueCapacity;
+    h.recorderEncoding = strings.add(config.recorder.encoding);
+    h.realtimeEnabled = config.realtime.enabled ? 1 : 0;
+    h.realtimeRenderCpu = config.realtime.renderCpu;
+    h.realtimeIngestCpu = config.realtime.ingestCpu;
+    h.realtimeRenderPriority = config.realtime.renderPriority;
+    h.realtimeIngestPriority = config.realtime.ingestPriority;
+    h.realtimeLockMemory = config.realtime.lockMemory ? 1 : 0;
+    h.realtimePrefaultStackKB = config.realtime.prefaultStackKB;
+
+    // std::map order is TelemetryStore's id order
+    std::vector<ConfigCacheChannel> channels;
+    for (const auto& [name, telemetry] : config.telemetry) {
+        ConfigCacheChannel c;
+        std::memset(&c, 0, sizeof(c));
+        c.name = strings.add(name);
+        c.format = strings.add(telemetry.format);
+        size_t placeholder = telemetry.format.find("$0");
+        c.hasValue = placeholder != std::string::npos ? 1 : 0;
+        c.formatPrefix = strings.add(telemetry.format.substr(0, placeholder));
+        if (c.hasValue) c.formatSuffix = strings.add(telemetry.format.substr(placeholder + 2));
+        c.x = telemetry.x;
+        c.y = telemetry.y;
+        c.colorCount = static_cast<uint32_t>(std::min<size_t>(telemetry.color.size(), 3));
+        for (uint32_t i = 0; i < c.colorCount; ++i) c.color[i] = telemetry.color[i];
+        c.ingressKey = strings.add(telemetry.ingress.key);
+        c.ingressType = strings.add(telemetry.ingress.type);
+        c.ingressBaud = telemetry.ingress.baud;
+        c.ingressPid = telemetry.ingress.pid;
+        c.ingressRate = telemetry.ingress.rate;
+        channels.push_back(c);
+    }
+
+    h.stringsOffset = sizeof(ConfigCacheHeader) + channels.size() * sizeof(ConfigCacheChannel);
+    h.totalBytes = h.stringsOffset + strings.bytes().size();
+    std::vector<uint8_t> blob(h.totalBytes);
+    std::memcpy(blob.data() + sizeof(h), channels.data(), channels.size() * sizeof(ConfigCacheChannel));
+    std::memcpy(blob.data() + h.stringsOffset, strings.bytes().data(), strings.bytes().size());
+    std::memcpy(blob.data(), &h, sizeof(h));
+    uint32_t checksum = blobChecksum(blob.data(), blob.size());
+    std::memcpy(blob.data() + offsetof(ConfigCacheHeader, checksum), &checksum, sizeof(checksum));
+    return blob;
+}
+
+std::string configCachePath(const std::string& yamlPath) {
+    return yamlPath + ".bin";
+}
+
+// Temporary file + rename, so readers never map a half-written cache
+static bool writeCache(const std::string& path, const std::vector<uint8_t>& blob) {
+    std::string tmpPath = path + ".tmp" + std::to_string(getpid());
+    std::FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<CompiledConfig> openConfigCache(const std::string& yamlPath) {
+    std::string cachePath = configCachePath(yamlPath);
+    int64_t yamlSize, yamlMtimeNs;
+    if (!yamlStamp(yamlPath, yamlSize, yamlMtimeNs)) {
+        throw std::runtime_error("Could not open " + yamlPath);
+    }
+
+    std::unique_ptr<CompiledConfig> cached;
+    try {
+        cached.reset(new CompiledConfig(cachePath));
+    } catch (const std::runtime_error&) {
+        // Missing or unusable: compiled again below
+    }
+    if (cached && cached->header().yamlSize == yamlSize && cached->header().yamlMtimeNs == yamlMtimeNs) {
+        return cached;
+    }
+
+    std::string yaml = readFile(yamlPath);
+    uint64_t hash = fnv1a(yaml);
+    std::vector<uint8_t> blob;
+    if (cached && cached->header().yamlHash == hash) {
+        // Same content under a new mtime: restamp, no parse
+        blob.assign(cached->bytes(), cached->bytes() + cached->header().totalBytes);
+        ConfigCacheHeader* h = reinterpret_cast<ConfigCacheHeader*>(blob.data());
+        h->yamlSize = yamlSize;
+        h->yamlMtimeNs = yamlMtimeNs;
+        h->checksum = blobChecksum(blob.data(), blob.size());
+    } else {
+        // The text just hashed, not the file again: it may have changed since
+        blob = compileConfig(loadAppConfig(YAML::Load(yaml), yamlPath), yamlSize, yamlMtimeNs, hash);
+    }
+    cached.reset();
+
+    if (writeCache(cachePath, blob)) {
+        return std::unique_ptr<CompiledConfig>(new CompiledConfig(cachePath));
+    }
+    std::cerr << "Warning: could not write config cache " << cachePath << ", using it from memory" << std::endl;
+    return std::unique_ptr<CompiledConfig>(new CompiledConfig(std::move(blob)));
+}
+
+AppConfig loadAppConfigCached(const std::string& yamlPath) {
+    return openConfigCache(yamlPath)->toAppConfig();
+}
@@ -0,0 +1,158 @@
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+
+// Compiled AppConfig: the resolved config as one binary blob that is
+// mmapped and read in place, so a boot with an unchanged AppConfig.yaml
+// does no YAML parsing and builds no maps.
+//
+// <yaml>.bin, next to the YAML:
+//   ConfigCacheHeader
+//   ConfigCacheChannel[channelCount]   in TelemetryStore id order (by name)
+//   char strings[]                     NUL terminated, referenced by offset
+//                                      from stringsOffset, 0 is ""
+// checksum is CRC-32 of the whole file with the checksum field zeroed.
+// The blob is only read on the machine that wrote it: native byte order
+// and layout, a different build is caught by version and size.
+//
+// The cache records the YAML's size, mtime and FNV-1a hash. If size and
+// mtime match it is used as is; if only they changed (touched, copied)
+// but the hash matches it is restamped; otherwise it is recompiled.
+
+constexpr uint32_t CONFIG_CACHE_MAGIC = 0x47464354; // "TCFG"
+constexpr uint32_t CONFIG_CACHE_VERSION = 2;
+
+struct ConfigCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t checksum;
+    uint32_t channelCount;
+    uint64_t totalBytes;
+    uint64_t stringsOffset;
+    int64_t yamlSize;
+    int64_t yamlMtimeNs;
+    uint64_t yamlHash;
+
+    // video
+    int32_t videoWidth;
+    int32_t videoHeight;
+    int32_t videoFramerate;
+    uint32_t videoShowLatency;
+    // obd
+    uint32_t obdDevice;
+    int32_t obdBaud;
+    int32_t obdMaxPidsPerRequest;
+    int32_t obdMaxInFlight;
+    int32_t obdTimeoutMs;
+    // can
+    uint32_t canInterface;
+    uint32_t canSignals;
+    // link
+    uint32_t linkHost;
+    double linkResolution;
+    int32_t linkPort;
+    int32_t linkKeyframeInterval;
+    // bus
+    uint32_t busName;
+    int32_t busRingCapacity;
+    // recorder
+    uint32_t recorderDirectory;
+    uint32_t recorderPrefix;
+    int32_t recorderSegmentMB;
+    int32_t recorderBlockSamples;
+    int32_t recorderBlockMaxAgeMs;
+    int32_t recorderSyncIntervalMs;
+    int32_t recorderQueueCapacity;
+    uint32_t recorderEncoding;
+    // realtime
+    uint32_t realtimeEnabled;
+    int32_t realtimeRenderCpu;
+    int32_t realtimeIngestCpu;
+    int32_t realtimeRenderPriority;
+    int32_t realtimeIngestPriority;
+    uint32_t realtimeLockMemory;
+    int32_t realtimePrefaultStackKB;
+    uint32_t reserved;
+};
+static_assert(sizeof(ConfigCacheHeader) == 192, "config cache header layout");
+
+// One telemetry entry with its formatter resolved: the text is
+// formatPrefix + value + formatSuffix, or just formatPrefix if the format
+// has no $0 (hasValue 0)
+struct ConfigCacheChannel {
+    uint32_t name;
+    uint32_t format;
+    uint32_t formatPrefix;
+    uint32_t formatSuffix;
+    uint32_t hasValue;
+    int32_t x;
+    int32_t y;
+    uint32_t colorCount; // entries used in color, R G B
+    int32_t color[3];
+    uint32_t ingressKey;
+    uint32_t ingressType;
+    int32_t ingressBaud;
+    int32_t ingressPid;
+    uint32_t reserved;
+    double ingressRate;
+};
+static_assert(sizeof(ConfigCacheChannel) == 72, "config cache channel layout");
+
+// A compiled config, mapped read-only (or held in memory when the cache
+// couldn't be written). Pointers into it stay valid while it lives.
+class CompiledConfig {
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint8_t> memory;
+
+public:
+    // Throws std::runtime_error if the file is missing, truncated, of
+    // another version or fails its checksum
+    explicit CompiledConfig(const std::string& path);
+    explicit CompiledConfig(std::vector<uint8_t> bytes);
+    ~CompiledConfig();
+
+    CompiledConfig(const CompiledConfig&) = delete;
+    CompiledConfig& operator=(const CompiledConfig&) = delete;
+
+    const ConfigCacheHeader& header() const { return *reinterpret_cast<const ConfigCacheHeader*>(data); }
+    size_t channelCount() const { return header().channelCount; }
+    const ConfigCacheChannel& channel(size_t id) const {
+        return reinterpret_cast<const ConfigCacheChannel*>(data + sizeof(ConfigCacheHeader))[id];
+    }
+    const char* string(uint32_t offset) const {
+        return reinterpret_cast<const char*>(data + header().stringsOffset + offset);
+    }
+    const uint8_t* bytes() const { return data; }
+
+    // Channel names in id order, for TelemetryStore
+    std::vector<std::string> channelNames() const;
+    // Back to the parsed form, for code that takes an AppConfig
+    AppConfig toAppConfig() const;
+
+private:
+    void validate(const std::string& what) const;
+};
+
+// The blob for config, stamped with the YAML it came from
+std::vector<uint8_t> compileConfig(const AppConfig& config, int64_t yamlSize, int64_t yamlMtimeNs, uint64_t yamlHash);
+
+std::string configCachePath(const std::string& yamlPath);
+
+// The compiled config for yamlPath, recompiling or restamping the cache
+// first if the YAML changed. If the cache can't be written (read-only
+// filesystem) it warns and returns the compiled config from memory.
+std::unique_ptr<CompiledConfig> openConfigCache(const std::string& yamlPath = "AppConfig.yaml");
+
+// loadAppConfig through the cache
+AppConfig loadAppConfigCached(const std::string& yamlPath = "AppConfig.yaml");
+
+#endif // CONFIG_CACHE_H
@@ -0,0 +1,82 @@
+#include "ConfigWatcher.h"
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+// Quiet time after the last event before reloading: editors write a file
+// in several steps
+static const int DEBOUNCE_MS = 100;
+
+ConfigWatcher::ConfigWatcher(const std::string& path, const CompiledConfig& current, Callback callback)
+    : yamlPath(path), onConfig(std::move(callback)), currentHash(current.header().yamlHash) {
+    size_t slash = yamlPath.rfind('/');
+    directory = slash == std::string::npos ? "." : yamlPath.substr(0, slash + 1);
+    fileName = slash == std::string::npos ? yamlPath : yamlPath.substr(slash + 1);
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        throw std::runtime_error(std::string("inotify_init1 failed: ") + std::strerror(errno));
+    }
+    if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        int error = errno;
+        ::close(inotifyFd);
+        throw std::runtime_error("Could not watch " + directory + ": " + std::strerror(error));
+    }
+
+    running = true;
+    watcher = std::thread(&ConfigWatcher::watchLoop, this);
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    running = false;
+    if (watcher.joinable()) watcher.join();
+    if (inotifyFd >= 0) ::close(inotifyFd);
+}
+
+void ConfigWatcher::watchLoop() {
+    alignas(inotify_event) char buffer[4096];
+    bool pending = false;
+    auto lastEvent = std::chrono::steady_clock::now();
+
+    while (running) {
+        // Short timeout so the destructor isn't kept waiting
+        pollfd descriptor = {inotifyFd, POLLIN, 0};
+        if (poll(&descriptor, 1, 50) > 0) {
+            ssize_t length;
+            while ((length = ::read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if (event->len > 0 && fileName == event->name) {
+                        pending = true;
+                        lastEvent = std::chrono::steady_clock::now();
+                    }
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+        if (pending && std::chrono::steady_clock::now() - lastEvent >= std::chrono::milliseconds(DEBOUNCE_MS)) {
+            pending = false;
+            reload();
+        }
+    }
+}
+
+void ConfigWatcher::reload() {
+    try {
+        std::unique_ptr<CompiledConfig> compiled = openConfigCache(yamlPath);
+        uint64_t hash = compiled->header().yamlHash;
+        if (hash == currentHash) return;
+        onConfig(std::move(compiled));
+        currentHash = hash;
+        ++reloads;
+    } catch (const std::exception& e) {
+        ++rejected;
+        std::cerr << "Rejected " << yamlPath << ", keeping the running config: " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef CONFIG_WATCHER_H
+#define CONFIG_WATCHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "ConfigCache.h"
+
+// Watches a YAML config with inotify and hands every changed version to
+// onConfig, compiled through openConfigCache(), on the watcher's own
+// thread. The directory is watched rather than the file, so editors that
+// save by writing a new file and renaming it are seen too. Events are
+// debounced; a save that leaves the content unchanged (same hash) is not
+// passed on.
+//
+// A config that fails to parse, or that onConfig throws on (its own
+// checks), is rejected: it is reported on std::cerr and counted, and the
+// running config stays as it is. onConfig is where the application
+// builds what it draws from and publishes it, e.g. into an RcuPointer.
+class ConfigWatcher {
+public:
+    using Callback = std::function<void(std::unique_ptr<CompiledConfig>)>;
+
+private:
+    std::string yamlPath;
+    std::string directory;
+    std::string fileName;
+    Callback onConfig;
+    uint64_t currentHash;
+    int inotifyFd = -1;
+    std::thread watcher;
+    std::atomic<bool> running{false};
+
+    void watchLoop();
+    void reload();
+
+public:
+    std::atomic<uint64_t> reloads{0};
+    std::atomic<uint64_t> rejected{0};
+
+    // current: the config already in use, changes are relative to it.
+    // Throws std::runtime_error if inotify can't watch the directory.
+    ConfigWatcher(const std::string& yamlPath, const CompiledConfig& current, Callback onConfig);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+};
+
+#endif // CONFIG_WATCHER_H
@@ -0,0 +1,482 @@
+#include <opencv2/opencv.hpp>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FramebufferPack.h"
+#include "GraphDraw.h"
+#include "OverlayDraw.h"
+#include "ProgressBar.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+// One benchmark: body() is a single iteration, it keeps its own state
+// (which geometry to draw next) so every run draws the same sequence
+struct BenchCase {
+    std::string name;
+    std::function<void()> body;
+};
+
+struct BenchResult {
+    std::string name;
+    int64_t iterations = 0;
+    double realNs = 0; // median over repetitions, per iteration
+    double minNs = 0;
+    double cpuNs = 0;
+};
+
+struct BenchOptions {
+    std::string filter;
+    std::string jsonPath;
+    int width = 1280;
+    int height = 720;
+    double minTime = 0.2; // seconds per repetition
+    int repetitions = 5;
+    int cpu = -1;
+};
+
+static double threadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Google Benchmark's scheme: grow the iteration count until one run takes
+// minTime, then time that many iterations repetitions times
+static BenchResult runCase(const BenchCase& bench, const BenchOptions& options) {
+    bench.body(); // warm up caches and OpenCV's lazily built tables
+
+    int64_t iterations = 1;
+    while (true) {
+        auto start = Clock::now();
+        for (int64_t i = 0; i < iterations; ++i) bench.body();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= options.minTime || iterations >= (int64_t(1) << 30)) break;
+        double scale = seconds > 0 ? options.minTime * 1.4 / seconds : 10.0;
+        iterations = static_cast<int64_t>(iterations * std::max(2.0, std::min(10.0, scale)));
+    }
+
+    std::vector<double> real;
+    std::vector<double> cpu;
+    for (int rep = 0; rep < options.repetitions; ++rep) {
+        double cpuStart = threadCpuNs();
+        auto start = Clock::now();
+        for (int64_t i = 0; i < iterations; ++i) bench.body();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        real.push_back(ns / iterations);
+        cpu.push_back((threadCpuNs() - cpuStart) / iterations);
+    }
+
+    BenchResult result;
+    result.name = bench.name;
+    result.iterations = iterations;
+    result.realNs = median(real);
+    result.minNs = *std::min_element(real.begin(), real.end());
+    result.cpuNs = median(cpu);
+    return result;
+}
+
+// An in-memory framebuffer of one pixel layout for the blit cases
+struct MemoryFB {
+    PixelLayout layout;
+    size_t lineLength;
+    std::vector<uint8_t> pixels;
+
+    MemoryFB(int width, int height, const PixelLayout& pixelLayout)
+        : layout(pixelLayout), lineLength(static_cast<size_t>(width) * pixelLayout.bitsPerPixel / 8),
+          pixels(lineLength * height) {}
+};
+
+// Every case draws onto the same frame; the contents don't change how
+// long a primitive takes, only its geometry does
+class DrawBench {
+private:
+    cv::Mat frame;
+    std::mt19937 rng;
+    std::vector<cv::Point> points; // random, inside the frame
+    size_t next = 0;
+    std::vector<BenchCase> cases;
+
+    // State shared by the widget cases, kept alive for their bodies
+    std::vector<std::vector<double>> graphData;
+    TelemetryStore store;
+    std::vector<int> telemetryIds;
+    std::vector<MemoryFB> framebuffers;
+    cv::Mat scratch;
+    std::string label;
+    OverlayLayer overlay;
+    cv::Mat luma;
+    cv::Mat chroma;
+    CameraFrame cameraFrame;
+
+    cv::Point nextPoint() {
+        const cv::Point& p = points[next];
+        next = (next + 1) % points.size();
+        return p;
+    }
+
+    void add(const std::string& name, std::function<void()> body) {
+        cases.push_back({name, std::move(body)});
+    }
+
+    static std::string number(double value) {
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+
+    static std::vector<std::string> channelNames() {
+        return {"rpm", "speed", "coolant", "throttle", "oil_temp", "intake", "voltage", "fuel"};
+    }
+
+public:
+    DrawBench(int width, int height)
+        : frame(height, width, CV_8UC3, cv::Scalar(40, 40, 40)), rng(42), store(channelNames()),
+          overlay(width, height), luma(height, width, CV_8UC1, cv::Scalar(16)),
+          chroma(height / 2, width / 2, CV_8UC2, cv::Scalar(128, 128)) {
+        std::uniform_int_distribution<int> xs(0, width - 1);
+        std::uniform_int_distribution<int> ys(0, height - 1);
+        for (int i = 0; i < 512; ++i) points.push_back(cv::Point(xs(rng), ys(rng)));
+
+        // putText at every scale / thickness in the projects (02DrawOnImage,
+        // 03StreamLoadingBar, 04MultiInput, 04MultiData, fb_cube, OverlayRender)
+        struct TextStyle {
+            double scale;
+            int thickness;
+            bool antialiased;
+        };
+        const std::vector<TextStyle> textStyles = {
+            {1.2, 4, false}, {1.2, 2, false}, {1.0, 2, false}, {0.8, 2, true}, {0.8, 2, false}, {0.7, 2, false},
+            {0.6, 2, false}, {0.6, 1, false}, {0.5, 2, false}, {0.5, 1, false}, {0.4, 1, false},
+        };
+        for (const TextStyle& style : textStyles) {
+            std::string name = "putText/scale:" + number(style.scale) + "/thickness:" + std::to_string(style.thickness);
+            if (style.antialiased) name += "/aa";
+            add(name, [this, style] {
+                cv::putText(frame, "Temp: 21.4 C", nextPoint(), cv::FONT_HERSHEY_SIMPLEX, style.scale,
+                            cv::Scalar(255, 255, 255), style.thickness, style.antialiased ? cv::LINE_AA : 8);
+            });
+        }
+
+        // Lines between random points: on average a third of the frame long
+        for (int thickness : {1, 2}) {
+            for (bool antialiased : {false, true}) {
+                std::string name = "line/thickness:" + std::to_string(thickness) + (antialiased ? "/aa" : "");
+                add(name, [this, thickness, antialiased] {
+                    cv::Point a = nextPoint();
+                    cv::line(frame, a, nextPoint(), cv::Scalar(200, 255, 255), thickness,
+                             antialiased ? cv::LINE_AA : 8);
+                });
+            }
+        }
+
+        // Progress bar body (400x30) and a graph background (frame wide)
+        const int graphWidth = width - 120;
+        const int graphHeight = std::max(10, (height - 340) / 3);
+        add("rectangle/filled/400x30", [this] {
+            cv::Point p = nextPoint();
+            cv::rectangle(frame, p, p + cv::Point(400, 30), cv::Scalar(100, 100, 100), -1);
+        });
+        add("rectangle/filled/" + std::to_string(graphWidth) + "x" + std::to_string(graphHeight),
+            [this, graphWidth, graphHeight] {
+                cv::rectangle(frame, cv::Point(60, 160), cv::Point(60 + graphWidth, 160 + graphHeight),
+                              cv::Scalar(20, 20, 20), -1);
+            });
+        for (int thickness : {1, 2}) {
+            add("rectangle/outline/400x30/thickness:" + std::to_string(thickness), [this, thickness] {
+                cv::Point p = nextPoint();
+                cv::rectangle(frame, p, p + cv::Point(400, 30), cv::Scalar(255, 255, 255), thickness);
+            });
+        }
+
+        // The graph's value dot and 02DrawOnImage's ring
+        add("circle/r:4/filled", [this] { cv::circle(frame, nextPoint(), 4, cv::Scalar(0, 0, 255), -1); });
+        add("circle/r:50/thickness:3", [this] { cv::circle(frame, nextPoint(), 50, cv::Scalar(255, 0, 255), 3); });
+
+        add("mat/alloc", [width, height] {
+            cv::Mat image(height, width, CV_8UC3);
+            image.data[0] = 0;
+        });
+        add("mat/setTo", [this] { frame.setTo(cv::Scalar(40, 40, 40)); });
+        add("mat/copyTo", [this] { frame.copyTo(scratch); });
+        add("mat/clone", [this] {
+            cv::Mat copy = frame.clone();
+            copy.data[0] = 0;
+        });
+
+        // drawGraph (04MultiInput's DataVisualizer, GraphDraw.h) at the default
+        // history (200) and a long one, at the quality levels that change it:
+        // full (LINE_AA), plain lines and fewer samples (a vertex per 8 px)
+        std::normal_distribution<double> noise(0.0, 0.5);
+        const cv::Rect graphArea(60, 160, graphWidth, graphHeight);
+        struct GraphLevel {
+            const char* name;
+            SeriesStyle style;
+        };
+        const GraphLevel levels[] = {
+            {"aa", {2, cv::LINE_AA, 0, 4, 5}},
+            {"plain", {2, cv::LINE_8, 0, 4, 5}},
+            {"fewer", {2, cv::LINE_8, static_cast<size_t>(std::max(2, graphWidth / 8)), 4, 5}},
+        };
+        graphData.reserve(2); // the bodies keep references into it
+        for (int samples : {200, 1000}) {
+            std::vector<double> data;
+            for (int i = 0; i < samples; ++i) data.push_back(20.0 + 15.0 * std::sin(i * 0.05) + noise(rng));
+            graphData.push_back(data);
+            const std::vector<double>& series = graphData.back();
+            for (const GraphLevel& level : levels) {
+                SeriesStyle style = level.style;
+                add("drawGraph/" + std::string(level.name) + "/samples:" + std::to_string(samples),
+                    [this, graphArea, style, &series] {
+                        drawSeries(frame, series, graphArea, -30.0, 50.0, cv::Scalar(0, 0, 255), style);
+                    });
+            }
+        }
+
+        label = "12.3 / 456.7 s";
+        add("OverlayDraw::drawProgressBar", [this] { drawProgressBar(frame, 0.42, label); });
+
+        // 03StreamLoadingBar's own bar: redrawn on its overlay layer at
+        // telemetry rate, or straight onto an NV12 camera buffer
+        add("03StreamLoadingBar::drawProgressBar/overlay", [this] {
+            overlay.clear();
+            drawProgressBar(overlay, 0.42, 1234, 5678);
+        });
+        cameraFrame.buffer = 0;
+        cameraFrame.format = CAMERA_NV12;
+        cameraFrame.luma = luma;
+        cameraFrame.chroma = chroma;
+        cameraFrame.sequence = 0;
+        add("03StreamLoadingBar::drawProgressBar/nv12",
+            [this] { drawProgressBar(cameraFrame, 0.42, 1234, 5678); });
+
+        for (size_t id = 0; id < store.channelCount(); ++id) {
+            store.publish(static_cast<int>(id), 100.0 + id, Clock::now());
+            telemetryIds.push_back(static_cast<int>(id));
+        }
+        add("drawTelemetry/channels:" + std::to_string(telemetryIds.size()),
+            [this] { drawTelemetry(frame, store, telemetryIds); });
+
+        // packBgr, what FramebufferOut and 04MultiInput's FramebufferSink run per frame
+        framebuffers.emplace_back(width, height, rgb565Layout());
+        framebuffers.emplace_back(width, height, xrgb8888Layout());
+        framebuffers.emplace_back(width, height, xbgr8888Layout());
+        const char* formats[] = {"rgb565", "xrgb8888", "xbgr8888"};
+        for (size_t i = 0; i < framebuffers.size(); ++i) {
+            MemoryFB* fb = &framebuffers[i];
+            add(std::string("packBgr/") + formats[i], [this, fb, width, height] {
+                packBgr(frame, width, height, fb->pixels.data(), fb->lineLength, fb->layout);
+            });
+        }
+    }
+
+    std::vector<BenchCase>& all() { return cases; }
+};
+
+static std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+    return out;
+}
+
+static void writeJson(const std::string& path, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("Could not write " + path);
+
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+#ifdef __OPTIMIZE__
+    const char* optimized = "true";
+#else
+    const char* optimized = "false";
+#endif
+
+    // Google Benchmark's layout, one benchmark per line so --compare (and
+    // diff) can read it without a JSON library
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"host_name\": \"" << jsonEscape(host) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"pinned_cpu\": " << options.cpu << ",\n";
+    out << "    \"opencv_version\": \"" << CV_VERSION << "\",\n";
+    out << "    \"opencv_threads\": " << cv::getNumThreads() << ",\n";
+    out << "    \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+    out << "    \"optimized\": " << optimized << ",\n";
+    out << "    \"frame\": \"" << options.width << "x" << options.height << "\",\n";
+    out << "    \"repetitions\": " << options.repetitions << ",\n";
+    out << "    \"min_time\": " << options.minTime << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"iterations\": " << r.iterations
+            << ", \"real_time\": " << r.realNs << ", \"real_time_min\": " << r.minNs << ", \"cpu_time\": " << r.cpuNs
+            << ", \"time_unit\": \"ns\"}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// name -> real_time of a file written by writeJson
+static std::map<std::string, double> readJson(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Could not open " + path);
+    std::map<std::string, double> times;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t name = line.find("\"name\": \"");
+        size_t time = line.find("\"real_time\": ");
+        if (name == std::string::npos || time == std::string::npos) continue;
+        name += 9;
+        size_t nameEnd = line.find('"', name);
+        times[line.substr(name, nameEnd - name)] = std::stod(line.substr(time + 13));
+    }
+    if (times.empty()) throw std::runtime_error("No benchmarks in " + path);
+    return times;
+}
+
+// Ratio of every benchmark in both files; 1 if any got slower than threshold
+static int compare(const std::string& baselinePath, const std::string& currentPath, double threshold) {
+    std::map<std::string, double> baseline = readJson(baselinePath);
+    std::map<std::string, double> current = readJson(currentPath);
+    int regressions = 0;
+    std::cout << std::left << std::setw(44) << "benchmark" << std::right << std::setw(12) << "base ns"
+              << std::setw(12) << "new ns" << std::setw(9) << "ratio" << std::endl;
+    for (const auto& entry : current) {
+        auto base = baseline.find(entry.first);
+        if (base == baseline.end()) continue;
+        double ratio = base->second > 0 ? entry.second / base->second : 0.0;
+        bool slower = ratio > threshold;
+        if (slower) regressions++;
+        std::cout << std::left << std::setw(44) << entry.first << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << base->second << std::setw(12) << entry.second << std::setprecision(2)
+                  << std::setw(9) << ratio << (slower ? "  SLOWER" : "") << std::endl;
+    }
+    std::cout << regressions << " benchmark(s) slower than " << threshold << "x" << std::endl;
+    return regressions > 0 ? 1 : 0;
+}
+
+// Microbenchmarks of every drawing primitive the overlays use: putText at
+// each font scale / thickness in the code, lines with and without AA,
+// rectangles, circles, Mat allocation and fills, drawGraph, the progress
+// bars of OverlayDraw and 03StreamLoadingBar and packBgr per framebuffer
+// format. Geometry comes
+// from a fixed seed, so two runs draw exactly the same things; run it on
+// the Pi 5 and the Zero 2 with the same --size and compare the JSON.
+//
+// Usage: ./DrawBench [--filter text] [--json out.json] [--size WxH] [--min-time seconds]
+//                    [--repetitions n] [--cpu n]
+//        ./DrawBench --compare baseline.json current.json [--threshold 1.10]
+//   --cpu pins the benchmark thread, pick an isolated core for stable numbers
+//   cmake --build build --target bench runs it and writes build/DrawBench.json
+int main(int argc, char* argv[]) {
+    try {
+        BenchOptions options;
+        std::vector<std::string> comparePaths;
+        double threshold = 1.10;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--filter") {
+                options.filter = value();
+            } else if (arg == "--json") {
+                options.jsonPath = value();
+            } else if (arg == "--size") {
+                std::string size = value();
+                if (std::sscanf(size.c_str(), "%dx%d", &options.width, &options.height) != 2 || options.width < 500 ||
+                    options.height < 400) {
+                    throw std::runtime_error("Bad --size " + size + ", expected WxH of at least 500x400");
+                }
+            } else if (arg == "--min-time") {
+                options.minTime = std::stod(value());
+            } else if (arg == "--repetitions") {
+                options.repetitions = std::max(1, std::stoi(value()));
+            } else if (arg == "--cpu") {
+                options.cpu = std::stoi(value());
+            } else if (arg == "--compare") {
+                comparePaths.push_back(value());
+                comparePaths.push_back(value());
+            } else if (arg == "--threshold") {
+                threshold = std::stod(value());
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--filter text] [--json out.json] [--size WxH] [--min-time seconds]"
+                             " [--repetitions n] [--cpu n]\n       "
+                          << argv[0] << " --compare baseline.json current.json [--threshold 1.10]" << std::endl;
+                return 1;
+            }
+        }
+
+        if (!comparePaths.empty()) return compare(comparePaths[0], comparePaths[1], threshold);
+
+        if (options.cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(options.cpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+                throw std::runtime_error("Could not pin to cpu " + std::to_string(options.cpu));
+            }
+        }
+#ifndef __OPTIMIZE__
+        std::cerr << "Warning: built without optimization, configure with -DCMAKE_BUILD_TYPE=Release" << std::endl;
+#endif
+
+        DrawBench bench(options.width, options.height);
+        std::vector<BenchResult> results;
+        std::cout << "Frame " << options.width << "x" << options.height << ", " << options.repetitions
+                  << " repetitions of " << options.minTime << " s" << std::endl;
+        std::cout << std::left << std::setw(44) << "benchmark" << std::right << std::setw(12) << "ns"
+                  << std::setw(12) << "min ns" << std::setw(12) << "cpu ns" << std::setw(12) << "iterations"
+                  << std::endl;
+        for (const BenchCase& benchCase : bench.all()) {
+            if (!options.filter.empty() && benchCase.name.find(options.filter) == std::string::npos) continue;
+            BenchResult r = runCase(benchCase, options);
+            results.push_back(r);
+            std::cout << std::left << std::setw(44) << r.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << r.realNs << std::setw(12) << r.minNs << std::setw(12) << r.cpuNs
+                      << std::setw(12) << r.iterations << std::endl;
+        }
+
+        if (!options.jsonPath.empty()) {
+            writeJson(options.jsonPath, options, results);
+            std::cout << "Wrote " << options.jsonPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "EcuSimulator.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+EcuSimulator::EcuSimulator(int delayMs, int frameUs)
+    : responseDelayMs(delayMs), frameTimeUs(frameUs) {
+    masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (masterFd < 0 || grantpt(masterFd) != 0 || unlockpt(masterFd) != 0) {
+        throw std::runtime_error(std::string("Could not create pty: ") + std::strerror(errno));
+    }
+    slaveName = ptsname(masterFd);
+
+    // Keep the slave open so the master never sees EIO between clients,
+    // and put it in raw mode like a real serial adapter
+    slaveFd = ::open(slaveName.c_str(), O_RDWR | O_NOCTTY);
+    if (slaveFd < 0) {
+        throw std::runtime_error("Could not open pty slave " + slaveName);
+    }
+    termios tio{};
+    tcgetattr(slaveFd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slaveFd, TCSANOW, &tio);
+
+    fcntl(masterFd, F_SETFL, fcntl(masterFd, F_GETFL) | O_NONBLOCK);
+}
+
+EcuSimulator::~EcuSimulator() {
+    stop();
+    if (slaveFd >= 0) ::close(slaveFd);
+    if (masterFd >= 0) ::close(masterFd);
+}
+
+void EcuSimulator::start() {
+    if (running.exchange(true)) return;
+    startTime = Clock::now();
+    busFreeAt = startTime;
+    worker = std::thread(&EcuSimulator::run, this);
+}
+
+void EcuSimulator::stop() {
+    running = false;
+    if (worker.joinable()) worker.join();
+}
+
+void EcuSimulator::run() {
+    while (running) {
+        auto now = Clock::now();
+
+        // Send every reply whose time has come
+        while (!replies.empty() && replies.front().due <= now) {
+            const std::string& text = replies.front().text;
+            if (::write(masterFd, text.data(), text.size()) < 0 && errno != EAGAIN) {
+                running = false;
+            }
+            replies.pop_front();
+        }
+
+        int waitMs = 50;
+        if (!replies.empty()) {
+            waitMs = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(replies.front().due - now).count());
+            waitMs = std::max(0, waitMs);
+        }
+
+        pollfd pfd{masterFd, POLLIN, 0};
+        if (::poll(&pfd, 1, waitMs) <= 0 || !(pfd.revents & POLLIN)) continue;
+
+        char buf[256];
+        ssize_t n;
+        while ((n = ::read(masterFd, buf, sizeof(buf))) > 0) {
+            for (ssize_t i = 0; i < n; ++i) {
+                if (buf[i] == '\r' || buf[i] == '\n') {
+                    if (!lineBuffer.empty()) handleCommand(lineBuffer);
+                    lineBuffer.clear();
+                } else {
+                    lineBuffer += static_cast<char>(std::toupper(static_cast<unsigned char>(buf[i])));
+                }
+            }
+        }
+    }
+}
+
+void EcuSimulator::handleCommand(const std::string& command) {
+    std::string cmd;
+    for (char c : command) {
+        if (c != ' ') cmd += c;
+    }
+
+    auto now = Clock::now();
+    std::string reply = echo ? command + "\r" : "";
+    int frames = 0;
+
+    if (cmd.rfind("AT", 0) == 0) {
+        if (cmd == "ATZ") {
+            echo = true;
+            reply += "\r\rELM327 v1.5";
+        } else {
+            if (cmd == "ATE0") echo = false;
+            if (cmd == "ATE1") echo = true;
+            reply += "OK";
+        }
+        replies.push_back({now, reply + "\r\r>"});
+        return;
+    }
+
+    if (cmd.rfind("01", 0) == 0 && cmd.size() > 2) {
+        reply += mode01Reply(cmd.substr(2), frames);
+    } else {
+        reply += "?";
+    }
+
+    // ECU turnaround, then the bus is busy for the reply frames
+    auto due = std::max(now + std::chrono::milliseconds(responseDelayMs), busFreeAt);
+    due += std::chrono::microseconds(frameTimeUs) * frames;
+    busFreeAt = due;
+    replies.push_back({due, reply + "\r\r>"});
+    requestsServed++;
+}
+
+std::string EcuSimulator::mode01Reply(const std::string& pids, int& frames) {
+    double seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    std::vector<uint8_t> bytes{0x41};
+
+    // Whatever comes over the link: anything but pairs of hex digits (and
+    // the ELM327's optional trailing response count digit) gets the
+    // negative response for a malformed request, incorrect message length
+    // or invalid format, rather than a throw on the worker thread
+    if (pids.size() % 2 != 0 && !std::isdigit(static_cast<unsigned char>(pids.back()))) {
+        frames = 1;
+        return "7F 01 13";
+    }
+
+    for (size_t i = 0; i + 1 < pids.size(); i += 2) {
+        char digits[3] = {pids[i], pids[i + 1], '\0'};
+        char* end = nullptr;
+        int pid = static_cast<int>(std::strtol(digits, &end, 16));
+        if (end != digits + 2 || !std::isxdigit(static_cast<unsigned char>(digits[0]))) {
+            frames = 1;
+            return "7F 01 13";
+        }
+        double value = valueFor(pid, seconds);
+
+        switch (pid) {
+            case 0x0C: { // rpm, (256A + B) / 4
+                int raw = static_cast<int>(value * 4.0);
+                bytes.insert(bytes.end(), {0x0C, static_cast<uint8_t>(raw >> 8), static_cast<uint8_t>(raw & 0xFF)});
+                break;
+            }
+            case 0x10: { // maf, (256A + B) / 100
+                int raw = static_cast<int>(value * 100.0);
+                bytes.insert(bytes.end(), {0x10, static_cast<uint8_t>(raw >> 8), static_cast<uint8_t>(raw & 0xFF)});
+                break;
+            }
+            case 0x05: case 0x0F: case 0x46: case 0x5C: // temperatures, A - 40
+                bytes.insert(bytes.end(), {static_cast<uint8_t>(pid), static_cast<uint8_t>(value + 40.0)});
+                break;
+            case 0x04: case 0x11: case 0x2F: // percentages, A * 100 / 255
+                bytes.insert(bytes.end(), {static_cast<uint8_t>(pid), static_cast<uint8_t>(value * 255.0 / 100.0)});
+                break;
+            case 0x0B: case 0x0D:
+                bytes.insert(bytes.end(), {static_cast<uint8_t>(pid), static_cast<uint8_t>(value)});
+                break;
+            default:
+                break; // unsupported PIDs are left out of the reply
+        }
+    }
+
+    if (bytes.size() == 1) {
+        frames = 1;
+        return "NO DATA";
+    }
+
+    char hex[4];
+    std::string text;
+
+    // Single CAN frame carries up to 7 bytes, longer replies are ISO-TP
+    // multi-frame and the ELM327 prints the length and frame indices
+    if (bytes.size() <= 7) {
+        frames = 1;
+        for (uint8_t b : bytes) {
+            std::snprintf(hex, sizeof(hex), "%02X ", b);
+            text += hex;
+        }
+        return text;
+    }
+
+    std::snprintf(hex, sizeof(hex), "%03X", static_cast<unsigned>(bytes.size()));
+    text = hex;
+    size_t offset = 0;
+    for (int frame = 0; offset < bytes.size(); ++frame) {
+        size_t count = frame == 0 ? 6 : 7;
+        std::snprintf(hex, sizeof(hex), "%X", frame & 0xF);
+        text += "\r";
+        text += hex;
+        text += ":";
+        for (size_t i = 0; i < count && offset < bytes.size(); ++i, ++offset) {
+            std::snprintf(hex, sizeof(hex), " %02X", bytes[offset]);
+            text += hex;
+        }
+        frames++;
+    }
+    return text;
+}
+
+double EcuSimulator::valueFor(int pid, double t) const {
+    switch (pid) {
+        case 0x04: return 40.0 + 30.0 * std::sin(2 * M_PI * 0.2 * t);   // engine load %
+        case 0x05: return 88.0 + 4.0 * std::sin(2 * M_PI * 0.01 * t);   // coolant C
+        case 0x0B: return 60.0 + 40.0 * std::sin(2 * M_PI * 0.2 * t);   // map kPa
+        case 0x0C: return 3000.0 + 2000.0 * std::sin(2 * M_PI * 0.2 * t); // rpm
+        case 0x0D: return 80.0 + 60.0 * std::sin(2 * M_PI * 0.05 * t);  // speed km/h
+        case 0x0F: return 30.0 + 5.0 * std::sin(2 * M_PI * 0.02 * t);   // intake air C
+        case 0x10: return 20.0 + 15.0 * std::sin(2 * M_PI * 0.2 * t);   // maf g/s
+        case 0x11: return 50.0 + 45.0 * std::sin(2 * M_PI * 0.3 * t);   // throttle %
+        case 0x2F: return 75.0;                                         // fuel level %
+        case 0x46: return 22.0;                                         // ambient C
+        case 0x5C: return 95.0 + 5.0 * std::sin(2 * M_PI * 0.01 * t);   // oil C
+        default: return 0.0;
+    }
+}
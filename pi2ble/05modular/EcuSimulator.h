@@ -0,0 +1,56 @@
+#ifndef ECU_SIMULATOR_H
+#define ECU_SIMULATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+
+// Simulated ECU behind an ELM327 adapter, served on a pseudo terminal.
+// Point ObdPoller at slavePath() (or a copy of it) instead of /dev/ttyUSB0.
+//
+// Requests are answered in order. Each reply is held back by responseDelayMs
+// (ECU turnaround) and replies can't be sent closer together than
+// frameTimeUs per CAN frame, so both packing and pipelining show up in the
+// achieved rates the same way they would on a car.
+class EcuSimulator {
+private:
+    struct PendingReply {
+        std::chrono::steady_clock::time_point due;
+        std::string text;
+    };
+
+    int masterFd = -1;
+    int slaveFd = -1;
+    std::string slaveName;
+    int responseDelayMs;
+    int frameTimeUs;
+    bool echo = true;
+    std::string lineBuffer;
+    std::deque<PendingReply> replies;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point busFreeAt;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> requestsServed{0};
+    std::thread worker;
+
+public:
+    EcuSimulator(int responseDelayMs = 15, int frameTimeUs = 500);
+    ~EcuSimulator();
+
+    const std::string& slavePath() const { return slaveName; }
+    uint64_t getRequestsServed() const { return requestsServed.load(); }
+
+    void start();
+    void stop();
+
+private:
+    void run();
+    void handleCommand(const std::string& command);
+    std::string mode01Reply(const std::string& pids, int& frames);
+    double valueFor(int pid, double seconds) const;
+};
+
+#endif // ECU_SIMULATOR_H
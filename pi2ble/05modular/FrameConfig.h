@@ -13,7 +13,6 @@ struct DatumDrawProps {
 
 struct TelemetryDrawConfig {
     std::map<std::string, DatumDrawProps> dataDrawProps;
-    TelemetryDrawConfig();
 };
 
 struct ImageConfig {
@@ -0,0 +1,25 @@
+#include "FramebufferOut.h"
+#include <algorithm>
+#include <stdexcept>
+
+FramebufferOut::FramebufferOut(const std::string& path) : device(new FramebufferDevice(path)) {
+    if (device->bitsPerPixel() != 16 && device->bitsPerPixel() != 32) {
+        throw std::runtime_error("Unsupported framebuffer depth " + std::to_string(device->bitsPerPixel()));
+    }
+    screenWidth = device->width();
+    screenHeight = device->height();
+    lineLength = device->stride();
+    layout = pixelLayout(device->variableInfo());
+    pixelData = device->pixels();
+}
+
+FramebufferOut::FramebufferOut(int width, int height, int bitsPerPixel)
+    : screenWidth(width), screenHeight(height), layout(bitsPerPixel == 16 ? rgb565Layout() : xrgb8888Layout()) {
+    lineLength = static_cast<size_t>(width) * layout.bitsPerPixel / 8;
+    memory.resize(lineLength * height);
+    pixelData = memory.data();
+}
+
+void FramebufferOut::pack(const cv::Mat& bgr, uint8_t* dst) const {
+    packBgr(bgr, std::min(bgr.cols, screenWidth), std::min(bgr.rows, screenHeight), dst, lineLength, layout);
+}
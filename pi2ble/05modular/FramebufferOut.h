@@ -0,0 +1,49 @@
+#ifndef FRAMEBUFFER_OUT_H
+#define FRAMEBUFFER_OUT_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "FramebufferDevice.h"
+#include "FramebufferPack.h"
+
+// The framebuffer writer: a mapped /dev/fbN (16 or 32 bpp, channels where
+// its bitfields say) that BGR frames are packed into, or the same in
+// memory for headless runs.
+// Frames are drawn at the top left of the visible area (the panned
+// xoffset/yoffset) and clipped to the screen.
+class FramebufferOut {
+private:
+    std::unique_ptr<FramebufferDevice> device;
+    uint8_t* pixelData = nullptr; // top left of the visible area
+    std::vector<uint8_t> memory;
+    int screenWidth = 0;
+    int screenHeight = 0;
+    size_t lineLength = 0;
+    PixelLayout layout{};
+
+public:
+    // Throws std::runtime_error if the device can't be opened or mapped
+    explicit FramebufferOut(const std::string& path);
+    // In memory, 32 bpp XRGB or 16 bpp RGB565
+    FramebufferOut(int width, int height, int bitsPerPixel);
+
+    FramebufferOut(const FramebufferOut&) = delete;
+    FramebufferOut& operator=(const FramebufferOut&) = delete;
+
+    int width() const { return screenWidth; }
+    int height() const { return screenHeight; }
+    int bitsPerPixel() const { return layout.bitsPerPixel; }
+    size_t stride() const { return lineLength; }
+    uint8_t* pixels() { return pixelData; }
+    size_t bytes() const { return lineLength * screenHeight; }
+
+    // Packs bgr into dst, laid out like this framebuffer
+    void pack(const cv::Mat& bgr, uint8_t* dst) const;
+    void show(const cv::Mat& bgr) { pack(bgr, pixelData); }
+};
+
+#endif // FRAMEBUFFER_OUT_H
@@ -0,0 +1,194 @@
+#include <sys/mman.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "LatencyHistogram.h"
+#include "Realtime.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+static const int INGEST_PERIOD_US = 5000; // a 200 Hz reactor
+
+struct JitterResult {
+    LatencyHistogram renderLateness; // wake-up after the frame deadline
+    LatencyHistogram renderWork;     // frame fill + copy
+    LatencyHistogram ingestLateness;
+    std::string renderApplied;
+    std::string ingestApplied;
+};
+
+// Competing load: threads that spin over and reallocate memory, unpinned
+// at normal priority, the way kernel daemons, logging and other processes
+// take the render loop's core on a Zero 2
+static void loadLoop(const std::atomic<bool>& running) {
+    std::vector<char> block;
+    size_t round = 0;
+    while (running) {
+        ++round;
+        block.assign(64 * 1024 + (round % 7) * 4096, static_cast<char>(round));
+        for (size_t i = 0; i < block.size(); i += 64) block[i] ^= 1;
+    }
+}
+
+static void runMode(bool realtimeMode, const AppConfig& appConfig, double seconds, int loadThreads,
+                    JitterResult& result) {
+    const RealtimeConfig& realtime = appConfig.realtime;
+    Realtime::Applied memory;
+    if (realtimeMode) memory = Realtime::lockMemory(realtime);
+
+    std::atomic<bool> running{true};
+    std::vector<std::thread> load;
+    for (int i = 0; i < loadThreads; ++i) load.emplace_back(loadLoop, std::cref(running));
+
+    std::vector<std::string> names;
+    for (const auto& entry : appConfig.telemetry) names.push_back(entry.first);
+    TelemetryStore store(names);
+
+    std::thread ingest([&] {
+        if (realtimeMode) {
+            Realtime::Applied applied =
+                Realtime::setupThread(realtime, "ingest", realtime.ingestCpu, realtime.ingestPriority);
+            applied.locked = memory.locked;
+            result.ingestApplied = Realtime::describe(applied, realtime.ingestCpu, realtime.ingestPriority);
+        }
+        auto next = Clock::now();
+        uint64_t tick = 0;
+        while (running) {
+            next += std::chrono::microseconds(INGEST_PERIOD_US);
+            std::this_thread::sleep_until(next);
+            auto now = Clock::now();
+            result.ingestLateness.record(now - next);
+            for (size_t id = 0; id < store.channelCount(); ++id) {
+                store.publish(static_cast<int>(id), std::sin(0.01 * tick + id), now);
+            }
+            ++tick;
+        }
+    });
+
+    // The render thread: a frame of work at video.framerate
+    std::thread render([&] {
+        int width = appConfig.video.width > 0 ? appConfig.video.width : 640;
+        int height = appConfig.video.height > 0 ? appConfig.video.height : 480;
+        std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 2);
+        std::vector<uint8_t> screen(frame.size());
+        std::vector<TelemetrySample> shown(store.channelCount());
+        if (realtimeMode) {
+            Realtime::Applied applied =
+                Realtime::setupThread(realtime, "render", realtime.renderCpu, realtime.renderPriority);
+            applied.locked = memory.locked;
+            Realtime::prefault(frame.data(), frame.size());
+            Realtime::prefault(screen.data(), screen.size());
+            result.renderApplied = Realtime::describe(applied, realtime.renderCpu, realtime.renderPriority);
+        }
+
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(1, appConfig.video.framerate)));
+        auto start = Clock::now();
+        auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        auto next = start;
+        uint8_t shade = 0;
+        while (next < end) {
+            next += period;
+            std::this_thread::sleep_until(next);
+            auto woke = Clock::now();
+            result.renderLateness.record(woke - next);
+
+            for (size_t id = 0; id < shown.size(); ++id) shown[id] = store.latest(static_cast<int>(id));
+            std::memset(frame.data(), shade++, frame.size());
+            std::memcpy(screen.data(), frame.data(), frame.size());
+            result.renderWork.record(Clock::now() - woke);
+        }
+    });
+
+    render.join();
+    running = false;
+    ingest.join();
+    for (std::thread& thread : load) thread.join();
+    if (memory.locked) munlockall();
+}
+
+static void printRow(const char* mode, const JitterResult& result) {
+    std::printf("%-9s %8llu %8llu %8llu %8llu %9llu %8llu %9llu %8llu\n", mode,
+                static_cast<unsigned long long>(result.renderLateness.percentile(50)),
+                static_cast<unsigned long long>(result.renderLateness.percentile(99)),
+                static_cast<unsigned long long>(result.renderLateness.percentile(99.9)),
+                static_cast<unsigned long long>(result.renderLateness.max()),
+                static_cast<unsigned long long>(result.renderWork.percentile(99)),
+                static_cast<unsigned long long>(result.renderWork.max()),
+                static_cast<unsigned long long>(result.ingestLateness.percentile(99)),
+                static_cast<unsigned long long>(result.ingestLateness.max()));
+}
+
+// Scheduling jitter of the render loop and the ingest thread, in normal
+// and realtime mode (realtime: in AppConfig.yaml, see Realtime.h), under
+// competing load. Render wakes at video.framerate and does a frame's
+// fill + copy; ingest wakes at 200 Hz and publishes to a TelemetryStore.
+// Lateness is how far past its deadline a thread woke, work is how long
+// the frame took once awake; all in microseconds.
+//
+// Realtime mode needs CAP_SYS_NICE and CAP_IPC_LOCK for all of it (run as
+// root or setcap); without them it reports what it couldn't apply and
+// runs anyway, which then measures the same as normal.
+//
+// Usage: ./JitterBench [seconds] [normal|realtime|both] [loadThreads]
+//   seconds per mode (default 10), loadThreads defaults to one per core
+int main(int argc, char* argv[]) {
+    double seconds = 10.0;
+    std::string mode = argc > 2 ? argv[2] : "both";
+    long loadThreads = static_cast<long>(std::thread::hardware_concurrency());
+    // strtod / strtol with nothing left over, anything else is a usage error
+    char* end = nullptr;
+    bool numbers = true;
+    if (argc > 1) {
+        seconds = std::strtod(argv[1], &end);
+        numbers = end != argv[1] && *end == '\0' && std::isfinite(seconds);
+    }
+    if (argc > 3) {
+        loadThreads = std::strtol(argv[3], &end, 10);
+        numbers = numbers && end != argv[3] && *end == '\0';
+    }
+    if (!numbers || seconds <= 0 || (mode != "normal" && mode != "realtime" && mode != "both") || loadThreads < 0 ||
+        loadThreads > 1024) {
+        std::cerr << "Usage: " << argv[0] << " [seconds] [normal|realtime|both] [loadThreads]" << std::endl;
+        return 1;
+    }
+
+    try {
+        AppConfig appConfig = loadAppConfig();
+        std::cout << seconds << " s per mode, render at " << appConfig.video.framerate << " FPS, ingest at "
+                  << 1000000 / INGEST_PERIOD_US << " Hz, " << loadThreads << " load threads on "
+                  << std::thread::hardware_concurrency() << " cores" << std::endl;
+
+        std::unique_ptr<JitterResult> normal, realtime;
+        if (mode != "realtime") {
+            normal.reset(new JitterResult);
+            runMode(false, appConfig, seconds, loadThreads, *normal);
+        }
+        if (mode != "normal") {
+            realtime.reset(new JitterResult);
+            runMode(true, appConfig, seconds, loadThreads, *realtime);
+            std::cout << "Realtime render: " << realtime->renderApplied << "; ingest: " << realtime->ingestApplied
+                      << std::endl;
+        }
+
+        std::printf("%-9s %8s %8s %8s %8s %9s %8s %9s %8s\n", "mode", "late p50", "p99", "p99.9", "max",
+                    "work p99", "max", "ing. p99", "max");
+        if (normal) printRow("normal", *normal);
+        if (realtime) printRow("realtime", *realtime);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
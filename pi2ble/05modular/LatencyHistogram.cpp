@@ -0,0 +1,69 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint64_t us) {
+    counts[logBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = maxUs.load(std::memory_order_relaxed);
+    while (us > seen && !maxUs.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration d) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    record(us > 0 ? static_cast<uint64_t>(us) : 0);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    maxUs.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    return std::min(logBucketPercentile(counts, count(), p), max());
+}
+
+DisplayLatency::DisplayLatency(const TelemetryStore& store)
+    : histograms(new LatencyHistogram[store.channelCount()]) {
+    for (size_t id = 0; id < store.channelCount(); ++id) {
+        names.push_back(store.channelName(static_cast<int>(id)));
+    }
+}
+
+void DisplayLatency::record(int id, std::chrono::steady_clock::time_point ingress,
+                            std::chrono::steady_clock::time_point displayed) {
+    histograms[id].record(displayed - ingress);
+}
+
+void DisplayLatency::reset() {
+    for (size_t id = 0; id < names.size(); ++id) histograms[id].reset();
+}
+
+std::string DisplayLatency::debugText(int id) const {
+    const LatencyHistogram& h = histograms[id];
+    std::ostringstream text;
+    text << names[id] << " age " << h.percentile(50) / 1000 << "/" << h.percentile(99) / 1000 << "ms";
+    return text.str();
+}
+
+void DisplayLatency::printStats(std::ostream& out) const {
+    out << std::fixed << std::setprecision(1);
+    out << "=== Age at display (ms) ===" << std::endl;
+    for (size_t id = 0; id < names.size(); ++id) {
+        const LatencyHistogram& h = histograms[id];
+        if (h.count() == 0) continue;
+        out << "  " << std::left << std::setw(12) << names[id] << std::right
+            << " p50 " << std::setw(7) << h.percentile(50) / 1000.0
+            << "  p99 " << std::setw(7) << h.percentile(99) / 1000.0
+            << "  max " << std::setw(7) << h.max() / 1000.0
+            << "  (" << h.count() << " frames)" << std::endl;
+    }
+}
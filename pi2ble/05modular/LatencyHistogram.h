@@ -0,0 +1,59 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LogHistogram.h"
+#include "TelemetryStore.h"
+
+// Histogram of durations in microseconds, in the log-linear buckets of
+// common/LogHistogram.h. record() is wait-free and safe from any thread;
+// readers get a snapshot that may be a few samples behind.
+class LatencyHistogram {
+private:
+    std::atomic<uint64_t> counts[LOG_HISTOGRAM_BUCKETS];
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> maxUs{0};
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t us);
+    void record(std::chrono::steady_clock::duration d);
+    void reset();
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return maxUs.load(std::memory_order_relaxed); }
+    // Upper bound of the bucket holding the p-th percentile (0..100)
+    uint64_t percentile(double p) const;
+};
+
+// Age-at-display per telemetry channel: how old the value shown on screen
+// was (ingress timestamp -> frame hitting the framebuffer). Stale values
+// count once per frame they stay on screen, since that is what the driver
+// sees.
+class DisplayLatency {
+private:
+    std::vector<std::string> names;
+    std::unique_ptr<LatencyHistogram[]> histograms;
+
+public:
+    explicit DisplayLatency(const TelemetryStore& store);
+
+    size_t channelCount() const { return names.size(); }
+    void record(int id, std::chrono::steady_clock::time_point ingress,
+                std::chrono::steady_clock::time_point displayed);
+    const LatencyHistogram& histogram(int id) const { return histograms[id]; }
+    void reset();
+
+    // Short on-screen debug field, e.g. "rpm age 18/42ms"
+    std::string debugText(int id) const;
+    void printStats(std::ostream& out) const;
+};
+
+#endif // LATENCY_HISTOGRAM_H
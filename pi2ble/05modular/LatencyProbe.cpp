@@ -0,0 +1,167 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "EcuSimulator.h"
+#include "FramebufferDevice.h"
+#include "LatencyHistogram.h"
+#include "ObdPoller.h"
+#include "Realtime.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+// The framebuffer device given with --fb, otherwise a heap buffer of the
+// same size so the blit still costs what it would on the device
+struct BlitTarget {
+    std::unique_ptr<FramebufferDevice> framebuffer;
+    uint8_t* pixels = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> fallback;
+
+    BlitTarget(const std::string& device, size_t frameBytes) {
+        if (device == "none") {
+            fallback.resize(frameBytes);
+            pixels = fallback.data();
+            size = frameBytes;
+            return;
+        }
+        framebuffer.reset(new FramebufferDevice(device));
+        pixels = framebuffer->memory();
+        size = framebuffer->bytes();
+    }
+    bool isDevice() const { return framebuffer != nullptr; }
+    void blit(const std::vector<uint8_t>& frame) {
+        std::memcpy(pixels, frame.data(), std::min(size, frame.size()));
+    }
+};
+
+// Measures sensor-to-pixel latency: OBD ingest against the simulated ECU on
+// one thread, a render loop at video.framerate on the other. Every frame
+// snapshots the store, "draws" and blits, then records how old each shown
+// value was once the blit finished. With realtime.enabled in AppConfig.yaml
+// both threads run in realtime mode (see Realtime.h).
+//
+// Usage: ./LatencyProbe [seconds] [responseDelayMs] [--fb /dev/fb0|none]
+//   blits into a buffer in memory unless --fb names a framebuffer device
+int main(int argc, char* argv[]) {
+    std::string device = "none";
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fb" && i + 1 < argc) {
+            device = argv[++i];
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    try {
+        AppConfig appConfig = loadAppConfig();
+        int seconds = positional.size() > 0 ? std::stoi(positional[0]) : 5;
+        int responseDelayMs = positional.size() > 1 ? std::stoi(positional[1]) : 15;
+
+        std::vector<uint8_t> frame(static_cast<size_t>(appConfig.video.width) * appConfig.video.height * 2);
+        BlitTarget target(device, frame.size());
+
+        EcuSimulator ecu(responseDelayMs);
+        ecu.start();
+        int fd = ::open(ecu.slavePath().c_str(), O_RDWR | O_NOCTTY);
+        if (fd < 0) {
+            std::cerr << "Could not open " << ecu.slavePath() << std::endl;
+            return 1;
+        }
+
+        const RealtimeConfig& realtime = appConfig.realtime;
+        Realtime::Applied memory;
+        if (realtime.enabled) memory = Realtime::lockMemory(realtime);
+
+        TelemetryStore store(appConfig);
+        ObdPoller poller(appConfig, store);
+        poller.attach(fd);
+        poller.initAdapter();
+
+        std::atomic<bool> running{true};
+        std::thread ingest([&] {
+            if (realtime.enabled) {
+                Realtime::Applied applied =
+                    Realtime::setupThread(realtime, "ingest", realtime.ingestCpu, realtime.ingestPriority);
+                applied.locked = memory.locked;
+                std::cout << "Ingest realtime: " << Realtime::describe(applied, realtime.ingestCpu,
+                                                                       realtime.ingestPriority)
+                          << std::endl;
+            }
+            while (running) poller.poll(50);
+        });
+
+        DisplayLatency latency(store);
+        std::vector<TelemetrySample> shown(store.channelCount());
+        if (realtime.enabled) {
+            Realtime::Applied applied =
+                Realtime::setupThread(realtime, "render", realtime.renderCpu, realtime.renderPriority);
+            applied.locked = memory.locked;
+            Realtime::prefault(target.pixels, target.size);
+            std::cout << "Render realtime: "
+                      << Realtime::describe(applied, realtime.renderCpu, realtime.renderPriority) << std::endl;
+        }
+
+        std::cout << "Rendering " << appConfig.video.width << "x" << appConfig.video.height << " at "
+                  << appConfig.video.framerate << " FPS to "
+                  << (target.isDevice() ? device : "a memory buffer") << std::endl;
+
+        auto start = Clock::now();
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(1, appConfig.video.framerate)));
+        auto next = start;
+        auto lastDebug = start;
+        int frames = 0;
+
+        while (next < start + std::chrono::seconds(seconds)) {
+            std::this_thread::sleep_until(next);
+            next += period;
+
+            for (size_t id = 0; id < shown.size(); ++id) {
+                shown[id] = store.latest(static_cast<int>(id));
+            }
+            std::fill(frame.begin(), frame.end(), static_cast<uint8_t>(frames));
+            target.blit(frame);
+
+            auto displayed = Clock::now();
+            for (size_t id = 0; id < shown.size(); ++id) {
+                if (shown[id].updates > 0) latency.record(static_cast<int>(id), shown[id].timestamp, displayed);
+            }
+            frames++;
+
+            if (appConfig.video.showLatency && displayed - lastDebug >= std::chrono::seconds(1)) {
+                for (size_t id = 0; id < shown.size(); ++id) {
+                    if (latency.histogram(static_cast<int>(id)).count() == 0) continue;
+                    std::cout << latency.debugText(static_cast<int>(id)) << "  ";
+                }
+                std::cout << std::endl;
+                lastDebug = displayed;
+            }
+        }
+
+        running = false;
+        ingest.join();
+        ecu.stop();
+        ::close(fd);
+
+        std::cout << frames << " frames" << std::endl;
+        latency.printStats(std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
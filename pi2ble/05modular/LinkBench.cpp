@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "TelemetryLink.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct LinkStats {
+    uint64_t frames = 0;
+    uint64_t keyframes = 0;
+    uint64_t bytes = 0;
+    uint64_t keyframeBytes = 0;
+    Clock::duration encodeTime{};
+};
+
+// Synthetic channels: slow sines of different periods and magnitudes,
+// like a mix of rpm, temperatures and pressures
+static void updateChannels(TelemetryStore& store, double seconds, Clock::time_point now) {
+    for (size_t id = 0; id < store.channelCount(); ++id) {
+        double magnitude = 10.0 * static_cast<double>(1 + id % 5) * static_cast<double>(1 + id % 7);
+        double value = magnitude + magnitude * std::sin(2 * M_PI * (0.05 + 0.01 * static_cast<double>(id % 13)) * seconds);
+        store.publish(static_cast<int>(id), value, now);
+    }
+}
+
+static void runSender(const LinkConfig& config, TelemetryStore& store, int seconds, int rateHz,
+                      LinkStats& stats) {
+    UdpLinkSender sender(config.host, config.port);
+    LinkEncoder encoder(config, store.channelCount());
+    uint8_t frame[LINK_MAX_FRAME_SIZE];
+
+    auto start = Clock::now();
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    auto next = start;
+    auto end = start + std::chrono::seconds(seconds);
+
+    while (next < end) {
+        std::this_thread::sleep_until(next);
+        auto now = Clock::now();
+        updateChannels(store, std::chrono::duration<double>(now - start).count(), now);
+
+        auto before = Clock::now();
+        size_t length = encoder.encode(store, frame, sizeof(frame));
+        stats.encodeTime += Clock::now() - before;
+
+        sender.send(frame, length);
+        stats.frames++;
+        stats.bytes += length;
+        if (frame[1] & LINK_FLAG_KEYFRAME) {
+            stats.keyframes++;
+            stats.keyframeBytes += length;
+        }
+        next += period;
+    }
+}
+
+static void printSenderStats(const LinkStats& stats, size_t channels, int seconds, int rateHz) {
+    uint64_t deltaFrames = stats.frames - stats.keyframes;
+    double rawBytesPerSecond = static_cast<double>(channels) * 8.0 * rateHz;
+    double bytesPerSecond = static_cast<double>(stats.bytes) / seconds;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=== Sender ===" << std::endl;
+    std::cout << "frames: " << stats.frames << " (" << stats.keyframes << " keyframes)" << std::endl;
+    std::cout << "avg keyframe: " << (stats.keyframes ? stats.keyframeBytes / static_cast<double>(stats.keyframes) : 0.0)
+              << " B, avg delta frame: "
+              << (deltaFrames ? (stats.bytes - stats.keyframeBytes) / static_cast<double>(deltaFrames) : 0.0)
+              << " B" << std::endl;
+    std::cout << "bandwidth: " << bytesPerSecond / 1024.0 << " KiB/s (raw doubles: "
+              << rawBytesPerSecond / 1024.0 << " KiB/s, " << std::setprecision(2)
+              << bytesPerSecond / rawBytesPerSecond * 100.0 << "%)" << std::endl;
+    std::cout << std::setprecision(0) << "encode: "
+              << std::chrono::duration<double, std::nano>(stats.encodeTime).count() / std::max<uint64_t>(1, stats.frames)
+              << " ns/frame" << std::endl;
+}
+
+static void runReceiver(const LinkConfig& config, TelemetryStore& store, int seconds,
+                        std::atomic<bool>& ready, bool measureLatency) {
+    UdpLinkReceiver receiver(config.port);
+    LinkDecoder decoder(config, store.channelCount());
+    uint8_t frame[LINK_MAX_FRAME_SIZE];
+    std::vector<uint32_t> latencyUs;
+    latencyUs.reserve(static_cast<size_t>(seconds) * 2000);
+    Clock::duration decodeTime{};
+    ready = true;
+
+    auto end = Clock::now() + std::chrono::seconds(seconds) + std::chrono::milliseconds(500);
+    while (Clock::now() < end) {
+        size_t length = receiver.receive(frame, sizeof(frame), 100);
+        if (length == 0) continue;
+
+        auto received = Clock::now();
+        bool ok = decoder.decode(frame, length, store, received);
+        decodeTime += Clock::now() - received;
+        if (ok && measureLatency && latencyUs.size() < latencyUs.capacity()) {
+            latencyUs.push_back(static_cast<uint32_t>(linkTimestampUs(received) - decoder.lastTimestampUs));
+        }
+    }
+
+    std::cout << "=== Receiver ===" << std::endl;
+    std::cout << "frames ok: " << decoder.framesOk << ", lost: " << decoder.framesLost
+              << ", corrupt: " << decoder.framesCorrupt << ", skipped until keyframe: " << decoder.framesSkipped
+              << std::endl;
+    std::cout << "decode: "
+              << std::chrono::duration<double, std::nano>(decodeTime).count() / std::max<uint64_t>(1, decoder.framesOk)
+              << " ns/frame" << std::endl;
+
+    if (!latencyUs.empty()) {
+        std::sort(latencyUs.begin(), latencyUs.end());
+        std::cout << "latency (encode -> decoded): p50 " << latencyUs[latencyUs.size() / 2]
+                  << " us, p99 " << latencyUs[latencyUs.size() * 99 / 100]
+                  << " us, max " << latencyUs.back() << " us" << std::endl;
+    }
+}
+
+// Pi 5 -> Pi Zero 2 link benchmark.
+//
+// Usage: ./LinkBench [seconds] [channels] [rateHz]   sender and receiver over loopback UDP
+//        ./LinkBench send [seconds] [rateHz]         AppConfig channels to link.host:link.port
+//        ./LinkBench recv [seconds]                  receive on link.port
+int main(int argc, char* argv[]) {
+    try {
+        AppConfig appConfig = loadAppConfig();
+        std::string mode = argc > 1 ? argv[1] : "";
+
+        if (mode == "send") {
+            int seconds = argc > 2 ? std::stoi(argv[2]) : 10;
+            int rateHz = argc > 3 ? std::stoi(argv[3]) : 100;
+            TelemetryStore store(appConfig);
+            LinkStats stats;
+            runSender(appConfig.link, store, seconds, rateHz, stats);
+            printSenderStats(stats, store.channelCount(), seconds, rateHz);
+            return 0;
+        }
+        if (mode == "recv") {
+            int seconds = argc > 2 ? std::stoi(argv[2]) : 10;
+            TelemetryStore store(appConfig);
+            std::atomic<bool> ready{false};
+            runReceiver(appConfig.link, store, seconds, ready, false);
+            return 0;
+        }
+
+        int seconds = argc > 1 ? std::stoi(argv[1]) : 5;
+        int channels = argc > 2 ? std::stoi(argv[2]) : 100;
+        int rateHz = argc > 3 ? std::stoi(argv[3]) : 100;
+
+        LinkConfig config = appConfig.link;
+        config.host = "127.0.0.1";
+
+        std::vector<std::string> names;
+        for (int i = 0; i < channels; ++i) names.push_back("ch" + std::to_string(i));
+        TelemetryStore senderStore(names);
+        TelemetryStore receiverStore(names);
+
+        std::cout << "Loopback link: " << channels << " channels x " << rateHz << " Hz for "
+                  << seconds << " s, resolution " << config.resolution << std::endl;
+
+        std::atomic<bool> ready{false};
+        std::thread receiver(runReceiver, std::cref(config), std::ref(receiverStore), seconds,
+                             std::ref(ready), true);
+        while (!ready) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        LinkStats stats;
+        runSender(config, senderStore, seconds, rateHz, stats);
+        receiver.join();
+        printSenderStats(stats, names.size(), seconds, rateHz);
+
+        // Both ends should agree to within the quantization step
+        double worst = 0.0;
+        for (int id = 0; id < channels; ++id) {
+            worst = std::max(worst, std::abs(senderStore.latest(id).value - receiverStore.latest(id).value));
+        }
+        std::cout << std::setprecision(4) << "max end-to-end value error: " << worst << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
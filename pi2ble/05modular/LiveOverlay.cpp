@@ -0,0 +1,228 @@
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConfigCache.h"
+#include "ConfigWatcher.h"
+#include "FramebufferOut.h"
+#include "LatencyHistogram.h"
+#include "OverlayDraw.h"
+#include "RcuPointer.h"
+#include "Realtime.h"
+#include "TelemetryStore.h"
+#include "Trace.h"
+
+using Clock = std::chrono::steady_clock;
+
+// One version of the overlay layout: built on the watcher thread, drawn by
+// the render thread, never changed once published
+struct OverlayLayout {
+    std::vector<OverlayItem> items;
+    cv::Mat staticLayer;
+    bool showLatency; // video.showLatency: age-at-display field, bottom left
+};
+
+// Throws std::runtime_error on an item the screen can't show, which
+// rejects the config
+static std::unique_ptr<OverlayLayout> buildLayout(const CompiledConfig& config, const TelemetryStore& store, int width,
+                                                  int height) {
+    std::unique_ptr<OverlayLayout> layout(new OverlayLayout);
+    layout->items = overlayItems(config, store);
+    for (const OverlayItem& item : layout->items) {
+        if (item.position.x < 0 || item.position.x >= width || item.position.y < 0 || item.position.y >= height) {
+            throw std::runtime_error(item.name + " is at (" + std::to_string(item.position.x) + ", " +
+                                     std::to_string(item.position.y) + "), outside the " + std::to_string(width) +
+                                     "x" + std::to_string(height) + " screen");
+        }
+    }
+    layout->staticLayer.create(height, width, CV_8UC3);
+    layout->staticLayer.setTo(cv::Scalar(20, 20, 20));
+    drawOverlayLabels(layout->staticLayer, layout->items);
+    layout->showLatency = config.header().videoShowLatency != 0;
+    return layout;
+}
+
+// The telemetry overlay running on the framebuffer with AppConfig.yaml
+// hot reloaded: edit and save it and the new layout shows on the next
+// frame, without a restart or a blank screen.
+//
+// ConfigWatcher (inotify) compiles each saved version and builds its
+// layout, static layer included, on the watcher thread; the render thread
+// only picks up the current pointer from an RcuPointer each frame, with
+// no lock, and the old layout is freed once the render thread has
+// finished the frame that used it. A config that doesn't parse or puts
+// an item off screen is rejected and the running layout stays.
+//
+// The channel set is fixed at start: moved, restyled and removed entries
+// reload, an added channel shows "--" until a restart starts its ingress.
+// Values here are synthetic (one sine per channel at 50 Hz).
+//
+// Every frame records how old each value it showed was once it reached
+// the framebuffer (DisplayLatency); video.showLatency draws p50/p99 per
+// channel bottom left, refreshed once a second.
+//
+// Ingest, render, text and blit are traced with TRACE_SCOPE (cmake
+// -DTRACE=ON, written to LiveOverlay.trace.json).
+//
+// Usage: ./LiveOverlay [--fb /dev/fb0|none] [--config AppConfig.yaml] [--seconds 60]
+//   --fb none draws into a 640x480 framebuffer in memory
+//   prints reloads, rejections, frame times and age at display (p50/p99/max)
+//   at the end
+int main(int argc, char* argv[]) {
+    std::string device = "/dev/fb0";
+    std::string configPath = "AppConfig.yaml";
+    double seconds = 60.0;
+    bool usage = false;
+    for (int i = 1; i < argc && !usage; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fb" && i + 1 < argc) {
+            device = argv[++i];
+        } else if (arg == "--config" && i + 1 < argc) {
+            configPath = argv[++i];
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            char* end = nullptr;
+            seconds = std::strtod(argv[++i], &end);
+            usage = end == argv[i] || *end != '\0' || !std::isfinite(seconds) || seconds <= 0;
+        } else {
+            usage = true;
+        }
+    }
+    if (usage) {
+        std::cerr << "Usage: " << argv[0] << " [--fb /dev/fb0|none] [--config AppConfig.yaml] [--seconds 60]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        std::unique_ptr<FramebufferOut> fb;
+        if (device == "none") {
+            fb.reset(new FramebufferOut(640, 480, 32));
+        } else {
+            fb.reset(new FramebufferOut(device));
+        }
+        const int width = fb->width();
+        const int height = fb->height();
+
+        std::unique_ptr<CompiledConfig> initial = openConfigCache(configPath);
+        int framerate = initial->header().videoFramerate > 0 ? initial->header().videoFramerate : 30;
+        // realtime: is read at start only, a reload doesn't re-pin the threads
+        const RealtimeConfig realtime = initial->toAppConfig().realtime;
+        Realtime::Applied memory;
+        if (realtime.enabled) memory = Realtime::lockMemory(realtime);
+        TelemetryStore store(initial->channelNames());
+        RcuPointer<OverlayLayout> layout(buildLayout(*initial, store, width, height));
+
+        ConfigWatcher watcher(configPath, *initial, [&](std::unique_ptr<CompiledConfig> compiled) {
+            layout.publish(buildLayout(*compiled, store, width, height));
+            std::cout << "Reloaded " << configPath << ", layout version " << layout.version() << std::endl;
+        });
+
+        std::atomic<bool> running{true};
+        TRACE_START("LiveOverlay.trace.json");
+        std::thread ingress([&] {
+            if (realtime.enabled) {
+                Realtime::Applied applied =
+                    Realtime::setupThread(realtime, "ingest", realtime.ingestCpu, realtime.ingestPriority);
+                applied.locked = memory.locked;
+                std::cout << "Ingest realtime: "
+                          << Realtime::describe(applied, realtime.ingestCpu, realtime.ingestPriority) << std::endl;
+            }
+            TRACE_THREAD_NAME("ingest");
+            while (running) {
+                {
+                    TRACE_SCOPE("ingest");
+                    double t = std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+                    for (size_t id = 0; id < store.channelCount(); ++id) {
+                        store.publish(static_cast<int>(id), 50.0 + 50.0 * std::sin(t + id), Clock::now());
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        });
+
+        std::cout << "Overlay on " << device << " at " << framerate << " fps, watching " << configPath << std::endl;
+        LatencyHistogram frameTimes;
+        DisplayLatency latency(store);
+        std::vector<TelemetrySample> shown(store.channelCount());
+        std::vector<std::string> latencyText;
+        auto lastLatencyText = Clock::now();
+        cv::Mat frame(height, width, CV_8UC3);
+        RcuPointer<OverlayLayout>::Reader reader(layout);
+        if (realtime.enabled) {
+            Realtime::Applied applied =
+                Realtime::setupThread(realtime, "render", realtime.renderCpu, realtime.renderPriority);
+            applied.locked = memory.locked;
+            Realtime::prefault(frame.data, frame.total() * frame.elemSize());
+            Realtime::prefault(fb->pixels(), fb->bytes());
+            std::cout << "Render realtime: " << Realtime::describe(applied, realtime.renderCpu, realtime.renderPriority)
+                      << std::endl;
+        }
+        TRACE_THREAD_NAME("render");
+        const auto framePeriod = std::chrono::microseconds(1000000 / framerate);
+        const auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        auto nextFrame = Clock::now();
+        while (Clock::now() < end) {
+            auto start = Clock::now();
+            const OverlayLayout* current = reader.get();
+            {
+                TRACE_SCOPE("render");
+                current->staticLayer.copyTo(frame);
+                TRACE_SCOPE("text");
+                std::fill(shown.begin(), shown.end(), TelemetrySample());
+                drawOverlayValues(frame, current->items, store, shown.data());
+                if (current->showLatency) {
+                    for (size_t line = 0; line < latencyText.size(); ++line) {
+                        int y = height - 10 - 22 * static_cast<int>(latencyText.size() - 1 - line);
+                        cv::putText(frame, latencyText[line], cv::Point(10, y), cv::FONT_HERSHEY_SIMPLEX, 0.5,
+                                    cv::Scalar(0, 255, 255), 1);
+                    }
+                }
+            }
+            {
+                // No flip: the framebuffer is scanned out as written
+                TRACE_SCOPE("blit");
+                fb->show(frame);
+            }
+            reader.quiescent();
+
+            auto displayed = Clock::now();
+            frameTimes.record(displayed - start);
+            for (size_t id = 0; id < shown.size(); ++id) {
+                if (shown[id].updates > 0) latency.record(static_cast<int>(id), shown[id].timestamp, displayed);
+            }
+            if (displayed - lastLatencyText >= std::chrono::seconds(1)) {
+                latencyText.clear();
+                for (size_t id = 0; id < latency.channelCount(); ++id) {
+                    if (latency.histogram(static_cast<int>(id)).count() > 0) {
+                        latencyText.push_back(latency.debugText(static_cast<int>(id)));
+                    }
+                }
+                lastLatencyText = displayed;
+            }
+
+            nextFrame += framePeriod;
+            std::this_thread::sleep_until(nextFrame);
+        }
+
+        running = false;
+        ingress.join();
+        TRACE_STOP();
+        std::cout << frameTimes.count() << " frames, " << watcher.reloads << " reloads, " << watcher.rejected
+                  << " rejected; frame time p50 " << frameTimes.percentile(50) << " us, p99 "
+                  << frameTimes.percentile(99) << " us, max " << frameTimes.max() << " us" << std::endl;
+        latency.printStats(std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,13 +1,27 @@
 #include "MockDataCVFrameOut.cpp"
+#include <fstream>
 #include <iostream>
+#include "ConfigCache.h"
 
 
 
-int main(int, char* []) {
+// Mock data drawn into 04MultiData's Frame window until q or Esc.
+// Only realtime: is read from the config so far; without the file it
+// runs with realtime mode off.
+//
+// Usage: ./Main [AppConfig.yaml]
+int main(int argc, char* argv[]) {
     std::cout << "Hello, World!" << std::endl;
 
     try {
-        MockDataCVFrameOut app;
+        std::string configPath = argc > 1 ? argv[1] : "AppConfig.yaml";
+        RealtimeConfig realtime;
+        if (std::ifstream(configPath)) {
+            realtime = loadAppConfigCached(configPath).realtime;
+        } else {
+            std::cout << configPath << " not found, realtime mode off" << std::endl;
+        }
+        MockDataCVFrameOut app(realtime);
         app.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
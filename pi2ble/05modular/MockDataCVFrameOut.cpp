@@ -1,30 +1,10 @@
 #include <chrono>
 #include <iostream>
+#include "AsyncLog.h"
+#include "Frame.h"
 #include "FrameConfig.h"
-
-struct VideoConfig {
-    int width = 320;
-    int height = 240;
-    int frameRate = 12;
-};
-
-class Frame {
-private:
-    std::string windowName = "Please set the window name";
-    int windowWidth = 320;
-    int windowHeight = 240;
-    std::string count;
-    std::string velocity = "0";
-public:
-    Frame(const std::string& winName, int width, int height);
-    void addDataPoint(const std::string& data);
-    void setVelocity(const std::string& velocity);
-    void render();
-    char waitKey(int ms);
-private:
-    void drawData();
-
-};
+#include "Realtime.h"
+#include "Trace.h"
 
 
 
@@ -34,9 +14,14 @@ class MockDataCVFrameOut {
         VideoConfig videoConfig;
         ImageConfig imageConfig;
         TelemetryDrawConfig telemetryDrawConfig;
+        RealtimeConfig realtime;
+        Realtime::Applied memory;
     public:
-        MockDataCVFrameOut() : running(true) {
-            videoConfig.frameRate = 6;
+        // realtime.enabled locks memory here and sets up the render thread in run()
+        explicit MockDataCVFrameOut(const RealtimeConfig& realtimeConfig = RealtimeConfig())
+            : running(true), realtime(realtimeConfig) {
+            if (realtime.enabled) memory = Realtime::lockMemory(realtime);
+            videoConfig.framerate = 6;
             videoConfig.width = imageConfig.width;
             videoConfig.height = imageConfig.height;
             telemetryDrawConfig.dataDrawProps = {
@@ -47,34 +32,57 @@ class MockDataCVFrameOut {
             auto& velocityProps = telemetryDrawConfig.dataDrawProps["velocity"];
             // Example: print the label of the velocity property
             std::cout << "Velocity label: " << velocityProps.displayVal << std::endl;
-            // videoConfig.frameRate = 1;
+            // videoConfig.framerate = 1;
             // videoConfig.width = 120;
             // videoConfig.height = 60;
         }
         void run() {
+            Realtime::Applied applied;
+            if (realtime.enabled) {
+                applied = Realtime::setupThread(realtime, "render", realtime.renderCpu, realtime.renderPriority);
+                applied.locked = memory.locked;
+            }
             Frame frame("Sample Frame", videoConfig.width, videoConfig.height);
             int count = 0;
             int frameCount = 0;
-            int msBetweenFrames = videoConfig.frameRate > 0 ? 1000 / videoConfig.frameRate : 0;
+            int msBetweenFrames = videoConfig.framerate > 0 ? 1000 / videoConfig.framerate : 0;
 
-            std::cout << "Frame rate: " << videoConfig.frameRate << " FPS" << std::endl;
-            std::cout << "Milliseconds between frames: " << msBetweenFrames << " ms" << std::endl;
+            // This thread's log ring is allocated here, not in the first frame
+            AsyncLog::attachThread();
+            LOG_INFO("Frame rate: {} FPS", videoConfig.framerate);
+            LOG_INFO("Milliseconds between frames: {} ms", msBetweenFrames);
+            if (realtime.enabled) {
+                LOG_INFO("Render realtime: {}", Realtime::describe(applied, realtime.renderCpu, realtime.renderPriority));
+            }
 
             auto lastFrame = std::chrono::steady_clock::now();
-
+            TRACE_START("Main.trace.json");
+            TRACE_THREAD_NAME("render");
 
             while(running) {
                 auto now = std::chrono::steady_clock::now();
                 auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastFrame);
 
                 if (count == 0 || elapsed.count() >= msBetweenFrames) {
-                    frame.addDataPoint("Data Point " + std::to_string(frameCount) + "_" + std::to_string(count));
-                    frame.render();
+                    {
+                        TRACE_SCOPE("ingest");
+                        frame.addDataPoint("Data Point " + std::to_string(frameCount) + "_" + std::to_string(count));
+                    }
+                    {
+                        // Frame::render draws and shows, so this is render + blit
+                        TRACE_SCOPE("render");
+                        frame.render();
+                    }
 
-                    std::cout << "frameCount: " + std::to_string(frameCount) << std::endl;
-                    std::cout << "count: " + std::to_string(count) << std::endl;
+                    LOG_DEBUG("frameCount: {}", frameCount);
+                    LOG_DEBUG("count: {}", count);
+                    LOG_EVERY_MS(LOG_LEVEL_INFO, 1000, "frameCount: {} count: {}", frameCount, count);
     
-                    char charRead = frame.waitKey(1);
+                    char charRead;
+                    {
+                        TRACE_SCOPE("flip");
+                        charRead = frame.waitKey(1);
+                    }
                     if(charRead == 'q' || charRead == 27) {
                         running = false;
                     }
@@ -85,7 +93,8 @@ class MockDataCVFrameOut {
                 count++;
             }
 
-            std::cout << "App finished" << std::endl;
+            TRACE_STOP();
+            LOG_INFO("App finished");
             return;
         }
 };
@@ -0,0 +1,423 @@
+#include "ObdPoller.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <termios.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+// Mode 01 PIDs we know how to decode (SAE J1979)
+static const ObdPidInfo OBD_PIDS[] = {
+    {0x04, 1, "engine load",  [](const uint8_t* d) { return d[0] * 100.0 / 255.0; }},
+    {0x05, 1, "coolant temp", [](const uint8_t* d) { return d[0] - 40.0; }},
+    {0x0B, 1, "intake map",   [](const uint8_t* d) { return static_cast<double>(d[0]); }},
+    {0x0C, 2, "engine rpm",   [](const uint8_t* d) { return (d[0] * 256 + d[1]) / 4.0; }},
+    {0x0D, 1, "speed",        [](const uint8_t* d) { return static_cast<double>(d[0]); }},
+    {0x0F, 1, "intake temp",  [](const uint8_t* d) { return d[0] - 40.0; }},
+    {0x10, 2, "maf",          [](const uint8_t* d) { return (d[0] * 256 + d[1]) / 100.0; }},
+    {0x11, 1, "throttle",     [](const uint8_t* d) { return d[0] * 100.0 / 255.0; }},
+    {0x2F, 1, "fuel level",   [](const uint8_t* d) { return d[0] * 100.0 / 255.0; }},
+    {0x46, 1, "ambient temp", [](const uint8_t* d) { return d[0] - 40.0; }},
+    {0x5C, 1, "oil temp",     [](const uint8_t* d) { return d[0] - 40.0; }},
+};
+
+const ObdPidInfo* findObdPid(int pid) {
+    for (const auto& info : OBD_PIDS) {
+        if (info.pid == pid) return &info;
+    }
+    return nullptr;
+}
+
+double ObdPidState::achievedHz() const {
+    if (updates < 2) return 0.0;
+    double seconds = std::chrono::duration<double>(lastUpdate - firstUpdate).count();
+    return seconds > 0.0 ? (updates - 1) / seconds : 0.0;
+}
+
+static ObdTier tierForRate(double hz) {
+    if (hz >= 10.0) return ObdTier::Fast;
+    if (hz >= 2.0) return ObdTier::Medium;
+    return ObdTier::Slow;
+}
+
+static const char* tierName(ObdTier tier) {
+    switch (tier) {
+        case ObdTier::Fast: return "fast";
+        case ObdTier::Medium: return "medium";
+        default: return "slow";
+    }
+}
+
+static speed_t baudToSpeed(int baud) {
+    switch (baud) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        default: throw std::runtime_error("Unsupported OBD baud rate: " + std::to_string(baud));
+    }
+}
+
+ObdPoller::ObdPoller(const AppConfig& appConfig, TelemetryStore& telemetryStore)
+    : config(appConfig.obd), store(telemetryStore) {
+    config.maxPidsPerRequest = std::max(1, std::min(6, config.maxPidsPerRequest));
+    config.maxInFlight = std::max(1, config.maxInFlight);
+
+    auto now = Clock::now();
+    for (const auto& [name, telemetry] : appConfig.telemetry) {
+        if (telemetry.ingress.type != "obd") continue;
+
+        const ObdPidInfo* info = findObdPid(telemetry.ingress.pid);
+        if (!info) {
+            throw std::runtime_error("Unsupported OBD PID for " + name + ": " +
+                                     std::to_string(telemetry.ingress.pid));
+        }
+
+        ObdPidState state;
+        state.info = info;
+        state.channelId = store.channelId(name);
+        state.targetHz = telemetry.ingress.rate > 0.0 ? telemetry.ingress.rate : 1.0;
+        state.tier = tierForRate(state.targetHz);
+        state.period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / state.targetHz));
+        state.nextDue = now;
+        pids.push_back(state);
+    }
+}
+
+ObdPoller::~ObdPoller() {
+    if (ownsFd && fd >= 0) ::close(fd);
+}
+
+void ObdPoller::open() {
+    int serialFd = ::open(config.device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (serialFd < 0) {
+        throw std::runtime_error("Could not open OBD device " + config.device + ": " + std::strerror(errno));
+    }
+
+    termios tio{};
+    tcgetattr(serialFd, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, baudToSpeed(config.baud));
+    cfsetospeed(&tio, baudToSpeed(config.baud));
+    tio.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(serialFd, TCSANOW, &tio);
+    tcflush(serialFd, TCIOFLUSH);
+
+    fd = serialFd;
+    ownsFd = true;
+}
+
+void ObdPoller::attach(int existingFd) {
+    fd = existingFd;
+    ownsFd = false;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+void ObdPoller::initAdapter() {
+    command("ATZ", 2000);  // reset
+    command("ATE0", 500);  // echo off
+    command("ATL0", 500);  // no linefeeds
+    command("ATS1", 500);  // spaces between bytes
+    command("ATH0", 500);  // no CAN headers
+    command("ATSP0", 500); // automatic protocol
+}
+
+void ObdPoller::poll(int timeoutMs) {
+    auto now = Clock::now();
+    expireRequests(now);
+    sendDueRequests(now);
+
+    // Sleep until input arrives or the next PID becomes due
+    int waitMs = timeoutMs;
+    if (static_cast<int>(inFlight.size()) < config.maxInFlight) {
+        for (const auto& state : pids) {
+            auto untilDue = std::chrono::ceil<std::chrono::milliseconds>(state.nextDue - now).count();
+            waitMs = std::max(0, std::min<int>(waitMs, static_cast<int>(untilDue)));
+        }
+    }
+
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, waitMs) > 0 && (pfd.revents & POLLIN)) {
+        readInput();
+    }
+}
+
+void ObdPoller::sendDueRequests(Clock::time_point now) {
+    std::vector<size_t> due;
+    std::vector<size_t> early;
+
+    while (static_cast<int>(inFlight.size()) < config.maxInFlight) {
+        due.clear();
+        early.clear();
+        for (size_t i = 0; i < pids.size(); ++i) {
+            // A PID whose period is shorter than the round trip is requested
+            // again while its previous request is still outstanding
+            const ObdPidState& state = pids[i];
+            if (state.nextDue <= now) {
+                due.push_back(i);
+            } else if (state.pending == 0 && state.nextDue - now <= state.period / 2) {
+                early.push_back(i);
+            }
+        }
+        if (due.empty()) break;
+
+        // Most urgent tier first, then whichever PID is the most overdue
+        std::sort(due.begin(), due.end(), [this](size_t a, size_t b) {
+            if (pids[a].tier != pids[b].tier) return pids[a].tier < pids[b].tier;
+            return pids[a].nextDue < pids[b].nextDue;
+        });
+        // Spare slots in the request are filled with PIDs that are almost due
+        std::sort(early.begin(), early.end(), [this](size_t a, size_t b) {
+            return pids[a].nextDue < pids[b].nextDue;
+        });
+        due.insert(due.end(), early.begin(), early.end());
+        if (static_cast<int>(due.size()) > config.maxPidsPerRequest) {
+            due.resize(config.maxPidsPerRequest);
+        }
+
+        ObdRequest request;
+        request.sentAt = now;
+        std::ostringstream cmd;
+        cmd << "01" << std::uppercase << std::hex << std::setfill('0');
+        for (size_t index : due) {
+            ObdPidState& state = pids[index];
+            cmd << std::setw(2) << state.info->pid;
+            state.pending++;
+            state.nextDue += state.period;
+            if (state.nextDue <= now) state.nextDue = now + state.period; // fell behind, don't burst
+            request.pidIndices.push_back(static_cast<int>(index));
+        }
+        cmd << "\r";
+
+        writeAll(cmd.str());
+        inFlight.push_back(std::move(request));
+        requestsSent++;
+        pidsRequested += due.size();
+    }
+}
+
+void ObdPoller::expireRequests(Clock::time_point now) {
+    auto timeout = std::chrono::milliseconds(config.timeoutMs);
+    while (!inFlight.empty() && now - inFlight.front().sentAt > timeout) {
+        for (int index : inFlight.front().pidIndices) {
+            pids[index].pending--;
+        }
+        inFlight.pop_front();
+        timeouts++;
+    }
+    // Partial output belongs to a request we gave up on
+    if (inFlight.empty()) rxBuffer.clear();
+}
+
+void ObdPoller::readInput() {
+    char buf[256];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+        rxBuffer.append(buf, static_cast<size_t>(n));
+    }
+
+    // Every reply is terminated by the '>' prompt
+    size_t prompt;
+    while ((prompt = rxBuffer.find('>')) != std::string::npos) {
+        std::string text = rxBuffer.substr(0, prompt);
+        rxBuffer.erase(0, prompt + 1);
+        handleResponse(text, Clock::now());
+    }
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Whether the collected reply bytes are the answer to request: a mode 01
+// reply (41) whose every PID was asked for with its full data, or a mode 01
+// negative response (7F 01 xx). Status text without bytes (NO DATA, ?)
+// can't be told apart and is taken as the answer.
+bool ObdPoller::answers(const ObdRequest& request) const {
+    if (responseBytes.empty()) return true;
+    if (responseBytes[0] == 0x7F) return responseBytes.size() >= 2 && responseBytes[1] == 0x01;
+    if (responseBytes[0] != 0x41) return false;
+
+    size_t i = 0;
+    while (i < responseBytes.size()) {
+        if (responseBytes[i] == 0x41) {
+            i++;
+            continue;
+        }
+        const ObdPidState* state = nullptr;
+        for (int index : request.pidIndices) {
+            if (pids[index].info->pid == responseBytes[i]) { state = &pids[index]; break; }
+        }
+        if (!state || i + 1 + state->info->bytes > responseBytes.size()) return false;
+        i += 1 + state->info->bytes;
+    }
+    return true;
+}
+
+void ObdPoller::handleResponse(const std::string& text, Clock::time_point now) {
+    if (inFlight.empty()) return; // stray reply after a timeout
+
+    // Collect data bytes. Multi-frame CAN replies look like
+    //   00A
+    //   0: 41 0C 1A F8 0D 3C
+    //   1: 05 7B ...
+    // so frame indices and the length line are dropped.
+    responseBytes.clear();
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find_first_of("\r\n", start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            line.erase(0, colon + 1);
+        } else if (line.find(' ') == std::string::npos && line.size() == 3) {
+            continue; // ISO-TP length header
+        }
+
+        // Lines with anything but hex bytes are status text (NO DATA, ?, CAN ERROR...)
+        size_t lineStart = responseBytes.size();
+        int high = -1;
+        for (char c : line) {
+            if (c == ' ') continue;
+            int v = hexValue(c);
+            if (v < 0) {
+                responseBytes.resize(lineStart);
+                break;
+            }
+            if (high < 0) {
+                high = v;
+            } else {
+                responseBytes.push_back(static_cast<uint8_t>(high * 16 + v));
+                high = -1;
+            }
+        }
+    }
+
+    // A late reply to a request that already timed out would otherwise be
+    // taken as the answer to the next one, and its values published as
+    // that request's PIDs; the real answer is still on its way
+    if (!answers(inFlight.front())) {
+        mismatched++;
+        return;
+    }
+    ObdRequest request = std::move(inFlight.front());
+    inFlight.pop_front();
+    responsesReceived++;
+
+    for (int index : request.pidIndices) {
+        pids[index].pending--;
+    }
+
+    // 41 <pid> <data...> [<pid> <data...>]...
+    size_t i = 0;
+    while (i < responseBytes.size()) {
+        if (responseBytes[i] == 0x41) { // (another ECU's) reply header
+            i++;
+            continue;
+        }
+
+        int pid = responseBytes[i];
+        int stateIndex = -1;
+        for (int index : request.pidIndices) {
+            if (pids[index].info->pid == pid) { stateIndex = index; break; }
+        }
+        if (stateIndex < 0) break;
+
+        ObdPidState& state = pids[stateIndex];
+        if (i + 1 + state.info->bytes > responseBytes.size()) break;
+
+        double value = state.info->decode(&responseBytes[i + 1]);
+        if (state.channelId >= 0) {
+            store.publish(state.channelId, value, now);
+        }
+
+        if (state.updates == 0) {
+            state.firstUpdate = now;
+        } else {
+            double intervalMs = std::chrono::duration<double, std::milli>(now - state.lastUpdate).count();
+            state.maxIntervalMs = std::max(state.maxIntervalMs, intervalMs);
+        }
+        state.lastUpdate = now;
+        state.updates++;
+
+        i += 1 + state.info->bytes;
+    }
+}
+
+std::string ObdPoller::command(const std::string& cmd, int timeoutMs) {
+    writeAll(cmd + "\r");
+
+    std::string reply;
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (reply.find('>') == std::string::npos) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (remaining <= 0) {
+            throw std::runtime_error("OBD adapter did not answer " + cmd);
+        }
+
+        pollfd pfd{fd, POLLIN, 0};
+        if (::poll(&pfd, 1, static_cast<int>(remaining)) <= 0) continue;
+
+        char buf[128];
+        ssize_t n;
+        while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+            reply.append(buf, static_cast<size_t>(n));
+        }
+    }
+    return reply.substr(0, reply.find('>'));
+}
+
+void ObdPoller::writeAll(const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                pollfd pfd{fd, POLLOUT, 0};
+                ::poll(&pfd, 1, 10);
+                continue;
+            }
+            throw std::runtime_error(std::string("OBD write failed: ") + std::strerror(errno));
+        }
+        written += static_cast<size_t>(n);
+    }
+}
+
+void ObdPoller::printStats(std::ostream& out) const {
+    out << "=== OBD polling ===" << std::endl;
+    out << std::left << std::setw(14) << "channel" << std::setw(6) << "pid" << std::setw(8) << "tier"
+        << std::right << std::setw(10) << "target" << std::setw(10) << "achieved"
+        << std::setw(12) << "max gap" << std::setw(10) << "updates" << std::endl;
+
+    for (const auto& state : pids) {
+        std::ostringstream pid;
+        pid << "0x" << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << state.info->pid;
+        std::string name = state.channelId >= 0 ? store.channelName(state.channelId) : state.info->name;
+
+        out << std::left << std::setw(14) << name << std::setw(6) << pid.str() << std::setw(8) << tierName(state.tier)
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(8) << state.targetHz << "Hz" << std::setw(8) << state.achievedHz() << "Hz"
+            << std::setw(10) << state.maxIntervalMs << "ms" << std::setw(10) << state.updates << std::endl;
+    }
+
+    double pidsPerRequest = requestsSent > 0 ? static_cast<double>(pidsRequested) / requestsSent : 0.0;
+    out << "requests: " << requestsSent << ", responses: " << responsesReceived
+        << ", timeouts: " << timeouts << ", mismatched: " << mismatched << ", pids/request: " << std::setprecision(2) << pidsPerRequest << std::endl;
+}
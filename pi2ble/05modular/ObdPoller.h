@@ -0,0 +1,108 @@
+#ifndef OBD_POLLER_H
+#define OBD_POLLER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+#include "TelemetryStore.h"
+
+// Mode 01 PID definition: how many data bytes the ECU answers with and how
+// to turn them into a physical value.
+struct ObdPidInfo {
+    int pid;
+    int bytes;
+    const char* name;
+    double (*decode)(const uint8_t* data);
+};
+
+const ObdPidInfo* findObdPid(int pid);
+
+// Polling tier, derived from the configured rate. Lower tiers are served
+// first when more PIDs are due than fit into one request.
+enum class ObdTier {
+    Fast = 0,   // >= 10 Hz, e.g. rpm and speed
+    Medium = 1, // >= 2 Hz
+    Slow = 2    // everything else, e.g. coolant and intake air temperature
+};
+
+struct ObdPidState {
+    const ObdPidInfo* info = nullptr;
+    int channelId = -1;
+    double targetHz = 1.0;
+    ObdTier tier = ObdTier::Slow;
+    std::chrono::steady_clock::duration period{};
+    std::chrono::steady_clock::time_point nextDue{};
+    int pending = 0; // requests in flight that include this PID
+
+    // Achieved refresh statistics
+    uint64_t updates = 0;
+    std::chrono::steady_clock::time_point firstUpdate{};
+    std::chrono::steady_clock::time_point lastUpdate{};
+    double maxIntervalMs = 0.0;
+
+    double achievedHz() const;
+};
+
+struct ObdRequest {
+    std::vector<int> pidIndices; // into ObdPoller::pids
+    std::chrono::steady_clock::time_point sentAt{};
+};
+
+// ELM327-style OBD-II polling engine.
+//
+// Every telemetry entry with `type: obd` becomes a scheduled PID with its own
+// target rate. Due PIDs are packed into multi-PID mode 01 requests (up to
+// maxPidsPerRequest) ordered by tier and lateness, and up to maxInFlight
+// requests are kept outstanding. Responses are matched to requests in order
+// of the '>' prompt, so pipelining needs an adapter that buffers commands;
+// leave maxInFlight at 1 for a stock ELM327.
+class ObdPoller {
+private:
+    ObdConfig config;
+    TelemetryStore& store;
+    int fd = -1;
+    bool ownsFd = false;
+    std::vector<ObdPidState> pids;
+    std::deque<ObdRequest> inFlight;
+    std::string rxBuffer;
+    std::vector<uint8_t> responseBytes;
+
+    // Request statistics
+    uint64_t requestsSent = 0;
+    uint64_t responsesReceived = 0;
+    uint64_t timeouts = 0;
+    uint64_t mismatched = 0; // late replies to timed out requests, dropped
+    uint64_t pidsRequested = 0;
+
+public:
+    ObdPoller(const AppConfig& appConfig, TelemetryStore& store);
+    ~ObdPoller();
+
+    // Open and configure the serial device from the config
+    void open();
+    // Use an already opened descriptor (e.g. a pty slave), not closed by us
+    void attach(int fd);
+    // Reset the adapter and set it up for headerless, echo-free replies
+    void initAdapter();
+
+    // One scheduler step: send due requests, wait up to timeoutMs for
+    // input and dispatch complete responses to the store.
+    void poll(int timeoutMs);
+
+    const std::vector<ObdPidState>& getPids() const { return pids; }
+    void printStats(std::ostream& out) const;
+
+private:
+    void sendDueRequests(std::chrono::steady_clock::time_point now);
+    void expireRequests(std::chrono::steady_clock::time_point now);
+    void readInput();
+    void handleResponse(const std::string& text, std::chrono::steady_clock::time_point now);
+    bool answers(const ObdRequest& request) const;
+    std::string command(const std::string& cmd, int timeoutMs);
+    void writeAll(const std::string& data);
+};
+
+#endif // OBD_POLLER_H
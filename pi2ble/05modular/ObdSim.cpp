@@ -0,0 +1,80 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "AppConfig.h"
+#include "EcuSimulator.h"
+#include "ObdPoller.h"
+#include "Realtime.h"
+#include "TelemetryStore.h"
+
+// Runs the OBD polling engine against a simulated ECU on a pty and reports
+// the achieved per-PID refresh rates.
+//
+// Usage: ./ObdSim [seconds] [maxInFlight] [maxPidsPerRequest] [responseDelayMs]
+int main(int argc, char* argv[]) {
+    try {
+        AppConfig appConfig = loadAppConfig();
+
+        int seconds = argc > 1 ? std::stoi(argv[1]) : 5;
+        if (argc > 2) appConfig.obd.maxInFlight = std::stoi(argv[2]);
+        if (argc > 3) appConfig.obd.maxPidsPerRequest = std::stoi(argv[3]);
+        int responseDelayMs = argc > 4 ? std::stoi(argv[4]) : 15;
+
+        EcuSimulator ecu(responseDelayMs);
+        ecu.start();
+        std::cout << "Simulated ECU on " << ecu.slavePath()
+                  << " (response delay " << responseDelayMs << " ms)" << std::endl;
+
+        int fd = ::open(ecu.slavePath().c_str(), O_RDWR | O_NOCTTY);
+        if (fd < 0) {
+            std::cerr << "Could not open " << ecu.slavePath() << std::endl;
+            return 1;
+        }
+
+        const RealtimeConfig& realtime = appConfig.realtime;
+        Realtime::Applied memory;
+        if (realtime.enabled) memory = Realtime::lockMemory(realtime);
+
+        TelemetryStore store(appConfig);
+        ObdPoller poller(appConfig, store);
+        poller.attach(fd);
+        poller.initAdapter();
+
+        std::cout << "Polling for " << seconds << " s, maxInFlight=" << appConfig.obd.maxInFlight
+                  << ", maxPidsPerRequest=" << appConfig.obd.maxPidsPerRequest << std::endl;
+
+        // The polling loop is the ingest thread, set up as in LatencyProbe
+        if (realtime.enabled) {
+            Realtime::Applied applied =
+                Realtime::setupThread(realtime, "ingest", realtime.ingestCpu, realtime.ingestPriority);
+            applied.locked = memory.locked;
+            std::cout << "Ingest realtime: " << Realtime::describe(applied, realtime.ingestCpu, realtime.ingestPriority)
+                      << std::endl;
+        }
+
+        auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        while (std::chrono::steady_clock::now() < end) {
+            poller.poll(appConfig.obd.timeoutMs);
+        }
+
+        ecu.stop();
+        poller.printStats(std::cout);
+
+        std::cout << "Latest values:" << std::endl;
+        for (size_t id = 0; id < store.channelCount(); ++id) {
+            TelemetrySample sample = store.latest(static_cast<int>(id));
+            std::cout << "  " << store.channelName(static_cast<int>(id)) << ": "
+                      << std::fixed << std::setprecision(1) << sample.value << std::endl;
+        }
+
+        ::close(fd);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "OverlayDraw.h"
+#include <algorithm>
+#include <cstdio>
+
+void drawProgressBar(cv::Mat& image, double progress, const std::string& label) {
+    int barWidth = std::min(400, image.cols - 20);
+    int barHeight = 30;
+    int barX = (image.cols - barWidth) / 2;
+    int barY = image.rows - 60;
+    progress = std::max(0.0, std::min(1.0, progress));
+
+    cv::rectangle(image, cv::Point(barX, barY), cv::Point(barX + barWidth, barY + barHeight),
+                  cv::Scalar(100, 100, 100), -1);
+    int progressWidth = static_cast<int>(barWidth * progress);
+    if (progressWidth > 0) {
+        cv::rectangle(image, cv::Point(barX, barY), cv::Point(barX + progressWidth, barY + barHeight),
+                      cv::Scalar(0, 255, 0), -1);
+    }
+    cv::rectangle(image, cv::Point(barX, barY), cv::Point(barX + barWidth, barY + barHeight),
+                  cv::Scalar(255, 255, 255), 2);
+
+    int baseline = 0;
+    cv::Size textSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.6, 2, &baseline);
+    cv::Point textOrg(barX + (barWidth - textSize.width) / 2, barY + (barHeight + textSize.height) / 2);
+    cv::putText(image, label, textOrg, cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 2);
+}
+
+void drawTelemetry(cv::Mat& image, const TelemetryStore& store, const std::vector<int>& ids) {
+    const int lineHeight = 22;
+    int rows = std::min<int>(static_cast<int>(ids.size()), std::max(0, (image.rows - 80) / lineHeight));
+    if (rows == 0) return;
+
+    cv::rectangle(image, cv::Point(5, 5), cv::Point(220, 12 + rows * lineHeight), cv::Scalar(0, 0, 0), -1);
+    char text[64];
+    for (int row = 0; row < rows; ++row) {
+        TelemetrySample sample = store.latest(ids[row]);
+        if (sample.updates > 0) {
+            std::snprintf(text, sizeof(text), "%-12.12s %9.1f", store.channelName(ids[row]).c_str(), sample.value);
+        } else {
+            std::snprintf(text, sizeof(text), "%-12.12s %9s", store.channelName(ids[row]).c_str(), "--");
+        }
+        cv::putText(image, text, cv::Point(10, 5 + (row + 1) * lineHeight), cv::FONT_HERSHEY_SIMPLEX, 0.5,
+                    cv::Scalar(255, 255, 255), 1);
+    }
+}
+
+std::vector<OverlayItem> overlayItems(const CompiledConfig& config, const TelemetryStore& store) {
+    std::vector<OverlayItem> items;
+    for (size_t id = 0; id < config.channelCount(); ++id) {
+        const ConfigCacheChannel& channel = config.channel(id);
+        OverlayItem item;
+        item.name = config.string(channel.name);
+        item.id = store.channelId(item.name);
+        item.position = cv::Point(channel.x, channel.y);
+        if (channel.colorCount == 3) {
+            item.color = cv::Scalar(channel.color[2], channel.color[1], channel.color[0]);
+        } else {
+            item.color = cv::Scalar(255, 255, 255);
+        }
+        item.prefix = config.string(channel.formatPrefix);
+        item.suffix = config.string(channel.formatSuffix);
+        item.hasValue = channel.hasValue != 0;
+        items.push_back(item);
+    }
+    return items;
+}
+
+void drawOverlayLabels(cv::Mat& image, const std::vector<OverlayItem>& items) {
+    for (const OverlayItem& item : items) {
+        cv::putText(image, item.name, cv::Point(item.position.x, item.position.y - 28), cv::FONT_HERSHEY_SIMPLEX,
+                    0.5, cv::Scalar(160, 160, 160), 1);
+    }
+}
+
+void drawOverlayValues(cv::Mat& image, const std::vector<OverlayItem>& items, const TelemetryStore& store,
+                       TelemetrySample* shown) {
+    char text[96];
+    for (const OverlayItem& item : items) {
+        if (!item.hasValue) {
+            cv::putText(image, item.prefix, item.position, cv::FONT_HERSHEY_SIMPLEX, 0.8, item.color, 2);
+            continue;
+        }
+        TelemetrySample sample;
+        if (item.id >= 0) sample = store.latest(item.id);
+        if (item.id >= 0 && shown) shown[item.id] = sample;
+        if (sample.updates > 0) {
+            std::snprintf(text, sizeof(text), "%s%.1f%s", item.prefix.c_str(), sample.value, item.suffix.c_str());
+        } else {
+            std::snprintf(text, sizeof(text), "%s--%s", item.prefix.c_str(), item.suffix.c_str());
+        }
+        cv::putText(image, text, item.position, cv::FONT_HERSHEY_SIMPLEX, 0.8, item.color, 2);
+    }
+}
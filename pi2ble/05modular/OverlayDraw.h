@@ -0,0 +1,43 @@
+#ifndef OVERLAY_DRAW_H
+#define OVERLAY_DRAW_H
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+#include "ConfigCache.h"
+#include "TelemetryStore.h"
+
+// Overlay widgets drawn onto BGR frames, shared by OverlayRender,
+// ColdStart, LiveOverlay and DrawBench so the benchmark times the code
+// that actually ships.
+
+// Same bar as VideoStreamer (03StreamLoadingBar), progress in 0..1
+void drawProgressBar(cv::Mat& image, double progress, const std::string& label);
+
+// Latest value of each channel in ids, one row each, top left
+void drawTelemetry(cv::Mat& image, const TelemetryStore& store, const std::vector<int>& ids);
+
+// One telemetry entry of the configured layout, resolved for drawing
+struct OverlayItem {
+    int id;              // in the TelemetryStore, -1 if it has no such channel
+    std::string name;
+    cv::Point position;
+    cv::Scalar color;    // BGR, white if the config has no full R G B
+    std::string prefix;  // format before $0
+    std::string suffix;  // and after
+    bool hasValue;       // format has a $0
+};
+
+// The configured layout, in config (id) order
+std::vector<OverlayItem> overlayItems(const CompiledConfig& config, const TelemetryStore& store);
+
+// What doesn't change between frames: each item's name above it
+void drawOverlayLabels(cv::Mat& image, const std::vector<OverlayItem>& items);
+
+// Each item's format with the channel's latest value, "--" before the first.
+// With shown (one entry per store channel), the samples drawn go there, for
+// age-at-display.
+void drawOverlayValues(cv::Mat& image, const std::vector<OverlayItem>& items, const TelemetryStore& store,
+                       TelemetrySample* shown = nullptr);
+
+#endif // OVERLAY_DRAW_H
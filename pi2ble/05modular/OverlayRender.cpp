@@ -0,0 +1,272 @@
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BoundedQueue.h"
+#include "OverlayDraw.h"
+#include "SessionLogReader.h"
+#include "SessionReplay.h"
+#include "TelemetryStore.h"
+#include "Trace.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct FrameJob {
+    cv::Mat image;
+    int64_t index = 0;
+    int64_t ptsNs = 0; // from the start of the video
+};
+
+// Frames and time spent working vs waiting on a queue, one thread each
+struct StageStats {
+    const char* name;
+    uint64_t frames = 0;
+    Clock::duration busy{};
+    Clock::duration waiting{};
+};
+
+// First error from any stage; the others stop when the queues close
+class PipelineError {
+private:
+    std::mutex mutex;
+    std::string message;
+
+public:
+    void set(const std::string& what) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (message.empty()) message = what;
+    }
+    std::string get() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return message;
+    }
+};
+
+static std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static void printStage(const StageStats& stage, double wallSeconds) {
+    double busy = std::chrono::duration<double>(stage.busy).count();
+    double waiting = std::chrono::duration<double>(stage.waiting).count();
+    std::cout << "  " << std::left << std::setw(8) << stage.name << std::right << std::setw(7) << stage.frames
+              << " frames  " << std::setw(7) << (busy > 0 ? stage.frames / busy : 0.0) << " fps busy  "
+              << std::setw(5) << 100.0 * busy / std::max(wallSeconds, 1e-9) << "% busy  " << std::setw(5)
+              << 100.0 * waiting / std::max(wallSeconds, 1e-9) << "% waiting" << std::endl;
+}
+
+// Headless batch version of VideoStreamer: draws a recorded telemetry
+// session onto a video file and encodes the result as fast as the CPU
+// allows. Decode, overlay and encode run on their own threads joined by
+// bounded queues; each frame shows the telemetry as of its PTS.
+//
+// Usage: ./OverlayRender <video> <segment.tlog> <output> [offsetSeconds] [channel,channel,...]
+//   offsetSeconds: session time at the first video frame (default 0)
+//   .avi output is MJPG, anything else mp4v
+//   with cmake -DTRACE=ON each stage is traced to OverlayRender.trace.json
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <video> <segment.tlog> <output> [offsetSeconds] [channel,channel,...]" << std::endl;
+        return 1;
+    }
+
+    try {
+        std::string videoPath = argv[1];
+        std::string outputPath = argv[3];
+        double offsetSeconds = argc > 4 ? std::stod(argv[4]) : 0.0;
+
+        SessionLogReader log(argv[2]);
+        std::vector<std::string> names;
+        for (size_t i = 0; i < log.channelCount(); ++i) names.push_back(log.channelName(static_cast<int>(i)));
+        TelemetryStore store(names);
+
+        std::vector<int> drawIds;
+        if (argc > 5) {
+            for (const std::string& name : splitList(argv[5])) {
+                int id = store.channelId(name);
+                if (id < 0) throw std::runtime_error("No channel " + name + " in the session");
+                drawIds.push_back(id);
+            }
+        } else {
+            for (size_t id = 0; id < store.channelCount(); ++id) drawIds.push_back(static_cast<int>(id));
+        }
+
+        int64_t sessionStartNs = log.firstTimestampNs() + static_cast<int64_t>(offsetSeconds * 1e9);
+        double sessionSeconds = (log.lastTimestampNs() - log.firstTimestampNs()) / 1e9;
+        SessionReplay replay(log, store);
+        replay.seek(sessionStartNs);
+
+        cv::VideoCapture capture(videoPath);
+        if (!capture.isOpened()) {
+            throw std::runtime_error("Could not open video file: " + videoPath);
+        }
+        double fps = capture.get(cv::CAP_PROP_FPS);
+        if (!(fps > 0)) fps = 30.0;
+        int totalFrames = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_COUNT));
+        std::cout << "Video: " << totalFrames << " frames at " << fps << " fps, session: " << std::fixed
+                  << std::setprecision(1) << sessionSeconds << " s, " << log.channelCount() << " channels"
+                  << std::endl;
+
+        const size_t queueDepth = 8;
+        BoundedQueue<FrameJob> decoded(queueDepth);
+        BoundedQueue<FrameJob> composed(queueDepth);
+        PipelineError error;
+        StageStats decodeStats{"decode"};
+        StageStats overlayStats{"overlay"};
+        StageStats encodeStats{"encode"};
+
+        auto start = Clock::now();
+        TRACE_START("OverlayRender.trace.json");
+
+        std::thread decoder([&] {
+            TRACE_THREAD_NAME("decode");
+            try {
+                double lastPtsMs = -1.0;
+                for (int64_t index = 0;; ++index) {
+                    auto begin = Clock::now();
+                    FrameJob job;
+                    {
+                        TRACE_SCOPE("ingest");
+                        if (!capture.read(job.image) || job.image.empty()) break;
+                    }
+
+                    // Some containers don't report a PTS, fall back to the frame rate
+                    double ptsMs = capture.get(cv::CAP_PROP_POS_MSEC);
+                    if (!(ptsMs >= 0.0) || (index > 0 && ptsMs <= lastPtsMs)) ptsMs = index * 1000.0 / fps;
+                    lastPtsMs = ptsMs;
+                    job.index = index;
+                    job.ptsNs = static_cast<int64_t>(ptsMs * 1e6);
+
+                    auto decodedAt = Clock::now();
+                    decodeStats.busy += decodedAt - begin;
+                    bool pushed = decoded.push(std::move(job));
+                    decodeStats.waiting += Clock::now() - decodedAt;
+                    if (!pushed) break;
+                    decodeStats.frames++;
+                }
+            } catch (const std::exception& e) {
+                error.set(std::string("decode: ") + e.what());
+            }
+            decoded.close();
+        });
+
+        std::thread overlay([&] {
+            TRACE_THREAD_NAME("overlay");
+            try {
+                FrameJob job;
+                while (true) {
+                    auto waitStart = Clock::now();
+                    if (!decoded.pop(job)) break;
+                    auto begin = Clock::now();
+                    overlayStats.waiting += begin - waitStart;
+
+                    int64_t frameNs = sessionStartNs + job.ptsNs;
+                    {
+                        TRACE_SCOPE("render");
+                        replay.publishUntil(frameNs);
+                        drawTelemetry(job.image, store, drawIds);
+
+                        TRACE_SCOPE("text");
+                        double sessionTime = (frameNs - log.firstTimestampNs()) / 1e9;
+                        std::ostringstream label;
+                        label << std::fixed << std::setprecision(1) << sessionTime << " / " << sessionSeconds << " s";
+                        drawProgressBar(job.image, sessionSeconds > 0 ? sessionTime / sessionSeconds : 0.0,
+                                        label.str());
+                    }
+
+                    auto composedAt = Clock::now();
+                    overlayStats.busy += composedAt - begin;
+                    bool pushed = composed.push(std::move(job));
+                    overlayStats.waiting += Clock::now() - composedAt;
+                    if (!pushed) break;
+                    overlayStats.frames++;
+                }
+            } catch (const std::exception& e) {
+                error.set(std::string("overlay: ") + e.what());
+                decoded.close();
+            }
+            composed.close();
+        });
+
+        std::thread encoder([&] {
+            TRACE_THREAD_NAME("encode");
+            try {
+                cv::VideoWriter writer;
+                bool avi = outputPath.size() > 4 && outputPath.compare(outputPath.size() - 4, 4, ".avi") == 0;
+                int fourcc = avi ? cv::VideoWriter::fourcc('M', 'J', 'P', 'G') : cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+                auto lastReport = Clock::now();
+                FrameJob job;
+                while (true) {
+                    auto waitStart = Clock::now();
+                    if (!composed.pop(job)) break;
+                    auto begin = Clock::now();
+                    encodeStats.waiting += begin - waitStart;
+
+                    if (!writer.isOpened()) {
+                        writer.open(outputPath, fourcc, fps, job.image.size());
+                        if (!writer.isOpened()) {
+                            throw std::runtime_error("Could not open " + outputPath + " for writing");
+                        }
+                    }
+                    {
+                        // The encoder is this tool's blit
+                        TRACE_SCOPE("blit");
+                        writer.write(job.image);
+                    }
+                    encodeStats.frames++;
+
+                    auto now = Clock::now();
+                    encodeStats.busy += now - begin;
+                    if (now - lastReport >= std::chrono::seconds(2)) {
+                        double seconds = std::chrono::duration<double>(now - start).count();
+                        std::cout << "frame " << job.index + 1 << "/" << totalFrames << ", " << std::setprecision(1)
+                                  << encodeStats.frames / seconds << " fps" << std::endl;
+                        lastReport = now;
+                    }
+                }
+                writer.release();
+            } catch (const std::exception& e) {
+                error.set(std::string("encode: ") + e.what());
+                composed.close();
+                decoded.close();
+            }
+        });
+
+        decoder.join();
+        overlay.join();
+        encoder.join();
+        TRACE_STOP();
+
+        std::string failure = error.get();
+        if (!failure.empty()) throw std::runtime_error(failure);
+
+        double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        double videoSeconds = encodeStats.frames / fps;
+        std::cout << std::setprecision(1) << "Wrote " << encodeStats.frames << " frames to " << outputPath << " in "
+                  << wallSeconds << " s: " << encodeStats.frames / std::max(wallSeconds, 1e-9) << " fps ("
+                  << videoSeconds / std::max(wallSeconds, 1e-9) << "x real time)" << std::endl;
+        printStage(decodeStats, wallSeconds);
+        printStage(overlayStats, wallSeconds);
+        printStage(encodeStats, wallSeconds);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
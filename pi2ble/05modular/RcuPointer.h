@@ -0,0 +1,93 @@
+#ifndef RCU_POINTER_H
+#define RCU_POINTER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// Pointer to an immutable T that a writer replaces while readers keep
+// using the version they have: read-copy-update with quiescent-state
+// reclamation. Readers never lock or wait; get() is one atomic load. Each
+// reader calls quiescent() when it holds no pointer from get() any more
+// (once per frame, after drawing). publish() swaps the new version in and
+// deletes the old one after the grace period, when every reader has been
+// quiescent since the swap; it waits for that, so call it from a
+// background thread. A reader that stops calling quiescent() holds the
+// writer up, so destroy it (it goes offline) instead of leaving it idle.
+template <typename T>
+class RcuPointer {
+public:
+    static constexpr int MAX_READERS = 8;
+
+private:
+    static constexpr uint64_t OFFLINE = UINT64_MAX;
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> claimed{false};
+        std::atomic<uint64_t> epoch{OFFLINE}; // global epoch seen at the last quiescent()
+    };
+
+    std::atomic<T*> current;
+    std::atomic<uint64_t> globalEpoch{1};
+    ReaderSlot slots[MAX_READERS];
+
+public:
+    // One per reading thread
+    class Reader {
+    private:
+        RcuPointer& rcu;
+        ReaderSlot* slot = nullptr;
+
+    public:
+        // Throws std::runtime_error if MAX_READERS readers exist already
+        explicit Reader(RcuPointer& pointer) : rcu(pointer) {
+            for (ReaderSlot& candidate : rcu.slots) {
+                bool expected = false;
+                if (candidate.claimed.compare_exchange_strong(expected, true)) {
+                    slot = &candidate;
+                    slot->epoch.store(rcu.globalEpoch.load());
+                    return;
+                }
+            }
+            throw std::runtime_error("RcuPointer has no free reader slot");
+        }
+        ~Reader() {
+            slot->epoch.store(OFFLINE);
+            slot->claimed.store(false);
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        // Valid until this reader's next quiescent()
+        const T* get() const { return rcu.current.load(); }
+        void quiescent() { slot->epoch.store(rcu.globalEpoch.load()); }
+    };
+
+    explicit RcuPointer(std::unique_ptr<T> initial) : current(initial.release()) {}
+    ~RcuPointer() { delete current.load(); }
+
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    // One writer at a time. Returns once the old version is deleted.
+    void publish(std::unique_ptr<T> next) {
+        T* old = current.exchange(next.release());
+        uint64_t target = globalEpoch.fetch_add(1) + 1;
+        for (ReaderSlot& slot : slots) {
+            // Offline readers hold OFFLINE, above any target
+            while (slot.epoch.load() < target) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        delete old;
+    }
+
+    // Versions published so far
+    uint64_t version() const { return globalEpoch.load() - 1; }
+};
+
+#endif // RCU_POINTER_H
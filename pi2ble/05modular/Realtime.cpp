@@ -0,0 +1,104 @@
+#include "Realtime.h"
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace Realtime {
+
+static void warn(const std::string& what, int error, const char* hint) {
+    std::cerr << "Realtime: " << what << " failed (" << std::strerror(error) << "), " << hint << std::endl;
+}
+
+Applied lockMemory(const RealtimeConfig& config) {
+    Applied applied;
+    if (!config.lockMemory) return applied;
+
+    int flags = MCL_CURRENT | MCL_FUTURE;
+#ifdef MCL_ONFAULT
+    flags |= MCL_ONFAULT;
+#endif
+    int result = mlockall(flags);
+#ifdef MCL_ONFAULT
+    // Kernels before 4.4 reject the flag
+    if (result != 0 && errno == EINVAL) result = mlockall(MCL_CURRENT | MCL_FUTURE);
+#endif
+    if (result != 0) {
+        warn("mlockall", errno, "memory stays pageable (needs CAP_IPC_LOCK or a higher memlock limit)");
+        return applied;
+    }
+    applied.locked = true;
+
+    // Freed memory stays in the heap rather than going back to the kernel
+    // and faulting in again
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    return applied;
+}
+
+Applied setupThread(const RealtimeConfig& config, const char* name, int cpu, int priority) {
+    Applied applied;
+    pthread_setname_np(pthread_self(), name);
+
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) == 0) {
+            applied.pinned = true;
+        } else {
+            warn(std::string(name) + " on cpu " + std::to_string(cpu), errno, "left unpinned");
+        }
+    }
+
+    if (priority > 0) {
+        sched_param param{};
+        param.sched_priority = priority;
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error == 0) {
+            applied.fifo = true;
+        } else {
+            warn(std::string(name) + " at SCHED_FIFO " + std::to_string(priority), error,
+                 "stays SCHED_OTHER (needs CAP_SYS_NICE or an rtprio limit)");
+        }
+    }
+
+    if (config.prefaultStackKB > 0) {
+        // Touched through a volatile pointer so it isn't optimized away
+        size_t bytes = static_cast<size_t>(config.prefaultStackKB) * 1024;
+        volatile char* stack = static_cast<volatile char*>(alloca(bytes));
+        long page = sysconf(_SC_PAGESIZE);
+        for (size_t offset = 0; offset < bytes; offset += page) stack[offset] = 0;
+    }
+    return applied;
+}
+
+void prefault(void* data, size_t bytes) {
+    volatile char* p = static_cast<volatile char*>(data);
+    long page = sysconf(_SC_PAGESIZE);
+    for (size_t offset = 0; offset < bytes; offset += page) p[offset] = p[offset];
+}
+
+std::string describe(const Applied& applied, int cpu, int priority) {
+    std::ostringstream out;
+    const char* separator = "";
+    if (applied.pinned) {
+        out << "cpu " << cpu;
+        separator = ", ";
+    }
+    if (applied.fifo) {
+        out << separator << "SCHED_FIFO " << priority;
+        separator = ", ";
+    }
+    if (applied.locked) out << separator << "memory locked";
+    std::string text = out.str();
+    return text.empty() ? "not applied" : text;
+}
+
+} // namespace Realtime
@@ -0,0 +1,49 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <cstddef>
+#include <string>
+#include "AppConfig.h"
+
+// Realtime mode (realtime: in AppConfig.yaml) for the render loop and the
+// ingest thread: each pinned to its own core with sched_setaffinity, run
+// at SCHED_FIFO so kernel daemons and other threads can't preempt it, and
+// memory locked with mlockall so the loop never waits on a page fault.
+// Stacks and buffers are touched up front, since mlockall only keeps
+// pages that are resident.
+//
+// Every step degrades on its own: without CAP_SYS_NICE (or an rtprio
+// limit) the thread stays SCHED_OTHER, without CAP_IPC_LOCK (or enough
+// memlock limit) memory stays pageable, a core that doesn't exist leaves
+// the thread unpinned. Each is reported once on std::cerr and the rest
+// still applies. To grant it without root:
+//   sudo setcap cap_sys_nice,cap_ipc_lock+ep ./LatencyProbe
+namespace Realtime {
+
+// What one call got, for logging
+struct Applied {
+    bool pinned = false;
+    bool fifo = false;
+    bool locked = false;
+};
+
+// Process-wide, once, before the threads and buffers it should cover:
+// mlockall (pages locked as they fault in where MCL_ONFAULT exists, so
+// thread stacks aren't pulled in whole) and malloc told to keep freed
+// memory instead of returning it to the kernel
+Applied lockMemory(const RealtimeConfig& config);
+
+// On the thread itself: name (for top/ps), pin to cpu (-1 leaves it),
+// SCHED_FIFO at priority (0 leaves SCHED_OTHER), then touch
+// config.prefaultStackKB of stack
+Applied setupThread(const RealtimeConfig& config, const char* name, int cpu, int priority);
+
+// Writes every page of a buffer allocated before the loop
+void prefault(void* data, size_t bytes);
+
+// e.g. "cpu 3, SCHED_FIFO 50, memory locked" or "not applied"
+std::string describe(const Applied& applied, int cpu, int priority);
+
+} // namespace Realtime
+
+#endif // REALTIME_H
@@ -0,0 +1,140 @@
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "SessionRecorder.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Counts heap allocations made by threads that opted in, to check the
+// producer side of the recorder never allocates
+static thread_local bool countAllocations = false;
+static std::atomic<uint64_t> producerAllocations{0};
+
+void* operator new(size_t size) {
+    if (countAllocations) producerAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// Walks the written segments and counts the samples in complete blocks
+static uint64_t countRecordedSamples(const std::vector<std::string>& paths) {
+    uint64_t samples = 0;
+    for (const auto& path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        SessionSegmentHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != SESSION_LOG_MAGIC) {
+            std::cerr << path << ": bad segment header" << std::endl;
+            continue;
+        }
+
+        uint64_t offset = header.headerBytes;
+        while (offset + sizeof(SessionBlockHeader) <= header.usedBytes) {
+            SessionBlockHeader block{};
+            file.seekg(static_cast<std::streamoff>(offset));
+            if (!file.read(reinterpret_cast<char*>(&block), sizeof(block)) || block.magic != SESSION_BLOCK_MAGIC) {
+                std::cerr << path << ": bad block at " << offset << std::endl;
+                break;
+            }
+            samples += block.sampleCount;
+            offset += sizeof(block) + block.payloadBytes;
+        }
+    }
+    return samples;
+}
+
+// Session recorder throughput: channels x rateHz samples published through
+// TelemetryStore with the recorder attached as its tap.
+//
+// Usage: ./RecorderBench [seconds] [channels] [rateHz] [directory] [--keep]
+// Segment files are removed afterwards unless --keep is given.
+int main(int argc, char* argv[]) {
+    try {
+        AppConfig appConfig = loadAppConfig();
+        int seconds = argc > 1 ? std::stoi(argv[1]) : 10;
+        int channels = argc > 2 ? std::stoi(argv[2]) : 100;
+        int rateHz = argc > 3 ? std::stoi(argv[3]) : 1000;
+        if (argc > 4) appConfig.recorder.directory = argv[4];
+        bool keep = argc > 5 && std::string(argv[5]) == "--keep";
+        appConfig.recorder.prefix = "bench";
+
+        std::vector<std::string> names;
+        for (int i = 0; i < channels; ++i) names.push_back("ch" + std::to_string(i));
+        TelemetryStore store(names);
+        SessionRecorder recorder(appConfig.recorder, store);
+        store.setTap(&recorder);
+        recorder.start();
+
+        std::cout << "Recording " << channels << " channels x " << rateHz << " Hz for " << seconds
+                  << " s to " << appConfig.recorder.directory << "/" << std::endl;
+
+        uint64_t published = 0;
+        Clock::duration publishTime{};
+        std::thread producer([&] {
+            countAllocations = true;
+            auto start = Clock::now();
+            auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+            auto next = start;
+            auto end = start + std::chrono::seconds(seconds);
+            while (next < end) {
+                std::this_thread::sleep_until(next);
+                next += period;
+
+                auto now = Clock::now();
+                double t = std::chrono::duration<double>(now - start).count();
+                for (int id = 0; id < channels; ++id) {
+                    store.publish(id, 100.0 * std::sin(t + id), now);
+                }
+                publishTime += Clock::now() - now;
+                published += static_cast<uint64_t>(channels);
+            }
+            countAllocations = false;
+        });
+        producer.join();
+        recorder.stop();
+
+        recorder.printStats(std::cout);
+        uint64_t onDisk = countRecordedSamples(recorder.segmentPaths);
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "published: " << published << ", found on disk: " << onDisk << std::endl;
+        std::cout << "sustained: " << onDisk / static_cast<double>(seconds) << " samples/s, "
+                  << recorder.bytesWritten / static_cast<double>(seconds) / 1024.0 << " KiB/s" << std::endl;
+        std::cout << "producer: " << std::chrono::duration<double, std::nano>(publishTime).count() / std::max<uint64_t>(1, published)
+                  << " ns per publish, " << producerAllocations.load() << " allocations" << std::endl;
+
+        if (!keep) {
+            for (const auto& path : recorder.segmentPaths) {
+                std::remove(path.c_str());
+                std::remove(sessionIndexPath(path).c_str());
+            }
+            ::rmdir(appConfig.recorder.directory.c_str()); // only succeeds if it was ours and is now empty
+        }
+
+        if (onDisk != published || producerAllocations.load() != 0) return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// On-disk format of recorded telemetry sessions (see SessionRecorder).
+//
+// A session is a series of segment files <prefix>-<date>-<time>-NNNN.tlog:
+//   SessionSegmentHeader
+//   SessionChannelName[channelCount]
+//   (padding to headerBytes)
+//   blocks: SessionBlockHeader + payload, each 8 byte aligned, up to usedBytes
+//
+// A RAW block payload is columnar:
+//   double   value[sampleCount]
+//   uint32_t offsetUs[sampleCount]   from firstTimestampNs
+//   uint16_t channel[sampleCount]
+// padded to 8 bytes. GORILLA blocks are described in TimeSeriesCodec.h.
+// Timestamps are steady_clock nanoseconds, the same clock as
+// TelemetrySample::timestamp. A block keeps its first and last timestamp
+// in full, the samples only to the microsecond: the recorder truncates
+// each one's offset from firstTimestampNs to whole microseconds, in both
+// encodings. All integers are little endian.
+//
+// A finished segment gets a sparse index next to it, <...>-NNNN.tidx:
+//   SessionIndexHeader
+//   SessionIndexEntry[blockCount]
+//   SessionChannelRange[blockCount][channelCount]
+// so a reader can seek by time or value without touching the blocks.
+// It only describes the segment up to indexedBytes; segments that were
+// never closed have none and are read by walking their block headers.
+
+constexpr uint32_t SESSION_LOG_MAGIC = 0x474F4C54;   // "TLOG"
+constexpr uint32_t SESSION_LOG_VERSION = 1;
+constexpr uint32_t SESSION_BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+constexpr uint32_t SESSION_INDEX_MAGIC = 0x58444954; // "TIDX"
+constexpr uint32_t SESSION_INDEX_VERSION = 1;
+constexpr size_t SESSION_LOG_NAME_LENGTH = 32;
+
+enum SessionBlockEncoding : uint16_t {
+    SESSION_BLOCK_RAW = 0,
+    SESSION_BLOCK_GORILLA = 1, // see TimeSeriesCodec.h
+};
+
+struct SessionSegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t channelCount;
+    uint32_t segmentIndex;
+    uint64_t headerBytes;     // offset of the first block
+    uint64_t usedBytes;       // end of the last block known to be on disk
+    int64_t sessionStartNs;   // steady_clock
+    int64_t wallClockStartNs; // system_clock at the same instant
+    uint8_t reserved[16];
+};
+static_assert(sizeof(SessionSegmentHeader) == 64, "segment header layout");
+
+struct SessionChannelName {
+    char name[SESSION_LOG_NAME_LENGTH];
+};
+
+struct SessionBlockHeader {
+    uint32_t magic;
+    uint16_t encoding;
+    uint16_t reserved;
+    uint32_t sampleCount;
+    uint32_t payloadBytes; // padded, the next block starts right after
+    int64_t firstTimestampNs;
+    int64_t lastTimestampNs;
+};
+static_assert(sizeof(SessionBlockHeader) == 32, "block header layout");
+
+struct SessionIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t channelCount;
+    uint32_t segmentIndex;
+    uint64_t blockCount;
+    uint64_t indexedBytes; // usedBytes of the segment when it was indexed
+    uint8_t reserved[32];
+};
+static_assert(sizeof(SessionIndexHeader) == 64, "index header layout");
+
+struct SessionIndexEntry {
+    uint64_t offset; // of the SessionBlockHeader in the segment
+    int64_t firstTimestampNs;
+    int64_t lastTimestampNs;
+    uint32_t sampleCount;
+    uint16_t encoding;
+    uint16_t reserved;
+};
+static_assert(sizeof(SessionIndexEntry) == 32, "index entry layout");
+
+// Value range of one channel in one block, rounded outwards to float.
+// min > max: the channel has no samples in the block.
+struct SessionChannelRange {
+    float min;
+    float max;
+};
+
+inline std::string sessionIndexPath(const std::string& segmentPath) {
+    const std::string suffix = ".tlog";
+    if (segmentPath.size() > suffix.size() &&
+        segmentPath.compare(segmentPath.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return segmentPath.substr(0, segmentPath.size() - suffix.size()) + ".tidx";
+    }
+    return segmentPath + ".tidx";
+}
+
+inline size_t sessionRawPayloadBytes(size_t samples) {
+    return (samples * (sizeof(double) + sizeof(uint32_t) + sizeof(uint16_t)) + 7) & ~static_cast<size_t>(7);
+}
+
+#endif // SESSION_LOG_H
@@ -0,0 +1,221 @@
+#include "SessionLogReader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SessionLogReader::SessionLogReader(const std::string& path) {
+    // <session>-NNNN.tlog: map every segment of the session in order
+    const std::string suffix = ".tlog";
+    size_t dash = path.rfind('-');
+    bool numbered = dash != std::string::npos && path.size() == dash + 5 + suffix.size() &&
+                    path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    if (numbered) {
+        std::string session = path.substr(0, dash);
+        for (unsigned index = 0;; ++index) {
+            char name[16];
+            std::snprintf(name, sizeof(name), "-%04u.tlog", index);
+            std::string segmentPath = session + name;
+            if (::access(segmentPath.c_str(), R_OK) != 0) break;
+            mapSegment(segmentPath);
+        }
+    }
+    if (segments.empty()) mapSegment(path);
+
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        const Segment& segment = segments[s];
+        SessionSegmentHeader header;
+        std::memcpy(&header, segment.data, sizeof(header));
+
+        if (s == 0) {
+            sessionStartNs = header.sessionStartNs;
+            wallClockStartNs = header.wallClockStartNs;
+            const SessionChannelName* channelNames =
+                reinterpret_cast<const SessionChannelName*>(segment.data + sizeof(header));
+            for (uint32_t i = 0; i < header.channelCount; ++i) {
+                names.emplace_back(channelNames[i].name, strnlen(channelNames[i].name, SESSION_LOG_NAME_LENGTH));
+            }
+        } else if (header.channelCount != names.size()) {
+            throw std::runtime_error(segment.path + " belongs to a different session layout");
+        }
+
+        if (loadIndex(s, header)) {
+            indexedSegmentCount++;
+        } else {
+            scanBlocks(s, header);
+        }
+    }
+}
+
+SessionLogReader::~SessionLogReader() {
+    for (const Segment& segment : segments) {
+        munmap(const_cast<uint8_t*>(segment.data), segment.size);
+    }
+}
+
+void SessionLogReader::mapSegment(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+    }
+    struct stat st{};
+    fstat(fd, &st);
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(SessionSegmentHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a session segment");
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + path);
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    const SessionSegmentHeader* header = static_cast<const SessionSegmentHeader*>(data);
+    if (header->magic != SESSION_LOG_MAGIC || header->version != SESSION_LOG_VERSION) {
+        munmap(data, size);
+        throw std::runtime_error(path + " is not a session segment");
+    }
+    segments.push_back({path, static_cast<const uint8_t*>(data), size});
+}
+
+bool SessionLogReader::loadIndex(uint32_t s, const SessionSegmentHeader& header) {
+    std::ifstream file(sessionIndexPath(segments[s].path), std::ios::binary);
+    if (!file) return false;
+
+    SessionIndexHeader index{};
+    if (!file.read(reinterpret_cast<char*>(&index), sizeof(index))) return false;
+    // A stale index (the segment was appended to after) is ignored
+    if (index.magic != SESSION_INDEX_MAGIC || index.version != SESSION_INDEX_VERSION ||
+        index.channelCount != names.size() || index.indexedBytes != header.usedBytes ||
+        index.indexedBytes > segments[s].size) {
+        return false;
+    }
+
+    std::vector<SessionIndexEntry> entries(index.blockCount);
+    std::vector<SessionChannelRange> ranges(index.blockCount * names.size());
+    if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(SessionIndexEntry)) ||
+        !file.read(reinterpret_cast<char*>(ranges.data()), ranges.size() * sizeof(SessionChannelRange))) {
+        return false;
+    }
+    for (const SessionIndexEntry& entry : entries) {
+        if (entry.offset < header.headerBytes || entry.offset + sizeof(SessionBlockHeader) > index.indexedBytes) {
+            return false;
+        }
+    }
+
+    for (const SessionIndexEntry& entry : entries) {
+        blockTable.push_back({s, entry.offset, entry.sampleCount, entry.firstTimestampNs, entry.lastTimestampNs});
+    }
+    rangeTable.insert(rangeTable.end(), ranges.begin(), ranges.end());
+    return true;
+}
+
+void SessionLogReader::scanBlocks(uint32_t s, const SessionSegmentHeader& header) {
+    const Segment& segment = segments[s];
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // A segment that was never closed still has its preallocated tail,
+    // only trust what the last sync published
+    size_t end = std::min<size_t>(header.usedBytes, segment.size);
+    size_t offset = header.headerBytes;
+    while (offset + sizeof(SessionBlockHeader) <= end) {
+        SessionBlockHeader block;
+        std::memcpy(&block, segment.data + offset, sizeof(block));
+        if (block.magic != SESSION_BLOCK_MAGIC || offset + sizeof(block) + block.payloadBytes > end) {
+            std::cerr << segment.path << ": stopping at a bad block at offset " << offset << std::endl;
+            break;
+        }
+        blockTable.push_back({s, offset, block.sampleCount, block.firstTimestampNs, block.lastTimestampNs});
+        rangeTable.resize(rangeTable.size() + names.size(), {-inf, inf});
+        offset += sizeof(block) + block.payloadBytes;
+    }
+}
+
+uint64_t SessionLogReader::sampleCount() const {
+    uint64_t total = 0;
+    for (const BlockRef& block : blockTable) total += block.sampleCount;
+    return total;
+}
+
+int64_t SessionLogReader::firstTimestampNs() const {
+    return blockTable.empty() ? sessionStartNs : blockTable.front().firstTimestampNs;
+}
+
+int64_t SessionLogReader::lastTimestampNs() const {
+    return blockTable.empty() ? sessionStartNs : blockTable.back().lastTimestampNs;
+}
+
+size_t SessionLogReader::findBlock(int64_t timestampNs) const {
+    auto it = std::partition_point(blockTable.begin(), blockTable.end(),
+                                   [timestampNs](const BlockRef& b) { return b.lastTimestampNs < timestampNs; });
+    return static_cast<size_t>(it - blockTable.begin());
+}
+
+bool SessionLogReader::readBlock(size_t index, SessionBlockView& view) const {
+    const BlockRef& ref = blockTable[index];
+    const uint8_t* base = segments[ref.segment].data + ref.offset;
+    SessionBlockHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != SESSION_BLOCK_MAGIC ||
+        ref.offset + sizeof(header) + header.payloadBytes > segments[ref.segment].size) {
+        return false;
+    }
+    const uint8_t* payload = base + sizeof(header);
+
+    view.firstNs = header.firstTimestampNs;
+    view.count = header.sampleCount;
+    if (header.encoding == SESSION_BLOCK_RAW) {
+        // Columns are 8 byte aligned in the mapping, use them in place
+        if (sessionRawPayloadBytes(view.count) > header.payloadBytes) return false;
+        view.values = reinterpret_cast<const double*>(payload);
+        view.offsetsUs = reinterpret_cast<const uint32_t*>(payload + view.count * sizeof(double));
+        view.channels = reinterpret_cast<const uint16_t*>(
+            payload + view.count * (sizeof(double) + sizeof(uint32_t)));
+        view.timestamps = nullptr;
+        return true;
+    }
+
+    if (!decodeSessionBlock(header, payload, view.decoded)) return false;
+    view.values = view.decoded.values.data();
+    view.channels = view.decoded.channels.data();
+    view.timestamps = view.decoded.timestampsNs.data();
+    view.offsetsUs = nullptr;
+    return true;
+}
+
+bool SessionLogReader::find(int channel, bool above, double threshold, int64_t fromNs, Match& match) const {
+    if (channel < 0 || static_cast<size_t>(channel) >= names.size()) return false;
+
+    SessionBlockView view;
+    for (size_t block = findBlock(fromNs); block < blockTable.size(); ++block) {
+        const SessionChannelRange& range = channelRange(block, channel);
+        if (range.min > range.max) continue;
+        if (above ? !(range.max > threshold) : !(range.min < threshold)) continue;
+
+        if (!readBlock(block, view)) continue;
+        // Raw blocks are in arrival order, take the earliest match
+        bool found = false;
+        for (size_t i = 0; i < view.count; ++i) {
+            if (view.channels[i] != channel) continue;
+            double value = view.values[i];
+            if (!(above ? value > threshold : value < threshold)) continue;
+            int64_t timestampNs = view.timestampNs(i);
+            if (timestampNs < fromNs || (found && timestampNs >= match.timestampNs)) continue;
+            match = {block, timestampNs, value};
+            found = true;
+        }
+        if (found) return true;
+    }
+    return false;
+}
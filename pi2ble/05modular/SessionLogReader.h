@@ -0,0 +1,109 @@
+#ifndef SESSION_LOG_READER_H
+#define SESSION_LOG_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SessionLog.h"
+#include "TimeSeriesCodec.h"
+
+// One block of a session, in place: RAW blocks point straight into the
+// read-only mapping, GORILLA blocks are decoded into reusable buffers.
+class SessionBlockView {
+private:
+    DecodedBlock decoded;
+    const uint32_t* offsetsUs = nullptr; // RAW only
+    const int64_t* timestamps = nullptr; // GORILLA only
+    int64_t firstNs = 0;
+
+    friend class SessionLogReader;
+
+public:
+    size_t count = 0;
+    const double* values = nullptr;
+    const uint16_t* channels = nullptr;
+
+    int64_t timestampNs(size_t i) const {
+        return timestamps ? timestamps[i] : firstNs + static_cast<int64_t>(offsetsUs[i]) * 1000;
+    }
+};
+
+// Read-only view of a recorded session (all its segments), mmapped.
+// Opening loads each segment's .tidx index into the block table; segments
+// without one (never closed) have their block headers walked instead.
+class SessionLogReader {
+public:
+    struct BlockRef {
+        uint32_t segment;
+        uint64_t offset; // of the SessionBlockHeader in the segment
+        uint32_t sampleCount;
+        int64_t firstTimestampNs;
+        int64_t lastTimestampNs;
+    };
+
+    struct Match {
+        size_t block;
+        int64_t timestampNs;
+        double value;
+    };
+
+private:
+    struct Segment {
+        std::string path;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    std::vector<Segment> segments;
+    std::vector<std::string> names;
+    std::vector<BlockRef> blockTable;
+    // Per block, per channel value range; unindexed blocks get -inf..inf
+    std::vector<SessionChannelRange> rangeTable;
+    size_t indexedSegmentCount = 0;
+    int64_t sessionStartNs = 0;
+    int64_t wallClockStartNs = 0;
+
+    void mapSegment(const std::string& path);
+    bool loadIndex(uint32_t segment, const SessionSegmentHeader& header);
+    void scanBlocks(uint32_t segment, const SessionSegmentHeader& header);
+    bool find(int channel, bool above, double threshold, int64_t fromNs, Match& match) const;
+
+public:
+    // Any segment of the session; the others are found by their index suffix
+    explicit SessionLogReader(const std::string& path);
+    ~SessionLogReader();
+    SessionLogReader(const SessionLogReader&) = delete;
+    SessionLogReader& operator=(const SessionLogReader&) = delete;
+
+    size_t channelCount() const { return names.size(); }
+    const std::string& channelName(int id) const { return names[id]; }
+    size_t segmentCount() const { return segments.size(); }
+    const std::string& segmentPath(size_t i) const { return segments[i].path; }
+    size_t indexedSegments() const { return indexedSegmentCount; }
+
+    const std::vector<BlockRef>& blocks() const { return blockTable; }
+    uint64_t sampleCount() const;
+    int64_t startNs() const { return sessionStartNs; }
+    int64_t firstTimestampNs() const;
+    int64_t lastTimestampNs() const;
+    int64_t wallClockNs(int64_t timestampNs) const { return wallClockStartNs + (timestampNs - sessionStartNs); }
+
+    // First block that may hold samples at or after timestampNs
+    size_t findBlock(int64_t timestampNs) const;
+    bool readBlock(size_t index, SessionBlockView& view) const;
+
+    const SessionChannelRange& channelRange(size_t block, int channel) const {
+        return rangeTable[block * names.size() + channel];
+    }
+    // First sample of channel at or after fromNs with a value above (below)
+    // threshold. Only blocks whose range allows a match are decoded.
+    bool findAbove(int channel, double threshold, int64_t fromNs, Match& match) const {
+        return find(channel, true, threshold, fromNs, match);
+    }
+    bool findBelow(int channel, double threshold, int64_t fromNs, Match& match) const {
+        return find(channel, false, threshold, fromNs, match);
+    }
+};
+
+#endif // SESSION_LOG_READER_H
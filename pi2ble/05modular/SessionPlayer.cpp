@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "LatencyHistogram.h"
+#include "SessionLogReader.h"
+#include "SessionReplay.h"
+#include "TelemetryStore.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Replays a recorded session into a TelemetryStore.
+//
+// Usage: ./SessionPlayer <segment.tlog> [speed|max] [startSeconds|channel>value|channel<value]
+//   speed 1 plays in real time with a render loop at video.framerate
+//   sampling the store (age at display is printed at the end); max
+//   publishes as fast as possible and reports pipeline throughput.
+//   channel>value starts where that channel first goes above value
+//   (e.g. coolant>105), found through the segment indexes.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <segment.tlog> [speed|max] [startSeconds|channel>value|channel<value]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        AppConfig appConfig = loadAppConfig();
+        std::string speedArg = argc > 2 ? argv[2] : "1";
+        double speed = speedArg == "max" ? 0.0 : std::stod(speedArg);
+        std::string startArg = argc > 3 ? argv[3] : "";
+
+        SessionLogReader log(argv[1]);
+        double lengthSeconds = (log.lastTimestampNs() - log.firstTimestampNs()) / 1e9;
+        std::cout << "Session: " << log.segmentCount() << " segments, " << log.blocks().size() << " blocks, "
+                  << log.sampleCount() << " samples, " << log.channelCount() << " channels, " << std::fixed
+                  << std::setprecision(1) << lengthSeconds << " s, " << log.indexedSegments() << " indexed"
+                  << std::endl;
+
+        int64_t startNs = 0;
+        size_t comparison = startArg.find_first_of("<>");
+        if (comparison != std::string::npos) {
+            std::string channel = startArg.substr(0, comparison);
+            double threshold = std::stod(startArg.substr(comparison + 1));
+            int id = -1;
+            for (size_t i = 0; i < log.channelCount(); ++i) {
+                if (log.channelName(static_cast<int>(i)) == channel) id = static_cast<int>(i);
+            }
+            if (id < 0) {
+                throw std::runtime_error("No channel " + channel + " in the session");
+            }
+
+            auto searchStart = Clock::now();
+            SessionLogReader::Match match{};
+            bool found = startArg[comparison] == '>' ? log.findAbove(id, threshold, 0, match)
+                                                     : log.findBelow(id, threshold, 0, match);
+            double searchMs = std::chrono::duration<double, std::milli>(Clock::now() - searchStart).count();
+            if (!found) {
+                std::cout << "No sample with " << startArg << " (searched in " << std::setprecision(2) << searchMs
+                          << " ms)" << std::endl;
+                return 0;
+            }
+            std::cout << startArg << " first at t=" << std::setprecision(3)
+                      << (match.timestampNs - log.firstTimestampNs()) / 1e9 << "s (" << channel << "="
+                      << match.value << ", block " << match.block << ", found in " << std::setprecision(2)
+                      << searchMs << " ms)" << std::endl;
+            startNs = match.timestampNs;
+        } else if (!startArg.empty() && std::stod(startArg) > 0) {
+            startNs = log.firstTimestampNs() + static_cast<int64_t>(std::stod(startArg) * 1e9);
+        }
+
+        std::vector<std::string> names;
+        for (size_t i = 0; i < log.channelCount(); ++i) names.push_back(log.channelName(static_cast<int>(i)));
+        TelemetryStore store(names);
+        SessionReplay replay(log, store, speed);
+        if (startNs > 0) {
+            replay.seek(startNs);
+        }
+
+        if (speed <= 0) {
+            std::atomic<bool> running{true};
+            auto start = Clock::now();
+            replay.run(running);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::cout << "Max speed: " << replay.samplesPublished << " samples from " << replay.blocksDecoded
+                      << " blocks in " << std::setprecision(3) << seconds << " s = " << std::setprecision(1)
+                      << replay.samplesPublished / seconds / 1e6 << " M samples/s ("
+                      << lengthSeconds / seconds << "x real time)" << std::endl;
+            return 0;
+        }
+
+        std::atomic<bool> running{true};
+        std::thread player([&] {
+            replay.run(running);
+            running = false;
+        });
+
+        DisplayLatency latency(store);
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(1, appConfig.video.framerate)));
+        auto next = Clock::now();
+        auto lastPrint = next;
+        while (running) {
+            std::this_thread::sleep_until(next);
+            next += period;
+
+            auto displayed = Clock::now();
+            for (size_t id = 0; id < store.channelCount(); ++id) {
+                TelemetrySample sample = store.latest(static_cast<int>(id));
+                if (sample.updates > 0) latency.record(static_cast<int>(id), sample.timestamp, displayed);
+            }
+
+            if (displayed - lastPrint >= std::chrono::seconds(1)) {
+                std::cout << std::setprecision(1) << "t=" << (replay.lastPublishedNs() - log.firstTimestampNs()) / 1e9
+                          << "s ";
+                for (size_t id = 0; id < std::min<size_t>(store.channelCount(), 6); ++id) {
+                    std::cout << " " << store.channelName(static_cast<int>(id)) << "="
+                              << store.latest(static_cast<int>(id)).value;
+                }
+                std::cout << std::endl;
+                lastPrint = displayed;
+            }
+        }
+        player.join();
+
+        std::cout << replay.samplesPublished << " samples replayed" << std::endl;
+        latency.printStats(std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,395 @@
+#include "SessionRecorder.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t PAGE_SIZE_BYTES = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+static size_t alignUp(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+// float bounds that still contain the double
+static float floatBelow(double v) {
+    float f = static_cast<float>(v);
+    return f > v ? std::nextafter(f, -INFINITY) : f;
+}
+
+static float floatAbove(double v) {
+    float f = static_cast<float>(v);
+    return f < v ? std::nextafter(f, INFINITY) : f;
+}
+
+static void writeAll(int fd, const void* data, size_t size, const std::string& path) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("Could not write " + path + ": " + std::strerror(errno));
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+SessionRecorder::SessionRecorder(const RecorderConfig& recorderConfig, const std::vector<std::string>& channelNames)
+    : config(recorderConfig), names(channelNames) {
+    if (names.size() > 0xFFFF) {
+        throw std::runtime_error("Session recorder supports at most 65535 channels");
+    }
+    if (config.queueCapacity < 1 || config.blockSamples < 1 || config.segmentMB < 1) {
+        throw std::runtime_error("Session recorder queueCapacity, blockSamples and segmentMB must be at least 1");
+    }
+
+    // A full raw block has to fit into an empty segment, or writeBlock would
+    // run past the mapping
+    segmentBytes = alignUp(static_cast<size_t>(config.segmentMB) << 20, PAGE_SIZE_BYTES);
+    headerBytes = alignUp(sizeof(SessionSegmentHeader) + names.size() * sizeof(SessionChannelName), 64);
+    size_t blockBytes = sizeof(SessionBlockHeader) + sessionRawPayloadBytes(static_cast<size_t>(config.blockSamples));
+    if (headerBytes + blockBytes > segmentBytes) {
+        throw std::runtime_error("Session recorder blocks of " + std::to_string(config.blockSamples) +
+                                 " samples don't fit into a " + std::to_string(config.segmentMB) + " MB segment");
+    }
+
+    size_t capacity = 1;
+    while (capacity < static_cast<size_t>(config.queueCapacity)) capacity <<= 1;
+    cells.reset(new Cell[capacity]);
+    cellMask = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+
+    blockValues.reserve(config.blockSamples);
+    blockTimestamps.reserve(config.blockSamples);
+    blockChannels.reserve(config.blockSamples);
+    blockOffsets.reserve(config.blockSamples);
+
+    if (config.encoding == "gorilla") {
+        compress = true;
+    } else if (config.encoding != "raw") {
+        throw std::runtime_error("Unknown recorder encoding " + config.encoding + " (raw or gorilla)");
+    }
+}
+
+static std::vector<std::string> channelNamesOf(const TelemetryStore& store) {
+    std::vector<std::string> names;
+    for (size_t id = 0; id < store.channelCount(); ++id) names.push_back(store.channelName(static_cast<int>(id)));
+    return names;
+}
+
+SessionRecorder::SessionRecorder(const RecorderConfig& recorderConfig, const TelemetryStore& store)
+    : SessionRecorder(recorderConfig, channelNamesOf(store)) {
+}
+
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+void SessionRecorder::start() {
+    if (running) return;
+
+    if (::mkdir(config.directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Could not create " + config.directory + ": " + std::strerror(errno));
+    }
+
+    auto steadyNow = Clock::now();
+    auto wallNow = std::chrono::system_clock::now();
+    sessionStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(steadyNow.time_since_epoch()).count();
+    wallClockStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(wallNow.time_since_epoch()).count();
+
+    std::time_t t = std::chrono::system_clock::to_time_t(wallNow);
+    std::tm local{};
+    localtime_r(&t, &local);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+    sessionName = config.prefix + "-" + stamp;
+
+    segmentIndex = 0;
+    openSegment();
+    lastSync = steadyNow;
+    running = true;
+    writer = std::thread(&SessionRecorder::writerLoop, this);
+}
+
+void SessionRecorder::stop() {
+    if (!running) return;
+    running = false;
+    writer.join();
+    closeSegment();
+}
+
+bool SessionRecorder::record(int id, double value, Clock::time_point timestamp) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & cellMask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            samplesDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->id = id;
+    cell->value = value;
+    cell->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+size_t SessionRecorder::drain() {
+    size_t taken = 0;
+    size_t room = static_cast<size_t>(config.blockSamples) - blockValues.size();
+    while (taken < room) {
+        Cell& cell = cells[dequeuePos & cellMask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+
+        if (blockValues.empty()) blockStarted = Clock::now();
+        blockValues.push_back(cell.value);
+        blockTimestamps.push_back(cell.timestampNs);
+        blockChannels.push_back(static_cast<uint16_t>(cell.id));
+
+        cell.sequence.store(dequeuePos + cellMask + 1, std::memory_order_release);
+        dequeuePos++;
+        taken++;
+    }
+    return taken;
+}
+
+void SessionRecorder::writerLoop() {
+    auto maxAge = std::chrono::milliseconds(config.blockMaxAgeMs);
+    auto syncInterval = std::chrono::milliseconds(config.syncIntervalMs);
+
+    try {
+        while (true) {
+            bool stopping = !running.load(std::memory_order_acquire);
+            size_t taken = drain();
+
+            auto now = Clock::now();
+            bool full = blockValues.size() >= static_cast<size_t>(config.blockSamples);
+            if (!blockValues.empty() && (full || now - blockStarted >= maxAge || (stopping && taken == 0))) {
+                writeBlock();
+            }
+            if (syncedUpTo < offset && now - lastSync >= syncInterval) {
+                sync();
+            }
+
+            if (stopping && taken == 0 && blockValues.empty()) break;
+            if (taken == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    } catch (const std::exception& e) {
+        // Recording stops, the drive goes on; producers see a full queue
+        std::cerr << "Session recorder stopped: " << e.what() << std::endl;
+    }
+}
+
+void SessionRecorder::writeBlock() {
+    size_t count = blockValues.size();
+    size_t payload = sessionRawPayloadBytes(count);
+    if (offset + sizeof(SessionBlockHeader) + payload > segmentBytes) {
+        closeSegment();
+        segmentIndex++;
+        openSegment();
+    }
+
+    int64_t first = blockTimestamps[0], last = blockTimestamps[0];
+    for (int64_t t : blockTimestamps) {
+        first = std::min(first, t);
+        last = std::max(last, t);
+    }
+
+    // Sample timestamps are kept to the microsecond (SessionLog.h)
+    blockOffsets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        blockOffsets[i] = static_cast<uint32_t>((blockTimestamps[i] - first) / 1000);
+    }
+
+    SessionBlockHeader header{};
+    header.magic = SESSION_BLOCK_MAGIC;
+    header.encoding = SESSION_BLOCK_RAW;
+    header.sampleCount = static_cast<uint32_t>(count);
+    header.firstTimestampNs = first;
+    header.lastTimestampNs = last;
+
+    // Compressed straight into the mapping; raw if it would come out bigger
+    uint8_t* p = mapping + offset + sizeof(header);
+    size_t compressed = 0;
+    if (compress) {
+        compressed = encoder.encode(blockValues.data(), blockOffsets.data(), blockChannels.data(), count, p, payload);
+    }
+    if (compressed > 0) {
+        header.encoding = SESSION_BLOCK_GORILLA;
+        payload = compressed;
+    } else {
+        std::memcpy(p, blockValues.data(), count * sizeof(double));
+        p += count * sizeof(double);
+        std::memcpy(p, blockOffsets.data(), count * sizeof(uint32_t));
+        p += count * sizeof(uint32_t);
+        std::memcpy(p, blockChannels.data(), count * sizeof(uint16_t));
+    }
+    header.payloadBytes = static_cast<uint32_t>(payload);
+    std::memcpy(mapping + offset, &header, sizeof(header));
+
+    indexEntries.push_back({offset, first, last, header.sampleCount, header.encoding, 0});
+    size_t rangeBase = indexRanges.size();
+    indexRanges.resize(rangeBase + names.size(), {INFINITY, -INFINITY});
+    SessionChannelRange* ranges = indexRanges.data() + rangeBase;
+    for (size_t i = 0; i < count; ++i) {
+        SessionChannelRange& range = ranges[blockChannels[i]];
+        range.min = std::min(range.min, floatBelow(blockValues[i]));
+        range.max = std::max(range.max, floatAbove(blockValues[i]));
+    }
+
+    offset += sizeof(header) + payload;
+    samplesWritten += count;
+    blocksWritten++;
+    bytesWritten += sizeof(header) + payload;
+
+    blockValues.clear();
+    blockTimestamps.clear();
+    blockChannels.clear();
+}
+
+void SessionRecorder::openSegment() {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "-%04u.tlog", segmentIndex);
+    std::string path = config.directory + "/" + sessionName + suffix;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create " + path + ": " + std::strerror(errno));
+    }
+
+    // Allocate the blocks up front so page faults in the mapping never
+    // have to find free space on the SD card
+    if (posix_fallocate(fd, 0, static_cast<off_t>(segmentBytes)) != 0 &&
+        ftruncate(fd, static_cast<off_t>(segmentBytes)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not preallocate " + path);
+    }
+
+    void* p = mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Could not map " + path);
+    }
+    mapping = static_cast<uint8_t*>(p);
+    madvise(mapping, segmentBytes, MADV_SEQUENTIAL);
+
+    SessionSegmentHeader header{};
+    header.magic = SESSION_LOG_MAGIC;
+    header.version = SESSION_LOG_VERSION;
+    header.channelCount = static_cast<uint32_t>(names.size());
+    header.segmentIndex = segmentIndex;
+    header.headerBytes = headerBytes;
+    header.usedBytes = headerBytes;
+    header.sessionStartNs = sessionStartNs;
+    header.wallClockStartNs = wallClockStartNs;
+    std::memcpy(mapping, &header, sizeof(header));
+
+    SessionChannelName* channelNames = reinterpret_cast<SessionChannelName*>(mapping + sizeof(header));
+    for (size_t i = 0; i < names.size(); ++i) {
+        std::strncpy(channelNames[i].name, names[i].c_str(), SESSION_LOG_NAME_LENGTH - 1);
+    }
+
+    offset = headerBytes;
+    syncedUpTo = 0;
+    indexEntries.clear();
+    indexRanges.clear();
+    segmentPaths.push_back(path);
+}
+
+void SessionRecorder::closeSegment() {
+    if (!mapping) return;
+
+    sync();
+    munmap(mapping, segmentBytes);
+    mapping = nullptr;
+
+    // Give back the unused preallocation
+    if (ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+        std::cerr << "Could not truncate " << segmentPaths.back() << std::endl;
+    }
+    ::close(fd);
+    fd = -1;
+
+    try {
+        writeIndex(segmentPaths.back());
+    } catch (const std::exception& e) {
+        // Readers fall back to walking the blocks
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void SessionRecorder::writeIndex(const std::string& segmentPath) {
+    std::string path = sessionIndexPath(segmentPath);
+    std::string temporary = path + ".tmp";
+
+    SessionIndexHeader header{};
+    header.magic = SESSION_INDEX_MAGIC;
+    header.version = SESSION_INDEX_VERSION;
+    header.channelCount = static_cast<uint32_t>(names.size());
+    header.segmentIndex = segmentIndex;
+    header.blockCount = indexEntries.size();
+    header.indexedBytes = offset;
+
+    int indexFd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (indexFd < 0) {
+        throw std::runtime_error("Could not create " + temporary + ": " + std::strerror(errno));
+    }
+    try {
+        writeAll(indexFd, &header, sizeof(header), temporary);
+        writeAll(indexFd, indexEntries.data(), indexEntries.size() * sizeof(SessionIndexEntry), temporary);
+        writeAll(indexFd, indexRanges.data(), indexRanges.size() * sizeof(SessionChannelRange), temporary);
+        fsync(indexFd);
+    } catch (...) {
+        ::close(indexFd);
+        std::remove(temporary.c_str());
+        throw;
+    }
+    ::close(indexFd);
+
+    // Appears complete or not at all
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Could not write " + path + ": " + std::strerror(errno));
+    }
+}
+
+void SessionRecorder::sync() {
+    auto before = Clock::now();
+
+    // Blocks first, then the header that makes them visible to readers
+    size_t from = syncedUpTo / PAGE_SIZE_BYTES * PAGE_SIZE_BYTES;
+    msync(mapping + from, offset - from, MS_SYNC);
+    reinterpret_cast<SessionSegmentHeader*>(mapping)->usedBytes = offset;
+    msync(mapping, PAGE_SIZE_BYTES, MS_SYNC);
+    syncedUpTo = offset;
+
+    lastSync = Clock::now();
+    syncs++;
+    maxSyncMs = std::max(maxSyncMs, std::chrono::duration<double, std::milli>(lastSync - before).count());
+}
+
+void SessionRecorder::printStats(std::ostream& out) const {
+    out << std::fixed << std::setprecision(1);
+    out << "=== Session recorder ===" << std::endl;
+    out << "samples written: " << samplesWritten << ", dropped: " << samplesDropped.load() << std::endl;
+    out << "blocks: " << blocksWritten << ", segments: " << segmentPaths.size() << ", "
+        << bytesWritten / (1024.0 * 1024.0) << " MiB" << std::endl;
+    out << "syncs: " << syncs << ", max sync: " << maxSyncMs << " ms" << std::endl;
+}
@@ -0,0 +1,108 @@
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "SessionLog.h"
+#include "TelemetryStore.h"
+#include "TimeSeriesCodec.h"
+
+// Records every published sample to preallocated, mmapped segment files
+// (format in SessionLog.h). Producers only push into a lock-free bounded
+// queue, no allocation or syscalls; a background thread packs samples
+// into columnar blocks (compressed with recorder.encoding: gorilla, see
+// TimeSeriesCodec.h), copies them into the mapping and msyncs in
+// batches every recorder.syncIntervalMs. Segments rotate when full and are
+// truncated to their used size when closed, then get their block index
+// (.tidx) written next to them.
+//
+// Attach with store.setTap(&recorder) to log a whole session.
+class SessionRecorder : public TelemetryTap {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        int id;
+        double value;
+        int64_t timestampNs;
+    };
+
+    RecorderConfig config;
+    std::vector<std::string> names;
+
+    // Bounded MPSC queue (Vyukov), producers claim cells with a CAS
+    std::unique_ptr<Cell[]> cells;
+    size_t cellMask;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;
+
+    // Block being filled by the writer thread
+    std::vector<double> blockValues;
+    std::vector<int64_t> blockTimestamps;
+    std::vector<uint16_t> blockChannels;
+    std::vector<uint32_t> blockOffsets;
+    bool compress = false;
+    GorillaBlockEncoder encoder;
+    std::chrono::steady_clock::time_point blockStarted;
+
+    // Current segment
+    int fd = -1;
+    uint8_t* mapping = nullptr;
+    size_t segmentBytes = 0;
+    size_t headerBytes = 0; // segment header and channel names, padded
+    size_t offset = 0;
+    size_t syncedUpTo = 0;
+    uint32_t segmentIndex = 0;
+    std::string sessionName;
+    int64_t sessionStartNs = 0;
+    int64_t wallClockStartNs = 0;
+    std::chrono::steady_clock::time_point lastSync;
+
+    // Index of the current segment, written out when it closes
+    std::vector<SessionIndexEntry> indexEntries;
+    std::vector<SessionChannelRange> indexRanges;
+
+    std::thread writer;
+    std::atomic<bool> running{false};
+
+    void writerLoop();
+    size_t drain();
+    void writeBlock();
+    void openSegment();
+    void closeSegment();
+    void writeIndex(const std::string& segmentPath);
+    void sync();
+
+public:
+    std::atomic<uint64_t> samplesDropped{0}; // queue full
+    uint64_t samplesWritten = 0;
+    uint64_t blocksWritten = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t syncs = 0;
+    double maxSyncMs = 0.0;
+    std::vector<std::string> segmentPaths;
+
+    SessionRecorder(const RecorderConfig& config, const std::vector<std::string>& channelNames);
+    SessionRecorder(const RecorderConfig& config, const TelemetryStore& store);
+    ~SessionRecorder() override;
+
+    void start();
+    // Drains the queue, writes the last block and closes the segment
+    void stop();
+
+    // Safe from any number of threads; false if the queue was full
+    bool record(int id, double value, std::chrono::steady_clock::time_point timestamp);
+    void onPublish(int id, double value, std::chrono::steady_clock::time_point timestamp) override {
+        record(id, value, timestamp);
+    }
+
+    void printStats(std::ostream& out) const;
+};
+
+#endif // SESSION_RECORDER_H
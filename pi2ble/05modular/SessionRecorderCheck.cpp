@@ -0,0 +1,120 @@
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+#include "SessionLogReader.h"
+#include "SessionRecorder.h"
+
+using Clock = std::chrono::steady_clock;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+static RecorderConfig recorderConfig(int segmentMB, int blockSamples, int queueCapacity) {
+    RecorderConfig config;
+    config.segmentMB = segmentMB;
+    config.blockSamples = blockSamples;
+    config.queueCapacity = queueCapacity;
+    return config;
+}
+
+static bool rejected(const RecorderConfig& config, const std::vector<std::string>& channels) {
+    try {
+        SessionRecorder recorder(config, channels);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+static bool yamlRejected(const std::string& recorderYaml) {
+    const std::string path = "SessionRecorderCheck-" + std::to_string(getpid()) + ".yaml";
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) throw std::runtime_error("Could not write " + path);
+    std::fputs(("recorder:\n" + recorderYaml).c_str(), file);
+    std::fclose(file);
+    bool threw = false;
+    try {
+        loadAppConfig(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(path.c_str());
+    return threw;
+}
+
+// Recorder and AppConfig settings that would overflow a segment or leave
+// the queue empty are rejected, and the largest block that fits an empty
+// segment is written and read back across segment rollovers.
+//
+// Usage: ./SessionRecorderCheck
+int main() {
+    char directory[] = "/tmp/session-recorder-check-XXXXXX";
+    if (!mkdtemp(directory)) {
+        std::cerr << "Could not create a temporary directory" << std::endl;
+        return 1;
+    }
+
+    try {
+        const std::vector<std::string> channels{"rpm", "speed"};
+        check(rejected(recorderConfig(1, 0, 1024), channels), "blockSamples 0 rejected");
+        check(rejected(recorderConfig(1, 1024, 0), channels), "queueCapacity 0 rejected");
+        check(rejected(recorderConfig(1, 1024, -1), channels), "negative queueCapacity rejected");
+        check(rejected(recorderConfig(0, 1024, 1024), channels), "segmentMB 0 rejected");
+        check(rejected(recorderConfig(1, 80000, 1024), channels), "a block bigger than a 1 MB segment rejected");
+        check(yamlRejected("  blockSamples: 0\n"), "AppConfig.yaml with blockSamples 0 rejected");
+        check(yamlRejected("  queueCapacity: -4\n"), "AppConfig.yaml with a negative queueCapacity rejected");
+
+        // 65536 raw samples are 896 KB, so every full block needs a segment of its own
+        const int blockSamples = 65536;
+        RecorderConfig config = recorderConfig(1, blockSamples, 1 << 18);
+        config.directory = directory;
+        config.encoding = "raw";
+        config.blockMaxAgeMs = 60000;
+        check(!rejected(config, channels), "the largest block that fits a 1 MB segment accepted");
+
+        const uint64_t samples = 3 * blockSamples;
+        std::vector<std::string> segments;
+        {
+            SessionRecorder recorder(config, channels);
+            recorder.start();
+            auto t = Clock::now();
+            for (uint64_t i = 0; i < samples; ++i) {
+                while (!recorder.record(static_cast<int>(i % 2), static_cast<double>(i), t)) {
+                    usleep(1000);
+                }
+                t += std::chrono::microseconds(1);
+            }
+            recorder.stop();
+            segments = recorder.segmentPaths;
+            check(recorder.samplesWritten == samples && recorder.blocksWritten == 3, "three full blocks written");
+        }
+
+        {
+            SessionLogReader reader(segments.front());
+            check(reader.segmentCount() == 3 && reader.sampleCount() == samples,
+                  "one block per segment, every sample read back");
+        }
+        for (const std::string& segment : segments) {
+            std::remove(segment.c_str());
+            std::remove(sessionIndexPath(segment).c_str());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        rmdir(directory);
+        return 1;
+    }
+    rmdir(directory);
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
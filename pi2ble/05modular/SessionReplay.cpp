@@ -0,0 +1,140 @@
+#include "SessionReplay.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+SessionReplay::SessionReplay(const SessionLogReader& sessionLog, TelemetryStore& telemetryStore, double replaySpeed)
+    : log(sessionLog), store(telemetryStore), speed(replaySpeed) {
+    for (size_t i = 0; i < log.channelCount(); ++i) {
+        storeIds.push_back(store.channelId(log.channelName(static_cast<int>(i))));
+    }
+    logAnchorNs = log.firstTimestampNs();
+    wallAnchor = Clock::now();
+}
+
+bool SessionReplay::ready() {
+    while (blockIndex < log.blocks().size()) {
+        if (!blockLoaded) {
+            if (!log.readBlock(blockIndex, view)) {
+                std::cerr << "Skipping undecodable block " << blockIndex << std::endl;
+                view.count = 0;
+            }
+            blockLoaded = true;
+            sampleIndex = 0;
+            blocksDecoded++;
+        }
+        if (sampleIndex < view.count) return true;
+        blockIndex++;
+        blockLoaded = false;
+    }
+    return false;
+}
+
+SessionReplay::Clock::time_point SessionReplay::scheduledAt(int64_t timestampNs) const {
+    double wallNs = static_cast<double>(timestampNs - logAnchorNs) / speed;
+    return wallAnchor + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(wallNs));
+}
+
+void SessionReplay::setSpeed(double newSpeed) {
+    logAnchorNs = positionNs();
+    wallAnchor = Clock::now();
+    speed = newSpeed;
+}
+
+int64_t SessionReplay::positionNs() {
+    return ready() ? view.timestampNs(sampleIndex) : log.lastTimestampNs();
+}
+
+bool SessionReplay::seek(int64_t timestampNs) {
+    blockIndex = log.findBlock(timestampNs);
+    blockLoaded = false;
+    while (ready() && view.timestampNs(sampleIndex) < timestampNs) sampleIndex++;
+
+    primeChannels(timestampNs);
+    logAnchorNs = timestampNs;
+    wallAnchor = Clock::now();
+    return ready();
+}
+
+// Publishes each channel's last value before timestampNs, looking back a
+// bounded number of blocks (channels silent for longer stay as they are)
+void SessionReplay::primeChannels(int64_t timestampNs) {
+    const size_t maxBlocksBack = 64;
+    if (log.blocks().empty()) return;
+    std::vector<bool> found(storeIds.size(), false);
+    size_t missing = 0;
+    for (int id : storeIds) missing += id >= 0;
+
+    SessionBlockView scratch;
+    auto now = Clock::now();
+    size_t last = std::min(blockIndex, log.blocks().size() - 1);
+    for (size_t back = 0; missing > 0 && back < maxBlocksBack && back <= last; ++back) {
+        if (!log.readBlock(last - back, scratch)) continue;
+        for (size_t i = scratch.count; i-- > 0 && missing > 0;) {
+            uint16_t channel = scratch.channels[i];
+            if (channel >= storeIds.size() || found[channel] || storeIds[channel] < 0) continue;
+            if (scratch.timestampNs(i) >= timestampNs) continue;
+            store.publish(storeIds[channel], scratch.values[i], now);
+            found[channel] = true;
+            missing--;
+        }
+    }
+}
+
+SessionReplay::Clock::time_point SessionReplay::nextDue() {
+    if (!ready()) return Clock::time_point::max();
+    return speed > 0 ? scheduledAt(view.timestampNs(sampleIndex)) : Clock::now();
+}
+
+size_t SessionReplay::publishDue(Clock::time_point now) {
+    size_t published = 0;
+    int64_t timestampNs = 0;
+    while (ready()) {
+        timestampNs = view.timestampNs(sampleIndex);
+        Clock::time_point at = now;
+        if (speed > 0) {
+            at = scheduledAt(timestampNs);
+            if (at > now) break;
+        }
+
+        uint16_t channel = view.channels[sampleIndex];
+        if (channel < storeIds.size() && storeIds[channel] >= 0) {
+            store.publish(storeIds[channel], view.values[sampleIndex], at);
+        }
+        sampleIndex++;
+        published++;
+
+        // At max speed hand control back once per block
+        if (speed <= 0 && sampleIndex >= view.count) break;
+    }
+    if (published > 0) lastPublished.store(timestampNs, std::memory_order_relaxed);
+    samplesPublished += published;
+    return published;
+}
+
+size_t SessionReplay::publishUntil(int64_t timestampNs) {
+    size_t published = 0;
+    while (ready() && view.timestampNs(sampleIndex) <= timestampNs) {
+        int64_t sampleNs = view.timestampNs(sampleIndex);
+        uint16_t channel = view.channels[sampleIndex];
+        if (channel < storeIds.size() && storeIds[channel] >= 0) {
+            store.publish(storeIds[channel], view.values[sampleIndex],
+                          Clock::time_point(std::chrono::nanoseconds(sampleNs)));
+        }
+        lastPublished.store(sampleNs, std::memory_order_relaxed);
+        sampleIndex++;
+        published++;
+    }
+    samplesPublished += published;
+    return published;
+}
+
+void SessionReplay::run(const std::atomic<bool>& running) {
+    while (running && ready()) {
+        if (speed > 0) {
+            // Wake at least every 50 ms so a stop request isn't held up by a long gap
+            std::this_thread::sleep_until(std::min(nextDue(), Clock::now() + std::chrono::milliseconds(50)));
+        }
+        publishDue(Clock::now());
+    }
+}
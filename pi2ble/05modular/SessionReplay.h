@@ -0,0 +1,74 @@
+#ifndef SESSION_REPLAY_H
+#define SESSION_REPLAY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "SessionLogReader.h"
+#include "TelemetryStore.h"
+
+// Plays a recorded session back into a TelemetryStore, the same way the live
+// ingress sources publish, so the renderer can't tell the difference.
+// Channels are matched by name; recorded channels the store doesn't have
+// are skipped.
+//
+// Samples go out in log order, so a session always replays the same
+// sequence. speed 1.0 follows the original timeline, N plays N times faster
+// and 0 publishes as fast as possible (pipeline throughput). Paced samples
+// are stamped with the time they were scheduled for, max speed ones with
+// the time they were published.
+class SessionReplay {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const SessionLogReader& log;
+    TelemetryStore& store;
+    std::vector<int> storeIds; // log channel -> store channel, -1 if absent
+    double speed;
+
+    size_t blockIndex = 0;
+    size_t sampleIndex = 0;
+    bool blockLoaded = false;
+    SessionBlockView view;
+
+    // Playback clock: log time logAnchorNs plays at wall time wallAnchor
+    int64_t logAnchorNs = 0;
+    Clock::time_point wallAnchor;
+    std::atomic<int64_t> lastPublished{0};
+
+    bool ready(); // loads blocks until one has a sample left
+    Clock::time_point scheduledAt(int64_t timestampNs) const;
+    void primeChannels(int64_t timestampNs);
+
+public:
+    uint64_t samplesPublished = 0;
+    uint64_t blocksDecoded = 0;
+
+    SessionReplay(const SessionLogReader& log, TelemetryStore& store, double speed = 1.0);
+
+    double getSpeed() const { return speed; }
+    void setSpeed(double newSpeed);
+
+    // Positions at the first sample at or after timestampNs (log clock) and
+    // publishes each channel's last value before it, so the display is
+    // right straight away. Returns false past the end of the log.
+    bool seek(int64_t timestampNs);
+    int64_t positionNs();
+    // Log time of the last published sample, safe to read from other threads
+    int64_t lastPublishedNs() const { return lastPublished.load(std::memory_order_relaxed); }
+    bool finished() const { return blockIndex >= log.blocks().size(); }
+
+    // When the next sample is due (paced mode)
+    Clock::time_point nextDue();
+    // Publishes every sample due at now; at max speed the rest of the
+    // current block. Returns how many were published.
+    size_t publishDue(Clock::time_point now);
+    // Publishes every sample logged up to timestampNs, stamped with its
+    // log time, for consumers on their own clock (e.g. video frame PTS)
+    size_t publishUntil(int64_t timestampNs);
+    // Until the log ends or running goes false
+    void run(const std::atomic<bool>& running);
+};
+
+#endif // SESSION_REPLAY_H
@@ -0,0 +1,306 @@
+#include "SharedTelemetryBus.h"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(std::atomic<double>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain uint32_t");
+
+static size_t align64(size_t n) {
+    return (n + 63) & ~static_cast<size_t>(63);
+}
+
+static size_t ringStrideFor(size_t ringCapacity) {
+    return align64(sizeof(ShmRingHeader) + ringCapacity * sizeof(ShmRingEntry));
+}
+
+size_t shmBusSize(size_t channels, size_t ringCapacity) {
+    return align64(sizeof(ShmBusHeader)) + align64(channels * sizeof(ShmChannelName)) +
+           channels * sizeof(ShmSlot) + channels * ringStrideFor(ringCapacity);
+}
+
+ShmBusView shmBusView(void* base) {
+    ShmBusView view;
+    uint8_t* p = static_cast<uint8_t*>(base);
+    view.header = reinterpret_cast<ShmBusHeader*>(p);
+    size_t channels = view.header->channelCount;
+
+    p += align64(sizeof(ShmBusHeader));
+    view.names = reinterpret_cast<ShmChannelName*>(p);
+    p += align64(channels * sizeof(ShmChannelName));
+    view.slots = reinterpret_cast<ShmSlot*>(p);
+    p += channels * sizeof(ShmSlot);
+    view.rings = p;
+    view.ringStride = ringStrideFor(view.header->ringCapacity);
+    return view;
+}
+
+static int futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) {
+    // Not FUTEX_PRIVATE_FLAG: the waiters live in other processes
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0));
+}
+
+ShmBusWriter::ShmBusWriter(const std::string& busName, const std::vector<std::string>& channelNames,
+                           size_t ringCapacity)
+    : name(busName) {
+    size_t capacity = 1;
+    while (capacity < ringCapacity) capacity <<= 1;
+    ringMask = static_cast<uint32_t>(capacity - 1);
+    size = shmBusSize(channelNames.size(), capacity);
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open shared memory " + name + ": " + std::strerror(errno));
+    }
+
+    // Re-attach to the object a previous writer left behind if it has the
+    // same layout, so readers don't have to re-map after an ingest restart
+    struct stat st{};
+    fstat(fd, &st);
+    bool compatible = false;
+    if (static_cast<size_t>(st.st_size) == size) {
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            view = shmBusView(mapping);
+            compatible = view.header->magic == SHM_BUS_MAGIC && view.header->version == SHM_BUS_VERSION &&
+                         view.header->channelCount == channelNames.size() && view.header->ringCapacity == capacity;
+            for (size_t i = 0; compatible && i < channelNames.size(); ++i) {
+                compatible = channelNames[i].compare(0, SHM_BUS_NAME_LENGTH - 1, view.names[i].name) == 0;
+            }
+            if (!compatible) munmap(mapping, size);
+        }
+    }
+    if (compatible) repair();
+
+    if (!compatible) {
+        // Start over with a fresh object; readers of the old one notice the
+        // missing heartbeat and re-open
+        ::close(fd);
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            if (fd >= 0) ::close(fd);
+            throw std::runtime_error("Could not create shared memory " + name + ": " + std::strerror(errno));
+        }
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Could not map shared memory " + name);
+        }
+
+        std::memset(mapping, 0, size);
+        ShmBusHeader* header = static_cast<ShmBusHeader*>(mapping);
+        header->version = SHM_BUS_VERSION;
+        header->channelCount = static_cast<uint32_t>(channelNames.size());
+        header->ringCapacity = static_cast<uint32_t>(capacity);
+        header->totalSize = size;
+        view = shmBusView(mapping);
+        for (size_t i = 0; i < channelNames.size(); ++i) {
+            std::strncpy(view.names[i].name, channelNames[i].c_str(), SHM_BUS_NAME_LENGTH - 1);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = SHM_BUS_MAGIC;
+    }
+    ::close(fd);
+
+    view.header->writerEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A writer that died inside publish() leaves its slot's seq odd; every
+// later write would keep it odd and readers would wait on it forever. The
+// half-written value is taken as it is. The ring entry it was rewriting,
+// and any entry whose seq doesn't match its place below head, is marked
+// invalid (seq 0) so readers count it as lost.
+void ShmBusWriter::repair() {
+    uint64_t capacity = ringMask + 1ull;
+    for (uint32_t id = 0; id < view.header->channelCount; ++id) {
+        ShmSlot& slot = view.slots[id];
+        uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+        if (seq & 1) slot.seq.store((seq + 1) & ~1u, std::memory_order_release);
+
+        uint64_t head = view.ring(id)->head.load(std::memory_order_relaxed);
+        ShmRingEntry* entries = view.entries(id);
+        for (uint64_t position = 0; position < capacity; ++position) {
+            uint64_t entrySeq = entries[position].seq.load(std::memory_order_relaxed);
+            bool valid = entrySeq != 0 && entrySeq <= head && entrySeq + capacity > head &&
+                         ((entrySeq - 1) & ringMask) == position;
+            if (!valid && entrySeq != 0) entries[position].seq.store(0, std::memory_order_release);
+        }
+    }
+}
+
+ShmBusWriter::~ShmBusWriter() {
+    if (mapping && mapping != MAP_FAILED) munmap(mapping, size);
+}
+
+int ShmBusWriter::channelId(const std::string& channel) const {
+    for (uint32_t i = 0; i < view.header->channelCount; ++i) {
+        if (channel.compare(0, SHM_BUS_NAME_LENGTH - 1, view.names[i].name) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void ShmBusWriter::publish(int id, double value, std::chrono::steady_clock::time_point timestamp) {
+    int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+
+    // Latest value, same seqlock as TelemetryStore
+    ShmSlot& slot = view.slots[id];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    slot.updates.store(slot.updates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    // Ring entry, marked incomplete while it is rewritten
+    ShmRingHeader* ring = view.ring(id);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ShmRingEntry& entry = view.entries(id)[head & ringMask];
+    entry.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.value.store(value, std::memory_order_relaxed);
+    entry.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    entry.seq.store(head + 1, std::memory_order_release);
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void ShmBusWriter::notify() {
+    view.header->heartbeatNs.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                   std::memory_order_relaxed);
+    view.header->generation.fetch_add(1, std::memory_order_release);
+    futex(&view.header->generation, FUTEX_WAKE, INT_MAX, nullptr);
+}
+
+void ShmBusWriter::unlink() {
+    shm_unlink(name.c_str());
+}
+
+ShmBusReader::ShmBusReader(const std::string& busName) {
+    int fd = shm_open(busName.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open shared memory " + busName + ": " + std::strerror(errno));
+    }
+
+    struct stat st{};
+    fstat(fd, &st);
+    size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(ShmBusHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory " + busName + " is not initialized");
+    }
+
+    mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map shared memory " + busName);
+    }
+
+    const ShmBusHeader* header = static_cast<const ShmBusHeader*>(mapping);
+    if (header->magic != SHM_BUS_MAGIC || header->version != SHM_BUS_VERSION || header->totalSize != size) {
+        munmap(mapping, size);
+        throw std::runtime_error("Shared memory " + busName + " is not a compatible telemetry bus");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    view = shmBusView(mapping);
+    ringMask = view.header->ringCapacity - 1;
+}
+
+ShmBusReader::~ShmBusReader() {
+    if (mapping && mapping != MAP_FAILED) munmap(mapping, size);
+}
+
+std::string ShmBusReader::channelName(int id) const {
+    return std::string(view.names[id].name, strnlen(view.names[id].name, SHM_BUS_NAME_LENGTH));
+}
+
+int ShmBusReader::channelId(const std::string& channel) const {
+    for (uint32_t i = 0; i < view.header->channelCount; ++i) {
+        if (channel.compare(0, SHM_BUS_NAME_LENGTH - 1, view.names[i].name) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+TelemetrySample ShmBusReader::latest(int id) const {
+    const ShmSlot& slot = view.slots[id];
+    TelemetrySample sample;
+    uint32_t before, after;
+
+    do {
+        before = slot.seq.load(std::memory_order_acquire);
+        sample.value = slot.value.load(std::memory_order_relaxed);
+        sample.timestamp = std::chrono::steady_clock::time_point(
+            std::chrono::nanoseconds(slot.timestampNs.load(std::memory_order_relaxed)));
+        sample.updates = slot.updates.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return sample;
+}
+
+bool ShmBusReader::next(int id, uint64_t& cursor, TelemetrySample& sample) {
+    const ShmRingHeader* ring = view.ring(id);
+    const ShmRingEntry* entries = view.entries(id);
+    uint64_t capacity = ringMask + 1ull;
+
+    while (true) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (cursor >= head) return false;
+        if (head - cursor > capacity) {
+            overruns += head - capacity - cursor;
+            cursor = head - capacity;
+        }
+
+        const ShmRingEntry& entry = entries[cursor & ringMask];
+        uint64_t before = entry.seq.load(std::memory_order_acquire);
+        sample.value = entry.value.load(std::memory_order_relaxed);
+        int64_t timestampNs = entry.timestampNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = entry.seq.load(std::memory_order_relaxed);
+
+        if (before == cursor + 1 && after == before) {
+            sample.timestamp = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(timestampNs));
+            sample.updates = cursor + 1;
+            cursor++;
+            return true;
+        }
+
+        // Overwritten while we were reading it
+        overruns++;
+        cursor++;
+    }
+}
+
+uint64_t ShmBusReader::tail(int id) const {
+    return view.ring(id)->head.load(std::memory_order_acquire);
+}
+
+uint32_t ShmBusReader::generation() const {
+    return view.header->generation.load(std::memory_order_acquire);
+}
+
+uint32_t ShmBusReader::wait(uint32_t seen, int timeoutMs) const {
+    uint32_t current = generation();
+    if (current != seen) return current;
+
+    timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    futex(&view.header->generation, FUTEX_WAIT, seen, &timeout);
+    return generation();
+}
+
+bool ShmBusReader::writerAlive(std::chrono::milliseconds maxSilence) const {
+    int64_t heartbeat = view.header->heartbeatNs.load(std::memory_order_relaxed);
+    auto last = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(heartbeat));
+    return heartbeat != 0 && std::chrono::steady_clock::now() - last <= maxSilence;
+}
@@ -0,0 +1,135 @@
+#ifndef SHARED_TELEMETRY_BUS_H
+#define SHARED_TELEMETRY_BUS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TelemetryStore.h"
+
+// Telemetry bus in POSIX shared memory, so a crashing ingest process can't
+// take the renderer down with it.
+//
+// Layout of the shm object:
+//   ShmBusHeader
+//   ShmChannelName[channelCount]
+//   ShmSlot[channelCount]                      latest value per channel (seqlock)
+//   (ShmRingHeader + ShmRingEntry[ringCapacity])[channelCount]
+//
+// There is one writer (ingest). Readers map the object read-only, so they
+// keep their own ring cursors and never write to shared state; a reader
+// that falls more than ringCapacity samples behind skips ahead. Waiting is
+// a futex on the header's generation word, bumped by ShmBusWriter::notify().
+// A restarted writer re-attaches to a compatible existing object, so
+// readers keep their mapping across ingest crashes, and first repairs a
+// slot or ring entry the crashed writer left half written.
+
+constexpr uint32_t SHM_BUS_MAGIC = 0x54425553; // "TBUS"
+constexpr uint32_t SHM_BUS_VERSION = 1;
+constexpr size_t SHM_BUS_NAME_LENGTH = 32;
+
+struct ShmBusHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t channelCount;
+    uint32_t ringCapacity;
+    uint64_t totalSize;
+    std::atomic<uint32_t> generation;  // futex word
+    std::atomic<uint32_t> writerEpoch; // bumped every time a writer attaches
+    std::atomic<int64_t> heartbeatNs;  // steady_clock time of the last notify()
+};
+
+struct ShmChannelName {
+    char name[SHM_BUS_NAME_LENGTH];
+};
+
+struct alignas(64) ShmSlot {
+    std::atomic<uint32_t> seq;
+    std::atomic<double> value;
+    std::atomic<int64_t> timestampNs;
+    std::atomic<uint64_t> updates;
+};
+
+struct alignas(64) ShmRingHeader {
+    std::atomic<uint64_t> head; // samples ever written
+};
+
+struct ShmRingEntry {
+    std::atomic<uint64_t> seq; // index + 1 once complete, 0 while being written
+    std::atomic<double> value;
+    std::atomic<int64_t> timestampNs;
+};
+
+// Pointers into one mapping of the bus
+struct ShmBusView {
+    ShmBusHeader* header = nullptr;
+    ShmChannelName* names = nullptr;
+    ShmSlot* slots = nullptr;
+    uint8_t* rings = nullptr;
+    size_t ringStride = 0;
+
+    ShmRingHeader* ring(int id) const { return reinterpret_cast<ShmRingHeader*>(rings + ringStride * id); }
+    ShmRingEntry* entries(int id) const { return reinterpret_cast<ShmRingEntry*>(ring(id) + 1); }
+};
+
+// Bytes of a bus object; each section starts on a 64 byte boundary
+size_t shmBusSize(size_t channels, size_t ringCapacity);
+// The sections of a mapping, from the channel count and ring capacity in its header
+ShmBusView shmBusView(void* base);
+
+class ShmBusWriter {
+private:
+    std::string name;
+    void* mapping = nullptr;
+    size_t size = 0;
+    ShmBusView view;
+    uint32_t ringMask;
+
+    // On re-attach: undo what a writer that crashed mid-publish left behind
+    void repair();
+
+public:
+    ShmBusWriter(const std::string& name, const std::vector<std::string>& channelNames, size_t ringCapacity);
+    ~ShmBusWriter();
+
+    int channelId(const std::string& channel) const;
+    void publish(int id, double value, std::chrono::steady_clock::time_point timestamp);
+    // Wakes readers; call once per batch of publishes
+    void notify();
+    // Remove the shm object (it otherwise outlives both processes)
+    void unlink();
+};
+
+class ShmBusReader {
+private:
+    void* mapping = nullptr;
+    size_t size = 0;
+    ShmBusView view;
+    uint32_t ringMask;
+
+public:
+    uint64_t overruns = 0; // samples lost because this reader fell behind
+
+    explicit ShmBusReader(const std::string& name);
+    ~ShmBusReader();
+
+    size_t channelCount() const { return view.header->channelCount; }
+    std::string channelName(int id) const;
+    int channelId(const std::string& channel) const;
+
+    TelemetrySample latest(int id) const;
+    // Next unread ring sample of a channel; false once caught up
+    bool next(int id, uint64_t& cursor, TelemetrySample& sample);
+    // Cursor that only sees samples published from now on
+    uint64_t tail(int id) const;
+
+    uint32_t generation() const;
+    // Blocks until the generation moves past `seen` or the timeout expires
+    uint32_t wait(uint32_t seen, int timeoutMs) const;
+    // False if the writer hasn't notified within maxSilence
+    bool writerAlive(std::chrono::milliseconds maxSilence) const;
+};
+
+#endif // SHARED_TELEMETRY_BUS_H
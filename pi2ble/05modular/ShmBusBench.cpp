@@ -0,0 +1,215 @@
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AppConfig.h"
+#include "SharedTelemetryBus.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    uint64_t samples = 0;
+    uint64_t lost = 0;
+    double seconds = 0.0;
+    std::vector<uint32_t> latencyNs;
+};
+
+struct QueuedSample {
+    int id;
+    double value;
+    Clock::time_point timestamp;
+};
+
+// Baseline: the in-process way, a mutex/condvar protected queue between
+// an ingest thread and a render thread
+class SampleQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<QueuedSample> samples;
+    bool closed = false;
+
+public:
+    void push(const QueuedSample* batch, size_t count) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            samples.insert(samples.end(), batch, batch + count);
+        }
+        ready.notify_one();
+    }
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_one();
+    }
+    // Swaps everything queued into out, false once closed and empty
+    bool popAll(std::deque<QueuedSample>& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return closed || !samples.empty(); });
+        out.swap(samples);
+        return !(closed && out.empty());
+    }
+};
+
+// Publishes `channels` samples per tick, at rateHz or as fast as possible
+// when rateHz is 0, calling flush() after every tick
+template <typename Publish, typename Flush>
+static void produce(int seconds, int channels, int rateHz, Publish publish, Flush flush) {
+    auto start = Clock::now();
+    auto end = start + std::chrono::seconds(seconds);
+    auto next = start;
+    auto period = rateHz > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz))
+                             : Clock::duration::zero();
+    double value = 0.0;
+
+    while (true) {
+        if (rateHz > 0) {
+            std::this_thread::sleep_until(next);
+            next += period;
+        }
+        auto now = Clock::now();
+        if (now >= end) break;
+        for (int id = 0; id < channels; ++id) {
+            publish(id, value, now);
+        }
+        flush();
+        value += 1.0;
+    }
+}
+
+static BenchResult benchQueue(int seconds, int channels, int rateHz) {
+    SampleQueue queue;
+    BenchResult result;
+    result.latencyNs.reserve(rateHz > 0 ? static_cast<size_t>(seconds) * rateHz * channels : 0);
+
+    std::thread consumer([&] {
+        std::deque<QueuedSample> batch;
+        while (queue.popAll(batch)) {
+            auto now = Clock::now();
+            for (const auto& sample : batch) {
+                if (result.latencyNs.size() < result.latencyNs.capacity()) {
+                    result.latencyNs.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - sample.timestamp).count()));
+                }
+            }
+            result.samples += batch.size();
+            batch.clear();
+        }
+    });
+
+    std::vector<QueuedSample> tick;
+    tick.reserve(channels);
+    auto start = Clock::now();
+    produce(seconds, channels, rateHz,
+            [&](int id, double value, Clock::time_point t) { tick.push_back({id, value, t}); },
+            [&] { queue.push(tick.data(), tick.size()); tick.clear(); });
+    queue.close();
+    consumer.join();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+static BenchResult benchSharedMemory(const BusConfig& config, int seconds, int channels, int rateHz) {
+    std::vector<std::string> names;
+    for (int i = 0; i < channels; ++i) names.push_back("ch" + std::to_string(i));
+
+    // The writer mapping is inherited by the forked ingest process
+    ShmBusWriter writer(config.name, names, static_cast<size_t>(config.ringCapacity));
+    ShmBusReader reader(config.name);
+    std::vector<uint64_t> cursors(channels);
+    for (int id = 0; id < channels; ++id) cursors[id] = reader.tail(id);
+
+    BenchResult result;
+    result.latencyNs.reserve(rateHz > 0 ? static_cast<size_t>(seconds) * rateHz * channels : 0);
+
+    auto start = Clock::now();
+    pid_t child = fork();
+    if (child == 0) {
+        produce(seconds, channels, rateHz,
+                [&](int id, double value, Clock::time_point t) { writer.publish(id, value, t); },
+                [&] { writer.notify(); });
+        _exit(0);
+    }
+
+    bool producing = true;
+    uint32_t generation = reader.generation();
+    TelemetrySample sample;
+    while (true) {
+        generation = reader.wait(generation, 50);
+
+        for (int id = 0; id < channels; ++id) {
+            while (reader.next(id, cursors[id], sample)) {
+                if (result.latencyNs.size() < result.latencyNs.capacity()) {
+                    // Per sample: the writer keeps publishing while we drain
+                    auto now = Clock::now();
+                    result.latencyNs.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - sample.timestamp).count()));
+                }
+                result.samples++;
+            }
+        }
+
+        if (!producing) break; // one last drain after the writer exited
+        int status;
+        if (waitpid(child, &status, WNOHANG) == child) producing = false;
+    }
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.lost = reader.overruns;
+    writer.unlink();
+    return result;
+}
+
+static void printResult(const std::string& label, BenchResult& result) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << result.samples / result.seconds << " samples/s";
+    if (result.lost > 0) std::cout << ", " << result.lost << " lost to overrun";
+    if (!result.latencyNs.empty()) {
+        std::sort(result.latencyNs.begin(), result.latencyNs.end());
+        std::cout << std::setprecision(1) << ", latency p50 " << result.latencyNs[result.latencyNs.size() / 2] / 1000.0
+                  << " us, p99 " << result.latencyNs[result.latencyNs.size() * 99 / 100] / 1000.0
+                  << " us, max " << result.latencyNs.back() / 1000.0 << " us";
+    }
+    std::cout << std::endl;
+}
+
+// In-process queue vs cross-process shared memory bus.
+//
+// Usage: ./ShmBusBench [seconds] [channels] [rateHz]
+// Latency is measured at rateHz ticks (every channel published each tick),
+// throughput with the producer running flat out.
+int main(int argc, char* argv[]) {
+    try {
+        AppConfig appConfig = loadAppConfig();
+        int seconds = argc > 1 ? std::stoi(argv[1]) : 3;
+        int channels = argc > 2 ? std::stoi(argv[2]) : 100;
+        int rateHz = argc > 3 ? std::stoi(argv[3]) : 1000;
+
+        std::cout << "=== Latency: " << channels << " channels x " << rateHz << " Hz ===" << std::endl;
+        BenchResult queueLatency = benchQueue(seconds, channels, rateHz);
+        printResult("in-process queue", queueLatency);
+        BenchResult busLatency = benchSharedMemory(appConfig.bus, seconds, channels, rateHz);
+        printResult("shared memory bus", busLatency);
+
+        std::cout << "=== Throughput: " << channels << " channels, unpaced ===" << std::endl;
+        BenchResult queueThroughput = benchQueue(seconds, channels, 0);
+        printResult("in-process queue", queueThroughput);
+        BenchResult busThroughput = benchSharedMemory(appConfig.bus, seconds, channels, 0);
+        printResult("shared memory bus", busThroughput);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
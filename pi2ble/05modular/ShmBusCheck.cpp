@@ -0,0 +1,111 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SharedTelemetryBus.h"
+
+using Clock = std::chrono::steady_clock;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+// A writer that crashes inside publish(): the slot's seq left odd and the
+// ring entry it was rewriting marked incomplete (seq 0) or ahead of head
+static void crashMidPublish(const std::string& name, int id) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    struct stat st{};
+    fstat(fd, &st);
+    void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    ShmBusView view = shmBusView(base);
+    ShmBusHeader* header = view.header;
+    ShmSlot* slots = view.slots;
+    ShmRingHeader* ring = view.ring(id);
+    ShmRingEntry* entries = view.entries(id);
+
+    uint64_t head = ring->head.load();
+    uint64_t mask = header->ringCapacity - 1;
+    slots[id].seq.fetch_add(1);
+    entries[head & mask].seq.store(head + 1); // written, head not yet bumped
+    entries[(head - 1) & mask].seq.store(0);  // a complete entry torn
+    munmap(base, static_cast<size_t>(st.st_size));
+}
+
+// The object is sized and split into sections the way shmBusView() says
+static void checkLayout(const std::string& name, size_t channels, size_t ringCapacity) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    struct stat st{};
+    fstat(fd, &st);
+    void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    ShmBusView view = shmBusView(base);
+    uint8_t* start = static_cast<uint8_t*>(base);
+    auto aligned = [start](const void* p) { return (static_cast<const uint8_t*>(p) - start) % 64 == 0; };
+    check(static_cast<size_t>(st.st_size) == shmBusSize(channels, ringCapacity) &&
+              view.header->totalSize == static_cast<uint64_t>(st.st_size),
+          "object size matches shmBusSize()");
+    check(aligned(view.names) && aligned(view.slots) && aligned(view.rings) && view.ringStride % 64 == 0,
+          "sections start on 64 byte boundaries");
+    check(reinterpret_cast<uint8_t*>(view.names + channels) <= reinterpret_cast<uint8_t*>(view.slots) &&
+              reinterpret_cast<uint8_t*>(view.slots + channels) <= view.rings &&
+              reinterpret_cast<uint8_t*>(view.entries(static_cast<int>(channels) - 1) + ringCapacity) <=
+                  start + st.st_size,
+          "sections don't overlap and the last ring ends inside the object");
+    munmap(base, static_cast<size_t>(st.st_size));
+}
+
+// Re-attaching a writer over a bus whose previous writer died mid-publish.
+// Exits non-zero if a check fails; a regression of the odd-seq case hangs
+// in latest(), which the alarm turns into a failure.
+//
+// Usage: ./ShmBusCheck
+int main() {
+    const std::string name = "/telemetry-bus-check-" + std::to_string(getpid());
+    const std::vector<std::string> channels{"rpm", "speed"};
+    alarm(10);
+
+    try {
+        {
+            ShmBusWriter writer(name, channels, 8);
+            for (int i = 0; i < 5; ++i) writer.publish(0, 1000.0 + i, Clock::now());
+            writer.notify();
+            checkLayout(name, channels.size(), 8);
+        }
+        crashMidPublish(name, 0);
+
+        ShmBusReader reader(name);
+        uint64_t cursor = 0;
+        ShmBusWriter restarted(name, channels, 8);
+        TelemetrySample sample = reader.latest(0);
+        check(sample.updates == 5, "latest() returns after re-attaching over an odd seq");
+
+        int read = 0;
+        TelemetrySample entry;
+        while (reader.next(0, cursor, entry)) read++;
+        check(read == 4 && reader.overruns == 1, "the torn ring entry is skipped as lost, the rest read");
+
+        restarted.publish(0, 2000.0, Clock::now());
+        restarted.notify();
+        sample = reader.latest(0);
+        check(sample.value == 2000.0 && sample.updates == 6, "publishes after the restart are seen");
+        check(reader.next(0, cursor, entry) && entry.value == 2000.0, "the ring continues after the restart");
+        restarted.unlink();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        shm_unlink(name.c_str());
+        return 1;
+    }
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+#include "StartupProfile.h"
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace StartupProfile {
+
+namespace {
+
+struct Entry {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+    bool mainThread;
+};
+
+const int MAX_ENTRIES = 64;
+
+// Plain statics, zero-initialized before any constructor runs
+int64_t preinitNs;
+int64_t constructorNs;
+int64_t mainNs;
+int64_t firstFrameNs;
+Entry entries[MAX_ENTRIES];
+int entryCount;
+std::thread::id mainThreadId;
+
+std::mutex& entryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Process start from /proc/self/stat field 22, in clock ticks since boot
+int64_t execNs() {
+    std::ifstream stat("/proc/self/stat");
+    std::string line;
+    if (!std::getline(stat, line)) return 0;
+    size_t end = line.rfind(')');
+    if (end == std::string::npos) return 0;
+    std::istringstream fields(line.substr(end + 2));
+    std::string field;
+    // Fields after the command name start at 3 (state)
+    for (int i = 3; i < 22 && fields >> field; ++i) {
+    }
+    long long ticks = 0;
+    if (!(fields >> ticks)) return 0;
+    return ticks * (1000000000LL / sysconf(_SC_CLK_TCK));
+}
+
+void preinitHook(int, char**, char**) {
+    preinitNs = nowNs();
+}
+
+__attribute__((constructor(101))) void constructorHook() {
+    constructorNs = nowNs();
+}
+
+} // namespace
+
+// Runs before any shared library's initializers, executables only
+__attribute__((section(".preinit_array"), used)) static void (*preinitEntry)(int, char**, char**) = preinitHook;
+
+int64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void enterMain() {
+    mainNs = nowNs();
+    mainThreadId = std::this_thread::get_id();
+}
+
+Phase::Phase(const char* phaseName) : name(phaseName), startNs(nowNs()) {}
+
+Phase::~Phase() {
+    record(name, startNs, nowNs());
+}
+
+void record(const char* name, int64_t startNs, int64_t endNs) {
+    std::lock_guard<std::mutex> lock(entryMutex());
+    if (entryCount == MAX_ENTRIES) return;
+    entries[entryCount++] = {name, startNs, endNs, std::this_thread::get_id() == mainThreadId};
+}
+
+void firstFrame() {
+    if (firstFrameNs == 0) firstFrameNs = nowNs();
+}
+
+void print(std::ostream& out) {
+    int64_t exec = execNs();
+    if (exec == 0 || exec > preinitNs) exec = preinitNs;
+
+    std::vector<Entry> phases;
+    phases.push_back({"dynamic linking (+-1 tick)", exec, preinitNs, true});
+    phases.push_back({"shared library init (OpenCV, yaml-cpp...)", preinitNs, constructorNs, true});
+    phases.push_back({"own static init", constructorNs, mainNs, true});
+    {
+        std::lock_guard<std::mutex> lock(entryMutex());
+        phases.insert(phases.end(), entries, entries + entryCount);
+    }
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const Entry& a, const Entry& b) { return a.startNs < b.startNs; });
+
+    std::ios::fmtflags flags = out.flags();
+    out << "Startup (ms since exec):" << std::endl;
+    out << std::setw(10) << "start" << std::setw(10) << "took" << "  thread  phase" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    for (const Entry& phase : phases) {
+        out << std::setw(10) << (phase.startNs - exec) / 1e6 << std::setw(10) << (phase.endNs - phase.startNs) / 1e6
+            << "  " << (phase.mainThread ? "main  " : "init  ") << "  " << phase.name << std::endl;
+    }
+    if (firstFrameNs) {
+        out << "Time to first frame: " << (firstFrameNs - exec) / 1e6 << " ms" << std::endl;
+    }
+    out.flags(flags);
+}
+
+} // namespace StartupProfile
@@ -0,0 +1,54 @@
+#ifndef STARTUP_PROFILE_H
+#define STARTUP_PROFILE_H
+
+#include <cstdint>
+#include <ostream>
+
+// Where the time between exec and the first frame goes. Three phases are
+// taken from hooks in StartupProfile.cpp, before main runs:
+//   dynamic linking    exec -> the executable's preinit_array (the loader
+//                      has mapped and relocated every shared library)
+//   library init       -> our first constructor: every shared library's
+//                      static initializers (OpenCV, yaml-cpp, libstdc++)
+//   own static init    -> enterMain()
+// The exec time comes from /proc/self/stat, so the first phase is only
+// good to a clock tick (10 ms). Everything after is marked with Phase
+// scopes, from any thread:
+//
+//   int main() {
+//       StartupProfile::enterMain();
+//       { StartupProfile::Phase phase("config (YAML)"); ... }
+//       ...show it...  StartupProfile::firstFrame();
+//       StartupProfile::print(std::cout);
+//
+// Only link StartupProfile.cpp into executables, shared libraries don't
+// get a preinit_array.
+namespace StartupProfile {
+
+// CLOCK_BOOTTIME, the clock /proc/self/stat's start time is on
+int64_t nowNs();
+
+void enterMain();
+
+class Phase {
+private:
+    const char* name;
+    int64_t startNs;
+
+public:
+    explicit Phase(const char* phaseName);
+    ~Phase();
+};
+
+// Adds a finished phase; the name must outlive print()
+void record(const char* name, int64_t startNs, int64_t endNs);
+
+// Time to first frame is exec -> the first call
+void firstFrame();
+
+// Phases in start order, in ms since exec, and the time to first frame
+void print(std::ostream& out);
+
+} // namespace StartupProfile
+
+#endif // STARTUP_PROFILE_H
@@ -0,0 +1,242 @@
+#include "TelemetryLink.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+struct Crc16Table {
+    uint16_t entries[256];
+    Crc16Table() {
+        for (int i = 0; i < 256; ++i) {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+static const Crc16Table CRC16_TABLE;
+
+uint16_t linkCrc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE.entries[((crc >> 8) ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+uint64_t linkTimestampUs(std::chrono::steady_clock::time_point t) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count());
+}
+
+static inline void putVarint(uint8_t*& p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(v);
+}
+
+static inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static inline uint64_t zigzag(int64_t n) {
+    return (static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t n) {
+    return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+}
+
+LinkEncoder::LinkEncoder(const LinkConfig& linkConfig, size_t channelCount)
+    : config(linkConfig), lastSent(channelCount, 0), framesSinceKeyframe(linkConfig.keyframeInterval) {
+}
+
+size_t LinkEncoder::encode(const TelemetryStore& store, uint8_t* buf, size_t capacity) {
+    const size_t maxEntry = 5 + 10; // id gap + value delta varints
+    if (capacity < 32) return 0;
+
+    bool keyframe = framesSinceKeyframe >= config.keyframeInterval;
+    framesSinceKeyframe = keyframe ? 0 : framesSinceKeyframe + 1;
+
+    uint8_t* p = buf;
+    *p++ = LINK_MAGIC;
+    *p++ = keyframe ? LINK_FLAG_KEYFRAME : 0;
+    *p++ = static_cast<uint8_t>(sequence & 0xFF);
+    *p++ = static_cast<uint8_t>(sequence >> 8);
+    sequence++;
+    putVarint(p, linkTimestampUs(std::chrono::steady_clock::now()));
+    if (keyframe) putVarint(p, lastSent.size());
+
+    uint8_t* countPos = p;
+    p += 2;
+
+    uint16_t entries = 0;
+    int previousId = -1;
+    uint8_t* limit = buf + capacity - 2; // room for the CRC
+    for (size_t id = 0; id < lastSent.size(); ++id) {
+        int64_t q = std::llround(store.latest(static_cast<int>(id)).value / config.resolution);
+        if (!keyframe && q == lastSent[id]) continue;
+        if (p + maxEntry > limit) break; // the rest goes out with the next frame
+
+        putVarint(p, static_cast<uint64_t>(static_cast<int>(id) - previousId - 1));
+        putVarint(p, zigzag(keyframe ? q : q - lastSent[id]));
+        lastSent[id] = q;
+        previousId = static_cast<int>(id);
+        entries++;
+    }
+    countPos[0] = static_cast<uint8_t>(entries & 0xFF);
+    countPos[1] = static_cast<uint8_t>(entries >> 8);
+
+    uint16_t crc = linkCrc16(buf, static_cast<size_t>(p - buf));
+    *p++ = static_cast<uint8_t>(crc & 0xFF);
+    *p++ = static_cast<uint8_t>(crc >> 8);
+    return static_cast<size_t>(p - buf);
+}
+
+LinkDecoder::LinkDecoder(const LinkConfig& config, size_t channelCount)
+    : resolution(config.resolution), values(channelCount, 0) {
+}
+
+bool LinkDecoder::decode(const uint8_t* data, size_t length, TelemetryStore& store,
+                         std::chrono::steady_clock::time_point received) {
+    if (length < 8 || data[0] != LINK_MAGIC) {
+        framesCorrupt++;
+        return false;
+    }
+    uint16_t crc = static_cast<uint16_t>(data[length - 2] | (data[length - 1] << 8));
+    if (linkCrc16(data, length - 2) != crc) {
+        framesCorrupt++;
+        return false;
+    }
+
+    const uint8_t* p = data + 2;
+    const uint8_t* end = data + length - 2;
+    bool keyframe = data[1] & LINK_FLAG_KEYFRAME;
+    uint16_t sequence = static_cast<uint16_t>(p[0] | (p[1] << 8));
+    p += 2;
+
+    uint64_t timestampUs, channelCount = values.size();
+    if (!getVarint(p, end, timestampUs) || (keyframe && !getVarint(p, end, channelCount)) || end - p < 2) {
+        framesCorrupt++;
+        return false;
+    }
+    if (channelCount != values.size()) {
+        framesCorrupt++; // sender runs a different AppConfig
+        return false;
+    }
+    uint16_t entries = static_cast<uint16_t>(p[0] | (p[1] << 8));
+    p += 2;
+
+    if (synced && sequence != expectedSequence) {
+        framesLost += static_cast<uint16_t>(sequence - expectedSequence);
+        synced = false;
+    }
+    expectedSequence = static_cast<uint16_t>(sequence + 1);
+    if (!synced && !keyframe) {
+        framesSkipped++;
+        return false;
+    }
+
+    // Validate every entry before touching any state
+    const uint8_t* entryStart = p;
+    int64_t id = -1;
+    for (uint16_t i = 0; i < entries; ++i) {
+        uint64_t gap, delta;
+        if (!getVarint(p, end, gap) || !getVarint(p, end, delta)) {
+            framesCorrupt++;
+            return false;
+        }
+        id += static_cast<int64_t>(gap) + 1;
+        if (id >= static_cast<int64_t>(values.size())) {
+            framesCorrupt++;
+            return false;
+        }
+    }
+
+    p = entryStart;
+    id = -1;
+    for (uint16_t i = 0; i < entries; ++i) {
+        uint64_t gap, delta;
+        getVarint(p, end, gap);
+        getVarint(p, end, delta);
+        id += static_cast<int64_t>(gap) + 1;
+
+        int64_t& value = values[static_cast<size_t>(id)];
+        value = keyframe ? unzigzag(delta) : value + unzigzag(delta);
+        store.publish(static_cast<int>(id), value * resolution, received);
+    }
+
+    synced = true;
+    lastTimestampUs = timestampUs;
+    framesOk++;
+    return true;
+}
+
+UdpLinkSender::UdpLinkSender(const std::string& host, int port) {
+    fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Could not create UDP socket: ") + std::strerror(errno));
+    }
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        ::close(fd);
+        throw std::runtime_error("Invalid link host " + host);
+    }
+}
+
+UdpLinkSender::~UdpLinkSender() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool UdpLinkSender::send(const uint8_t* data, size_t length) {
+    return ::sendto(fd, data, length, 0, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) ==
+           static_cast<ssize_t>(length);
+}
+
+UdpLinkReceiver::UdpLinkReceiver(int port) {
+    fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Could not create UDP socket: ") + std::strerror(errno));
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not bind link port " + std::to_string(port));
+    }
+}
+
+UdpLinkReceiver::~UdpLinkReceiver() {
+    if (fd >= 0) ::close(fd);
+}
+
+size_t UdpLinkReceiver::receive(uint8_t* buf, size_t capacity, int timeoutMs) {
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, timeoutMs) <= 0) return 0;
+
+    ssize_t n = ::recv(fd, buf, capacity, 0);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
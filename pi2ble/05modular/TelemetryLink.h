@@ -0,0 +1,103 @@
+#ifndef TELEMETRY_LINK_H
+#define TELEMETRY_LINK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include "AppConfig.h"
+#include "TelemetryStore.h"
+
+// Binary wire format between the Pi 5 (ingest) and the Pi Zero 2 (overlay).
+//
+// One frame per datagram, little endian:
+//   u8   magic (0xA5)
+//   u8   flags (bit 0: keyframe)
+//   u16  sequence number
+//   var  sender timestamp in microseconds
+//   var  channel count            (keyframes only, guards against config mismatch)
+//   u16  entry count
+//   entries: var channel id gap, zigzag var value delta
+//   u16  CRC-16/CCITT over everything before it
+//
+// Values are quantized to LinkConfig::resolution. Keyframes carry every
+// channel as a delta from zero; other frames only carry channels whose
+// quantized value changed since the last frame sent. A receiver that misses
+// a frame drops deltas until the next keyframe. Keyframes must fit in one
+// datagram, which is ~300 channels at typical 4 bytes per entry.
+constexpr uint8_t LINK_MAGIC = 0xA5;
+constexpr uint8_t LINK_FLAG_KEYFRAME = 0x01;
+constexpr size_t LINK_MAX_FRAME_SIZE = 1400; // stays inside one Ethernet/Wi-Fi MTU
+
+uint16_t linkCrc16(const uint8_t* data, size_t length);
+
+// Runs on the Pi 5: turns the store into link frames
+class LinkEncoder {
+private:
+    LinkConfig config;
+    std::vector<int64_t> lastSent;
+    uint16_t sequence = 0;
+    int framesSinceKeyframe;
+
+public:
+    LinkEncoder(const LinkConfig& config, size_t channelCount);
+
+    // Encodes the store's current values into buf, returns the frame length
+    size_t encode(const TelemetryStore& store, uint8_t* buf, size_t capacity);
+    void forceKeyframe() { framesSinceKeyframe = config.keyframeInterval; }
+};
+
+// Frame timestamps are steady_clock microseconds on the sender, only
+// comparable with the receiver's clock when both ends are the same machine
+uint64_t linkTimestampUs(std::chrono::steady_clock::time_point t);
+
+// Runs on the Pi Zero 2: validates frames and publishes them into the store.
+// All state is sized once at construction, decode() does not allocate.
+class LinkDecoder {
+private:
+    double resolution;
+    std::vector<int64_t> values;
+    bool synced = false;
+    uint16_t expectedSequence = 0;
+
+public:
+    uint64_t framesOk = 0;
+    uint64_t framesLost = 0;     // sequence gaps
+    uint64_t framesCorrupt = 0;  // bad magic, CRC or truncated
+    uint64_t framesSkipped = 0;  // deltas received while out of sync
+    uint64_t lastTimestampUs = 0;
+
+    LinkDecoder(const LinkConfig& config, size_t channelCount);
+
+    // Returns false if the frame was rejected
+    bool decode(const uint8_t* data, size_t length, TelemetryStore& store,
+                std::chrono::steady_clock::time_point received);
+    bool isSynced() const { return synced; }
+};
+
+// Thin UDP wrappers, one datagram per frame
+class UdpLinkSender {
+private:
+    int fd = -1;
+    sockaddr_in addr{};
+
+public:
+    UdpLinkSender(const std::string& host, int port);
+    ~UdpLinkSender();
+    bool send(const uint8_t* data, size_t length);
+};
+
+class UdpLinkReceiver {
+private:
+    int fd = -1;
+
+public:
+    explicit UdpLinkReceiver(int port);
+    ~UdpLinkReceiver();
+    // Waits up to timeoutMs, returns the datagram length or 0 on timeout
+    size_t receive(uint8_t* buf, size_t capacity, int timeoutMs);
+};
+
+#endif // TELEMETRY_LINK_H
@@ -0,0 +1,54 @@
+#include "TelemetryStore.h"
+
+TelemetryStore::TelemetryStore(const AppConfig& config) {
+    for (const auto& entry : config.telemetry) {
+        names.push_back(entry.first);
+    }
+    slots.reset(new Slot[names.size()]);
+}
+
+TelemetryStore::TelemetryStore(const std::vector<std::string>& channelNames)
+    : names(channelNames), slots(new Slot[channelNames.size()]) {
+}
+
+int TelemetryStore::channelId(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void TelemetryStore::publish(int id, double value, std::chrono::steady_clock::time_point timestamp) {
+    Slot& slot = slots[id];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+
+    // Odd sequence marks the slot as being written
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.timestampNs.store(timestamp.time_since_epoch().count(), std::memory_order_relaxed);
+    slot.updates.store(slot.updates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    if (tap) tap->onPublish(id, value, timestamp);
+}
+
+TelemetrySample TelemetryStore::latest(int id) const {
+    const Slot& slot = slots[id];
+    TelemetrySample sample;
+    uint32_t before, after;
+
+    do {
+        before = slot.seq.load(std::memory_order_acquire);
+        sample.value = slot.value.load(std::memory_order_relaxed);
+        sample.timestamp = std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(slot.timestampNs.load(std::memory_order_relaxed)));
+        sample.updates = slot.updates.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return sample;
+}
@@ -0,0 +1,59 @@
+#ifndef TELEMETRY_STORE_H
+#define TELEMETRY_STORE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AppConfig.h"
+
+struct TelemetrySample {
+    double value = 0.0;
+    std::chrono::steady_clock::time_point timestamp{};
+    uint64_t updates = 0; // number of publishes so far, 0 = never published
+};
+
+// Gets every published sample, on the publishing thread, e.g. to record
+// the session. Must not block.
+class TelemetryTap {
+public:
+    virtual ~TelemetryTap() = default;
+    virtual void onPublish(int id, double value, std::chrono::steady_clock::time_point timestamp) = 0;
+};
+
+// Latest-value table with one slot per telemetry entry in AppConfig.
+// Channel ids are assigned in config order (the map order, so alphabetical).
+// Each channel has a single writer (its ingress source); any number of
+// readers can sample it without locking, a per-slot seqlock keeps the
+// value/timestamp pair consistent.
+class TelemetryStore {
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> seq{0};
+        std::atomic<double> value{0.0};
+        std::atomic<int64_t> timestampNs{0};
+        std::atomic<uint64_t> updates{0};
+    };
+
+    std::vector<std::string> names;
+    std::unique_ptr<Slot[]> slots;
+    TelemetryTap* tap = nullptr;
+
+public:
+    explicit TelemetryStore(const AppConfig& config);
+    explicit TelemetryStore(const std::vector<std::string>& channelNames);
+
+    size_t channelCount() const { return names.size(); }
+    const std::string& channelName(int id) const { return names[id]; }
+    int channelId(const std::string& name) const; // -1 if unknown
+
+    void publish(int id, double value, std::chrono::steady_clock::time_point timestamp);
+    TelemetrySample latest(int id) const;
+
+    // Set before the ingress sources start; nullptr to detach
+    void setTap(TelemetryTap* t) { tap = t; }
+};
+
+#endif // TELEMETRY_STORE_H
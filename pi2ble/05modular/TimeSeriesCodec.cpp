@@ -0,0 +1,439 @@
+#include "TimeSeriesCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static inline uint64_t zigzag(int64_t n) {
+    return (static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t n) {
+    return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+}
+
+static inline uint64_t doubleBits(double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static inline double bitsDouble(uint64_t bits) {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static inline uint64_t loadBigEndian64(const uint8_t* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return __builtin_bswap64(word);
+}
+
+static inline size_t align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+void BitWriter::write(uint64_t value, int bits) {
+    if (bits > 32) {
+        write(value >> 32, bits - 32);
+        write(value & 0xFFFFFFFFull, 32);
+        return;
+    }
+    if (bits <= 0) return;
+
+    accumulator = (accumulator << bits) | (value & ((1ull << bits) - 1));
+    pending += bits;
+    while (pending >= 8) {
+        pending -= 8;
+        if (bytes < capacity) data[bytes] = static_cast<uint8_t>(accumulator >> pending);
+        bytes++;
+    }
+}
+
+size_t BitWriter::finish() {
+    if (pending > 0) {
+        if (bytes < capacity) data[bytes] = static_cast<uint8_t>(accumulator << (8 - pending));
+        bytes++;
+        pending = 0;
+    }
+    return overflowed() ? 0 : bytes;
+}
+
+uint64_t BitReader::read(int bits) {
+    if (bits > 32) {
+        uint64_t high = read(bits - 32);
+        return (high << 32) | read(32);
+    }
+    if (bits <= 0) return 0;
+
+    size_t byte = position >> 3;
+    int shift = static_cast<int>(position & 7);
+    position += static_cast<size_t>(bits);
+
+    if (byte + 8 <= sizeBits / 8) {
+        return (loadBigEndian64(data + byte) << shift) >> (64 - bits);
+    }
+
+    // Near the end of the stream, byte at a time
+    uint64_t result = 0;
+    int need = bits;
+    size_t bit = position - static_cast<size_t>(bits);
+    while (need > 0) {
+        size_t index = bit >> 3;
+        int offset = static_cast<int>(bit & 7);
+        int take = std::min(8 - offset, need);
+        uint8_t b = index < sizeBits / 8 ? data[index] : 0;
+        result = (result << take) | ((b >> (8 - offset - take)) & ((1u << take) - 1));
+        bit += static_cast<size_t>(take);
+        need -= take;
+    }
+    return result;
+}
+
+void unpackFixedWidth(const uint8_t* data, size_t sizeBytes, size_t bitOffset, int width, size_t count,
+                      uint64_t* out) {
+    if (width == 0) {
+        std::fill(out, out + count, 0);
+        return;
+    }
+
+    // Values whose 8 byte load stays inside the buffer
+    size_t fast = 0;
+    if (sizeBytes >= 8) {
+        size_t lastSafeBit = (sizeBytes - 8) * 8;
+        if (bitOffset <= lastSafeBit) fast = std::min(count, (lastSafeBit - bitOffset) / width + 1);
+    }
+
+    const int rightShift = 64 - width;
+    for (size_t i = 0; i < fast; ++i) {
+        size_t bit = bitOffset + i * static_cast<size_t>(width);
+        out[i] = (loadBigEndian64(data + (bit >> 3)) << (bit & 7)) >> rightShift;
+    }
+
+    BitReader tail(data, sizeBytes);
+    tail.skip(bitOffset + fast * static_cast<size_t>(width));
+    for (size_t i = fast; i < count; ++i) out[i] = tail.read(width);
+}
+
+void DecodedBlock::clear() {
+    values.clear();
+    timestampsNs.clear();
+    channels.clear();
+}
+
+void GorillaChannelEncoder::reset(uint16_t channelId) {
+    channel = channelId;
+    offsetsUs.clear();
+    values.clear();
+}
+
+void GorillaChannelEncoder::append(uint32_t offsetUs, double value) {
+    offsetsUs.push_back(offsetUs);
+    values.push_back(value);
+}
+
+// Smallest scale that reproduces every value bit for bit from an integer,
+// 0 if none. multiply selects integer * (1.0 / scale) over integer / scale.
+uint32_t GorillaChannelEncoder::quantizationScale(bool& multiply) const {
+    static const uint32_t SCALES[] = {1, 4, 10, 100};
+    for (uint32_t scale : SCALES) {
+        for (bool mul : {false, true}) {
+            double step = 1.0 / scale;
+            bool exact = true;
+            for (double v : values) {
+                double x = v * scale;
+                if (!(std::fabs(x) < 4503599627370496.0)) { exact = false; break; } // 2^52, also rejects NaN
+                double q = static_cast<double>(std::llround(x));
+                double back = mul ? q * step : q / scale;
+                if (back != v || std::signbit(back) != std::signbit(v)) { exact = false; break; }
+            }
+            if (exact) {
+                multiply = mul;
+                return scale;
+            }
+        }
+    }
+    return 0;
+}
+
+size_t GorillaChannelEncoder::finish(uint8_t* out, size_t capacity) const {
+    if (capacity < sizeof(GorillaChannelRecord) || values.empty()) return 0;
+
+    GorillaChannelRecord record{};
+    record.channel = channel;
+    record.mode = GORILLA_MODE_XOR;
+    record.count = static_cast<uint32_t>(values.size());
+    record.firstOffsetUs = offsetsUs[0];
+    record.first = doubleBits(values[0]);
+
+    // Quantized if every value is an exact multiple and the deltas pack small
+    bool multiply = false;
+    uint32_t scale = values.size() > 1 ? quantizationScale(multiply) : 0;
+    int width = 0;
+    if (scale) {
+        uint64_t widest = 0;
+        int64_t previous = std::llround(values[0] * scale);
+        for (size_t i = 1; i < values.size(); ++i) {
+            int64_t q = std::llround(values[i] * scale);
+            widest |= zigzag(q - previous);
+            previous = q;
+        }
+        width = widest ? 64 - __builtin_clzll(widest) : 0;
+        if (width <= 56) {
+            record.mode = multiply ? GORILLA_MODE_QUANTIZED_MUL : GORILLA_MODE_QUANTIZED;
+            record.bitWidth = static_cast<uint8_t>(width);
+            record.scale = scale;
+            record.first = static_cast<uint64_t>(std::llround(values[0] * scale));
+        }
+    }
+
+    BitWriter bits(out + sizeof(record), capacity - sizeof(record));
+
+    // Timestamps: delta of delta
+    int64_t previousDelta = 0;
+    for (size_t i = 1; i < offsetsUs.size(); ++i) {
+        int64_t delta = static_cast<int64_t>(offsetsUs[i]) - static_cast<int64_t>(offsetsUs[i - 1]);
+        int64_t dod = delta - previousDelta;
+        previousDelta = delta;
+
+        if (dod == 0) {
+            bits.write(0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            bits.write(0b10, 2);
+            bits.write(static_cast<uint64_t>(dod + 63), 7);
+        } else if (dod >= -255 && dod <= 256) {
+            bits.write(0b110, 3);
+            bits.write(static_cast<uint64_t>(dod + 255), 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            bits.write(0b1110, 4);
+            bits.write(static_cast<uint64_t>(dod + 2047), 12);
+        } else {
+            bits.write(0b1111, 4);
+            bits.write(static_cast<uint64_t>(dod), 64);
+        }
+    }
+
+    if (record.mode != GORILLA_MODE_XOR) {
+        int64_t previous = static_cast<int64_t>(record.first);
+        for (size_t i = 1; i < values.size(); ++i) {
+            int64_t q = std::llround(values[i] * scale);
+            bits.write(zigzag(q - previous), width);
+            previous = q;
+        }
+    } else {
+        uint64_t previous = record.first;
+        int previousLeading = -1, previousTrailing = 0;
+        for (size_t i = 1; i < values.size(); ++i) {
+            uint64_t current = doubleBits(values[i]);
+            uint64_t x = current ^ previous;
+            previous = current;
+
+            if (x == 0) {
+                bits.write(0, 1);
+                continue;
+            }
+            int leading = std::min(__builtin_clzll(x), 31);
+            int trailing = __builtin_ctzll(x);
+            if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+                // Fits the previous window
+                bits.write(0b10, 2);
+                bits.write(x >> previousTrailing, 64 - previousLeading - previousTrailing);
+            } else {
+                int significant = 64 - leading - trailing;
+                bits.write(0b11, 2);
+                bits.write(static_cast<uint64_t>(leading), 5);
+                bits.write(static_cast<uint64_t>(significant - 1), 6);
+                bits.write(x >> trailing, significant);
+                previousLeading = leading;
+                previousTrailing = trailing;
+            }
+        }
+    }
+
+    size_t streamBytes = bits.finish();
+    if (streamBytes == 0 && bits.overflowed()) return 0;
+    size_t total = sizeof(record) + align8(streamBytes);
+    if (total > capacity) return 0;
+
+    record.streamBytes = static_cast<uint32_t>(streamBytes);
+    std::memcpy(out, &record, sizeof(record));
+    std::memset(out + sizeof(record) + streamBytes, 0, align8(streamBytes) - streamBytes);
+    return total;
+}
+
+size_t GorillaBlockEncoder::encode(const double* values, const uint32_t* offsetsUs, const uint16_t* channels,
+                                   size_t count, uint8_t* out, size_t capacity) {
+    if (capacity < 8) return 0;
+
+    present.clear();
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t channel = channels[i];
+        if (channel >= encoders.size()) encoders.resize(channel + 1u);
+        GorillaChannelEncoder& encoder = encoders[channel];
+        if (encoder.count() == 0) {
+            encoder.reset(channel);
+            present.push_back(channel);
+        }
+        encoder.append(offsetsUs[i], values[i]);
+    }
+
+    uint16_t channelsInBlock = static_cast<uint16_t>(present.size());
+    std::memset(out, 0, 8);
+    std::memcpy(out, &channelsInBlock, sizeof(channelsInBlock));
+
+    size_t used = 8;
+    for (uint16_t channel : present) {
+        size_t written = used < capacity ? encoders[channel].finish(out + used, capacity - used) : 0;
+        used = written ? used + written : capacity + 1;
+    }
+    for (uint16_t channel : present) encoders[channel].reset(channel);
+
+    return used <= capacity ? used : 0;
+}
+
+static bool decodeRawBlock(const SessionBlockHeader& header, const uint8_t* payload, DecodedBlock& out) {
+    size_t n = header.sampleCount;
+    if (sessionRawPayloadBytes(n) > header.payloadBytes) return false;
+
+    const uint8_t* offsets = payload + n * sizeof(double);
+    const uint8_t* channels = offsets + n * sizeof(uint32_t);
+    out.values.resize(n);
+    out.timestampsNs.resize(n);
+    out.channels.resize(n);
+    std::memcpy(out.values.data(), payload, n * sizeof(double));
+    std::memcpy(out.channels.data(), channels, n * sizeof(uint16_t));
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t offsetUs;
+        std::memcpy(&offsetUs, offsets + i * sizeof(uint32_t), sizeof(offsetUs));
+        out.timestampsNs[i] = header.firstTimestampNs + static_cast<int64_t>(offsetUs) * 1000;
+    }
+    return true;
+}
+
+static bool decodeGorillaChannel(const GorillaChannelRecord& record, const uint8_t* stream, int64_t firstNs,
+                                 DecodedBlock& out) {
+    size_t n = record.count;
+    size_t base = out.values.size();
+    out.values.resize(base + n);
+    out.timestampsNs.resize(base + n);
+    out.channels.resize(base + n, record.channel);
+    double* values = out.values.data() + base;
+    int64_t* timestamps = out.timestampsNs.data() + base;
+
+    BitReader bits(stream, record.streamBytes);
+    int64_t offset = record.firstOffsetUs;
+    int64_t delta = 0;
+    timestamps[0] = firstNs + offset * 1000;
+    for (size_t i = 1; i < n; ++i) {
+        int64_t dod;
+        if (bits.read(1) == 0) {
+            dod = 0;
+        } else if (bits.read(1) == 0) {
+            dod = static_cast<int64_t>(bits.read(7)) - 63;
+        } else if (bits.read(1) == 0) {
+            dod = static_cast<int64_t>(bits.read(9)) - 255;
+        } else if (bits.read(1) == 0) {
+            dod = static_cast<int64_t>(bits.read(12)) - 2047;
+        } else {
+            dod = static_cast<int64_t>(bits.read(64));
+        }
+        delta += dod;
+        offset += delta;
+        timestamps[i] = firstNs + offset * 1000;
+    }
+
+    if (record.mode == GORILLA_MODE_QUANTIZED || record.mode == GORILLA_MODE_QUANTIZED_MUL) {
+        if (record.scale == 0 || record.bitWidth > 56) return false;
+        out.unpacked.resize(n);
+        unpackFixedWidth(stream, record.streamBytes, bits.bitPosition(), record.bitWidth, n - 1,
+                         out.unpacked.data());
+        bits.skip((n - 1) * record.bitWidth);
+
+        int64_t q = static_cast<int64_t>(record.first);
+        double scale = record.scale;
+        double step = 1.0 / scale;
+        bool multiply = record.mode == GORILLA_MODE_QUANTIZED_MUL;
+        values[0] = multiply ? static_cast<double>(q) * step : static_cast<double>(q) / scale;
+        for (size_t i = 1; i < n; ++i) {
+            q += unzigzag(out.unpacked[i - 1]);
+            values[i] = multiply ? static_cast<double>(q) * step : static_cast<double>(q) / scale;
+        }
+    } else if (record.mode == GORILLA_MODE_XOR) {
+        uint64_t current = record.first;
+        int leading = 0, trailing = 0;
+        values[0] = bitsDouble(current);
+        for (size_t i = 1; i < n; ++i) {
+            if (bits.read(1) != 0) {
+                if (bits.read(1) != 0) {
+                    leading = static_cast<int>(bits.read(5));
+                    int significant = static_cast<int>(bits.read(6)) + 1;
+                    trailing = 64 - leading - significant;
+                    if (trailing < 0) return false;
+                }
+                current ^= bits.read(64 - leading - trailing) << trailing;
+            }
+            values[i] = bitsDouble(current);
+        }
+    } else {
+        return false;
+    }
+
+    return !bits.exhausted();
+}
+
+static bool decodeGorillaBlock(const SessionBlockHeader& header, const uint8_t* payload, DecodedBlock& out) {
+    if (header.payloadBytes < 8) return false;
+    uint16_t channelsInBlock;
+    std::memcpy(&channelsInBlock, payload, sizeof(channelsInBlock));
+
+    out.clear();
+    size_t used = 8;
+    for (uint16_t c = 0; c < channelsInBlock; ++c) {
+        if (used + sizeof(GorillaChannelRecord) > header.payloadBytes) return false;
+        GorillaChannelRecord record;
+        std::memcpy(&record, payload + used, sizeof(record));
+        used += sizeof(record);
+        if (record.count == 0 || used + record.streamBytes > header.payloadBytes) return false;
+        if (!decodeGorillaChannel(record, payload + used, header.firstTimestampNs, out)) return false;
+        used += align8(record.streamBytes);
+    }
+    if (out.size() != header.sampleCount) return false;
+
+    // Channels were stored one after the other, merge back into time order
+    if (channelsInBlock > 1) {
+        size_t n = out.size();
+        out.order.resize(n);
+        for (size_t i = 0; i < n; ++i) out.order[i] = static_cast<uint32_t>(i);
+        std::stable_sort(out.order.begin(), out.order.end(),
+                         [&out](uint32_t a, uint32_t b) { return out.timestampsNs[a] < out.timestampsNs[b]; });
+
+        // Permute in place with the unpacked scratch as the value buffer
+        out.unpacked.resize(n * 2);
+        uint64_t* values = out.unpacked.data();
+        int64_t* timestamps = reinterpret_cast<int64_t*>(out.unpacked.data() + n);
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = doubleBits(out.values[out.order[i]]);
+            timestamps[i] = out.timestampsNs[out.order[i]];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            out.values[i] = bitsDouble(values[i]);
+            out.timestampsNs[i] = timestamps[i];
+        }
+        // Channels last: reuse order as the channel buffer
+        for (size_t i = 0; i < n; ++i) out.order[i] = out.channels[out.order[i]];
+        for (size_t i = 0; i < n; ++i) out.channels[i] = static_cast<uint16_t>(out.order[i]);
+    }
+    return true;
+}
+
+bool decodeSessionBlock(const SessionBlockHeader& header, const uint8_t* payload, DecodedBlock& out) {
+    if (header.magic != SESSION_BLOCK_MAGIC) return false;
+    switch (header.encoding) {
+        case SESSION_BLOCK_RAW:
+            return decodeRawBlock(header, payload, out);
+        case SESSION_BLOCK_GORILLA:
+            return decodeGorillaBlock(header, payload, out);
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,134 @@
+#ifndef TIME_SERIES_CODEC_H
+#define TIME_SERIES_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SessionLog.h"
+
+// Lossless compression of session blocks (Gorilla, Pelkonen et al. 2015).
+// Values decode bit for bit; timestamps decode to the microsecond offsets
+// the block holds, which is all a RAW block keeps too (see SessionLog.h).
+//   timestamps  delta-of-delta in microseconds, variable length prefix codes
+//   values      XOR with the previous value, only the meaningful bits
+//   quantized   channels whose values all come out of integer / scale or
+//               integer * (1 / scale) exactly (scale 1, 4, 10 or 100:
+//               OBD speed, rpm/4, CAN raw * 0.1, ...) store
+//               zigzag integer deltas bit-packed at one fixed width per
+//               block, which unpacks without branches
+//
+// A GORILLA block payload regroups the block's samples per channel:
+//   uint16_t channelsInBlock, uint16_t reserved, uint32_t reserved
+//   per channel a GorillaChannelRecord, then streamBytes of bits
+//   (timestamps, then XOR values or packed deltas) padded to 8 bytes
+// Decoding merges the channels back into timestamp order.
+
+enum GorillaChannelMode : uint8_t {
+    GORILLA_MODE_XOR = 0,
+    GORILLA_MODE_QUANTIZED = 1,     // value = integer / scale
+    GORILLA_MODE_QUANTIZED_MUL = 2, // value = integer * (1.0 / scale), how CAN/DBC scaling computes it
+};
+
+// MSB-first bit stream over a caller provided buffer
+class BitWriter {
+private:
+    uint8_t* data;
+    size_t capacity;
+    size_t bytes = 0;
+    uint64_t accumulator = 0;
+    int pending = 0; // bits in the accumulator
+
+public:
+    BitWriter(uint8_t* buffer, size_t capacityBytes) : data(buffer), capacity(capacityBytes) {}
+
+    void write(uint64_t value, int bits);
+    // Flushes the partial byte; returns the bytes written, 0 on overflow
+    size_t finish();
+    bool overflowed() const { return bytes > capacity; }
+};
+
+class BitReader {
+private:
+    const uint8_t* data;
+    size_t sizeBits;
+    size_t position = 0;
+
+public:
+    BitReader(const uint8_t* buffer, size_t sizeBytes) : data(buffer), sizeBits(sizeBytes * 8) {}
+
+    uint64_t read(int bits);
+    bool exhausted() const { return position > sizeBits; }
+    size_t bitPosition() const { return position; }
+    void skip(size_t bits) { position += bits; }
+};
+
+struct GorillaChannelRecord {
+    uint16_t channel;
+    uint8_t mode;
+    uint8_t bitWidth;      // packed delta width, quantized mode
+    uint32_t count;
+    uint32_t streamBytes;
+    uint32_t scale;        // quantized modes
+    uint32_t firstOffsetUs;
+    uint32_t reserved;
+    uint64_t first;        // first value's bits (XOR) or first integer
+};
+static_assert(sizeof(GorillaChannelRecord) == 32, "channel record layout");
+
+// Samples of one block: GORILLA blocks in timestamp order, RAW blocks in
+// the order they were recorded
+struct DecodedBlock {
+    std::vector<double> values;
+    std::vector<int64_t> timestampsNs;
+    std::vector<uint16_t> channels;
+    std::vector<uint32_t> order;    // scratch for the timestamp merge
+    std::vector<uint64_t> unpacked; // scratch for packed deltas
+
+    size_t size() const { return values.size(); }
+    void clear();
+};
+
+// Streaming encoder for one channel: append samples, then write the channel
+// record into a block payload
+class GorillaChannelEncoder {
+private:
+    uint16_t channel = 0;
+    std::vector<uint32_t> offsetsUs;
+    std::vector<double> values;
+
+    uint32_t quantizationScale(bool& multiply) const;
+
+public:
+    void reset(uint16_t channelId);
+    void append(uint32_t offsetUs, double value);
+    size_t count() const { return values.size(); }
+
+    // Returns bytes written at out, 0 if it did not fit in capacity
+    size_t finish(uint8_t* out, size_t capacity) const;
+};
+
+// Encodes one block's samples (any order, offsets in us from the block's
+// first timestamp) as a GORILLA payload. Keeps its per-channel encoders
+// between blocks so steady-state encoding doesn't allocate.
+class GorillaBlockEncoder {
+private:
+    std::vector<GorillaChannelEncoder> encoders; // indexed by channel id
+    std::vector<uint16_t> present;
+
+public:
+    // Returns the padded payload size, 0 if it would not fit in capacity
+    size_t encode(const double* values, const uint32_t* offsetsUs, const uint16_t* channels, size_t count,
+                  uint8_t* out, size_t capacity);
+};
+
+// Decodes a RAW or GORILLA block (header followed by its payload) into out.
+// Returns false if the block is malformed.
+bool decodeSessionBlock(const SessionBlockHeader& header, const uint8_t* payload, DecodedBlock& out);
+
+// Unpacks count values of `width` bits (MSB-first, width <= 56) starting at
+// bitOffset. The inner loop is one unaligned load + shift + mask per value,
+// no data dependent branches, so the compiler can unroll/vectorize it.
+void unpackFixedWidth(const uint8_t* data, size_t sizeBytes, size_t bitOffset, int width, size_t count,
+                      uint64_t* out);
+
+#endif // TIME_SERIES_CODEC_H
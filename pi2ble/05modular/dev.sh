@@ -196,6 +196,30 @@ case "${1:-dev}" in
     "telemetry")
         smart_build && run_app "TelemetryConfig" "TelemetryConfig"
         ;;
+    "obd")
+        smart_build && run_app "ObdSim" "ObdSim"
+        ;;
+    "can")
+        smart_build && cd "$BUILD_DIR" && ./CanReplay --generate 100000 | ./CanReplay -
+        ;;
+    "link")
+        smart_build && run_app "LinkBench" "LinkBench"
+        ;;
+    "bus")
+        smart_build && run_app "ShmBusBench" "ShmBusBench"
+        ;;
+    "latency")
+        smart_build && run_app "LatencyProbe" "LatencyProbe"
+        ;;
+    "record")
+        smart_build && run_app "RecorderBench" "RecorderBench"
+        ;;
+    "codec")
+        smart_build && run_app "CodecBench" "CodecBench"
+        ;;
+    "replay")
+        smart_build && run_app "SessionPlayer" "SessionPlayer"
+        ;;
     # Example: Add new executable like this:
     # "newprogram"|"new")
     #     smart_build && run_app "NewProgram" "NewProgram"
@@ -230,6 +254,14 @@ case "${1:-dev}" in
         echo -e "  ${BLUE}dev${NC}         - Smart build & run AppConfig (auto-setup deps)"
         echo -e "  ${BLUE}main${NC}        - Smart build & run Main application"
         echo -e "  ${BLUE}telemetry${NC}   - Smart build & run TelemetryConfig"
+        echo -e "  ${BLUE}obd${NC}         - Smart build & run ObdSim (OBD poller vs simulated ECU)"
+        echo -e "  ${BLUE}can${NC}         - Smart build & pipe a generated candump log through CanReplay"
+        echo -e "  ${BLUE}link${NC}        - Smart build & run LinkBench (Pi 5 -> Pi Zero 2 protocol, loopback)"
+        echo -e "  ${BLUE}bus${NC}         - Smart build & run ShmBusBench (shared memory bus vs in-process queue)"
+        echo -e "  ${BLUE}latency${NC}     - Smart build & run LatencyProbe (sensor-to-pixel age at display)"
+        echo -e "  ${BLUE}record${NC}      - Smart build & run RecorderBench (session recorder, 100 ch x 1 kHz)"
+        echo -e "  ${BLUE}codec${NC}       - Smart build & run CodecBench (recorded telemetry compression)"
+        echo -e "  ${BLUE}replay${NC}      - Smart build & run SessionPlayer (replay a recorded session)"
         echo -e "  ${BLUE}test${NC}        - Smart build & run all executables"
         echo -e "  ${BLUE}build${NC}       - Force build project (auto-setup deps)"
         echo -e "  ${BLUE}setup${NC}       - Setup vcpkg and install dependencies only"
@@ -0,0 +1,253 @@
+#include "AsyncLog.h"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AsyncLog {
+
+namespace {
+
+const size_t RING_CAPACITY = 1024; // records per thread, power of two
+const int MAX_THREADS = 16;
+const int WRITE_INTERVAL_MS = 20;
+
+const char* const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+// Single producer (the owning thread), single consumer (the writer
+// thread); head and tail on their own cache lines. retired is set when
+// the owning thread exits, after its last commit.
+struct Ring {
+    std::atomic<uint64_t> head{0};
+    char headPadding[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail{0};
+    std::atomic<bool> retired{false};
+    char tailPadding[64 - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)];
+    Record records[RING_CAPACITY];
+};
+
+class Logger {
+private:
+    std::unique_ptr<Ring> rings[MAX_THREADS];
+    std::atomic<Ring*> published[MAX_THREADS];
+    // Held from addRing() until the writer has drained the retired ring
+    std::atomic<bool> inUse[MAX_THREADS];
+    std::mutex drainMutex;
+    std::vector<Record> batch;
+    std::string output;
+    uint64_t droppedReported = 0;
+    std::thread writer;
+    std::atomic<bool> running{true};
+
+    static void appendArg(std::string& out, const Record& record, int arg) {
+        char text[32];
+        switch (record.types[arg]) {
+        case ARG_INT:
+            std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(record.args[arg].i));
+            break;
+        case ARG_UINT:
+            std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(record.args[arg].u));
+            break;
+        case ARG_DOUBLE:
+            std::snprintf(text, sizeof(text), "%g", record.args[arg].d);
+            break;
+        default:
+            out += record.text + record.args[arg].u;
+            return;
+        }
+        out += text;
+    }
+
+    void format(const Record& record) {
+        char prefix[48];
+        std::snprintf(prefix, sizeof(prefix), "%11.6f %-5s ", (record.timestampNs - startNs) / 1e9,
+                      LEVEL_NAMES[record.level < 4 ? record.level : 3]);
+        output += prefix;
+        int arg = 0;
+        for (const char* p = record.format; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && arg < record.argCount) {
+                appendArg(output, record, arg++);
+                ++p;
+            } else {
+                output += *p;
+            }
+        }
+        if (record.suppressed > 0) {
+            char note[48];
+            std::snprintf(note, sizeof(note), " (+%u suppressed)", record.suppressed);
+            output += note;
+        }
+        output += '\n';
+    }
+
+    void writerLoop() {
+        while (running.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WRITE_INTERVAL_MS));
+            drain();
+        }
+        drain();
+    }
+
+public:
+    const int64_t startNs;
+    std::atomic<uint64_t> dropped{0};
+
+    Logger() : startNs(nowNs()) {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            published[i].store(nullptr);
+            inUse[i].store(false);
+        }
+        writer = std::thread(&Logger::writerLoop, this);
+    }
+
+    ~Logger() {
+        running = false;
+        writer.join();
+    }
+
+    // A free slot's ring, allocated on the slot's first use and reused
+    // after a thread that held it exits; nullptr while MAX_THREADS live
+    // threads hold one
+    Ring* addRing() {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!inUse[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) continue;
+            if (!rings[i]) rings[i].reset(new Ring);
+            Ring* ring = rings[i].get();
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->tail.store(0, std::memory_order_relaxed);
+            ring->retired.store(false, std::memory_order_relaxed);
+            published[i].store(ring, std::memory_order_release);
+            return ring;
+        }
+        return nullptr;
+    }
+
+    // Everything committed so far, merged across threads by timestamp
+    void drain() {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        batch.clear();
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            Ring* ring = published[i].load(std::memory_order_acquire);
+            if (!ring) continue;
+            // Read before head: once retired is seen, head is final
+            bool retired = ring->retired.load(std::memory_order_acquire);
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                batch.push_back(ring->records[tail & (RING_CAPACITY - 1)]);
+            }
+            ring->tail.store(tail, std::memory_order_release);
+            if (retired) {
+                // Its thread is gone and everything it logged is in the batch
+                published[i].store(nullptr, std::memory_order_relaxed);
+                inUse[i].store(false, std::memory_order_release);
+            }
+        }
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const Record& a, const Record& b) { return a.timestampNs < b.timestampNs; });
+
+        output.clear();
+        for (const Record& record : batch) {
+            format(record);
+        }
+        uint64_t droppedNow = dropped.load();
+        if (droppedNow != droppedReported) {
+            char note[64];
+            std::snprintf(note, sizeof(note), "AsyncLog: %llu records dropped\n",
+                          static_cast<unsigned long long>(droppedNow - droppedReported));
+            output += note;
+            droppedReported = droppedNow;
+        }
+
+        const char* data = output.data();
+        size_t remaining = output.size();
+        while (remaining > 0) {
+            ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+            if (written <= 0) break;
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+    }
+};
+
+Logger& logger() {
+    static Logger instance;
+    return instance;
+}
+
+// This thread's ring; hands it back to the writer when the thread exits
+struct RingOwner {
+    Ring* ring = nullptr;
+    bool attached = false;
+
+    // Records logged after this (a static destructor) are dropped
+    ~RingOwner() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+        ring = nullptr;
+    }
+};
+
+thread_local RingOwner threadOwner;
+
+Ring* ring() {
+    if (!threadOwner.attached) {
+        threadOwner.attached = true;
+        threadOwner.ring = logger().addRing();
+    }
+    return threadOwner.ring;
+}
+
+} // namespace
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Record* claim() {
+    Ring* r = ring();
+    if (r) {
+        uint64_t head = r->head.load(std::memory_order_relaxed);
+        if (head - r->tail.load(std::memory_order_acquire) < RING_CAPACITY) {
+            return &r->records[head & (RING_CAPACITY - 1)];
+        }
+    }
+    ++logger().dropped;
+    return nullptr;
+}
+
+void commit() {
+    Ring* r = threadOwner.ring;
+    r->head.store(r->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool RateLimit::allow(int64_t intervalNs, uint32_t& suppressed) {
+    int64_t now = nowNs();
+    int64_t next = nextNs.load(std::memory_order_relaxed);
+    if (now >= next && nextNs.compare_exchange_strong(next, now + intervalNs)) {
+        suppressed = skipped.exchange(0);
+        return true;
+    }
+    ++skipped;
+    return false;
+}
+
+void attachThread() {
+    ring();
+}
+
+void flush() {
+    logger().drain();
+}
+
+uint64_t dropped() {
+    return logger().dropped.load();
+}
+
+} // namespace AsyncLog
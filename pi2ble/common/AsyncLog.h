@@ -0,0 +1,182 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Logging off the render thread. A log call copies a fixed-size binary
+// record (timestamp, format literal, arguments) into the calling thread's
+// own ring: no lock, no allocation, no syscall, no formatting. A
+// background thread collects the rings every few milliseconds, formats
+// the records in timestamp order and writes them to stdout in one
+// write(). A full ring drops the record and counts it rather than block.
+//
+//   LOG_INFO("Frame rate: {} FPS", frameRate);
+//   LOG_EVERY_MS(LOG_LEVEL_INFO, 1000, "frame {}", frameCount);  // at most once a second
+//
+// The format must be a string literal, one {} per argument (up to 6:
+// integers, floating point, strings; strings are copied, 48 bytes in all
+// per record). Levels below LOG_LEVEL are compiled out; build with
+// -DLOG_LEVEL=LOG_LEVEL_DEBUG to get the per-frame debug records.
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_AT(level, ...)                                 \
+    do {                                                   \
+        if ((level) >= LOG_LEVEL) {                        \
+            AsyncLog::write((level), 0, __VA_ARGS__);      \
+        }                                                  \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// One record per ms milliseconds from this call site, the ones in between
+// are counted and reported with the next
+#define LOG_EVERY_MS(level, ms, ...)                                                      \
+    do {                                                                                  \
+        if ((level) >= LOG_LEVEL) {                                                       \
+            static AsyncLog::RateLimit logRateLimit;                                      \
+            uint32_t logSuppressed;                                                       \
+            if (logRateLimit.allow((ms) * 1000000LL, logSuppressed)) {                    \
+                AsyncLog::write((level), logSuppressed, __VA_ARGS__);                     \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+namespace AsyncLog {
+
+enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_TEXT };
+
+const int MAX_ARGS = 6;
+const int TEXT_BYTES = 48;
+
+struct Record {
+    int64_t timestampNs;
+    const char* format;
+    uint32_t suppressed; // by the rate limit since the previous record
+    uint8_t level;
+    uint8_t argCount;
+    uint8_t types[MAX_ARGS];
+    union Arg {
+        int64_t i;
+        uint64_t u;
+        double d; // ARG_TEXT: u is the offset into text
+    } args[MAX_ARGS];
+    char text[TEXT_BYTES];
+};
+static_assert(sizeof(Record) == 128, "two cache lines per record");
+
+// Fills a record's arguments; strings past TEXT_BYTES are truncated, and
+// once the text area is full they are logged as empty strings
+class RecordWriter {
+private:
+    Record& record;
+    size_t textUsed = 0;
+
+    void addText(const char* s, size_t length) {
+        size_t room = TEXT_BYTES - textUsed;
+        if (room == 0) {
+            // Still takes its {}, as the empty string that ends the text
+            // area, so the arguments after it keep their places
+            record.types[record.argCount] = ARG_TEXT;
+            record.args[record.argCount++].u = TEXT_BYTES - 1;
+            return;
+        }
+        if (length > room - 1) length = room - 1;
+        std::memcpy(record.text + textUsed, s, length);
+        record.text[textUsed + length] = '\0';
+        record.types[record.argCount] = ARG_TEXT;
+        record.args[record.argCount++].u = textUsed;
+        textUsed += length + 1;
+    }
+
+public:
+    explicit RecordWriter(Record& r) : record(r) { record.argCount = 0; }
+
+    void add(int v) { add(static_cast<long long>(v)); }
+    void add(long v) { add(static_cast<long long>(v)); }
+    void add(long long v) {
+        record.types[record.argCount] = ARG_INT;
+        record.args[record.argCount++].i = v;
+    }
+    void add(unsigned v) { add(static_cast<unsigned long long>(v)); }
+    void add(unsigned long v) { add(static_cast<unsigned long long>(v)); }
+    void add(unsigned long long v) {
+        record.types[record.argCount] = ARG_UINT;
+        record.args[record.argCount++].u = v;
+    }
+    void add(float v) { add(static_cast<double>(v)); }
+    void add(double v) {
+        record.types[record.argCount] = ARG_DOUBLE;
+        record.args[record.argCount++].d = v;
+    }
+    void add(const char* s) { addText(s, std::strlen(s)); }
+    void add(const std::string& s) { addText(s.data(), s.size()); }
+};
+
+inline void encode(RecordWriter&) {}
+
+template <typename T, typename... Rest>
+void encode(RecordWriter& writer, const T& value, const Rest&... rest) {
+    writer.add(value);
+    encode(writer, rest...);
+}
+
+// This thread's next free record, nullptr (and counted as dropped) if its
+// ring is full; commit() hands it to the writer thread
+Record* claim();
+void commit();
+
+int64_t nowNs();
+
+template <typename... Args>
+void write(int level, uint32_t suppressed, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "AsyncLog records hold up to 6 arguments");
+    Record* record = claim();
+    if (!record) return;
+    record->timestampNs = nowNs();
+    record->format = format;
+    record->suppressed = suppressed;
+    record->level = static_cast<uint8_t>(level);
+    RecordWriter writer(*record);
+    encode(writer, args...);
+    commit();
+}
+
+class RateLimit {
+private:
+    std::atomic<int64_t> nextNs{0};
+    std::atomic<uint32_t> skipped{0};
+
+public:
+    // true if this one goes through; suppressed gets the count skipped
+    // since the last one that did
+    bool allow(int64_t intervalNs, uint32_t& suppressed);
+};
+
+// Sets up this thread's ring now, so that its first record doesn't
+// allocate: call before a render loop. The ring goes back to the pool
+// when the thread exits, once the writer has drained it.
+void attachThread();
+
+// Writes out everything logged so far, from any thread
+void flush();
+
+// Records dropped because a ring was full or too many threads were logging
+uint64_t dropped();
+
+} // namespace AsyncLog
+
+#endif // ASYNC_LOG_H
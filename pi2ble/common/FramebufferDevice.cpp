@@ -0,0 +1,35 @@
+#include "FramebufferDevice.h"
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+FramebufferDevice::FramebufferDevice(const std::string& device) : fd(-1), mapped(NULL), mappedBytes(0) {
+    fd = ::open(device.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open framebuffer " + device + ": " + std::strerror(errno));
+    }
+    if (ioctl(fd, FBIOGET_FSCREENINFO, &finfo) == -1 || ioctl(fd, FBIOGET_VSCREENINFO, &vinfo) == -1) {
+        ::close(fd);
+        throw std::runtime_error(device + " is not a framebuffer");
+    }
+    mappedBytes = static_cast<size_t>(vinfo.yres_virtual) * finfo.line_length;
+    void* region = mmap(NULL, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Could not map framebuffer " + device);
+    }
+    mapped = static_cast<uint8_t*>(region);
+}
+
+FramebufferDevice::~FramebufferDevice() {
+    munmap(mapped, mappedBytes);
+    ::close(fd);
+}
+
+uint8_t* FramebufferDevice::pixels() const {
+    return mapped + vinfo.yoffset * finfo.line_length + vinfo.xoffset * (vinfo.bits_per_pixel / 8);
+}
@@ -0,0 +1,45 @@
+#ifndef FRAMEBUFFER_DEVICE_H
+#define FRAMEBUFFER_DEVICE_H
+
+#include <linux/fb.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// An open and mapped Linux framebuffer (/dev/fbN): the open, the two
+// FBIOGET ioctls and the mmap that 03StreamLoadingBar's Framebuffer,
+// 04MultiInput's FramebufferSink and 05modular's FramebufferOut and
+// LatencyProbe all need. Which pixel formats to accept is up to them.
+class FramebufferDevice {
+private:
+    int fd;
+    fb_fix_screeninfo finfo;
+    fb_var_screeninfo vinfo;
+    uint8_t* mapped;
+    size_t mappedBytes;
+
+    FramebufferDevice(const FramebufferDevice&);
+    FramebufferDevice& operator=(const FramebufferDevice&);
+
+public:
+    // Throws std::runtime_error if the device can't be opened, isn't a
+    // framebuffer or can't be mapped
+    explicit FramebufferDevice(const std::string& device);
+    ~FramebufferDevice();
+
+    const fb_fix_screeninfo& fixedInfo() const { return finfo; }
+    const fb_var_screeninfo& variableInfo() const { return vinfo; }
+    int width() const { return static_cast<int>(vinfo.xres); }
+    int height() const { return static_cast<int>(vinfo.yres); }
+    int bitsPerPixel() const { return static_cast<int>(vinfo.bits_per_pixel); }
+    size_t stride() const { return finfo.line_length; }
+
+    // The whole mapping, every virtual row (yres_virtual * line_length)
+    uint8_t* memory() const { return mapped; }
+    size_t bytes() const { return mappedBytes; }
+    // Top left of the visible area: a panned or double buffered
+    // framebuffer shows from (xoffset, yoffset)
+    uint8_t* pixels() const;
+};
+
+#endif // FRAMEBUFFER_DEVICE_H
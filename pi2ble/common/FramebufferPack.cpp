@@ -0,0 +1,70 @@
+#include "FramebufferPack.h"
+
+namespace {
+
+fb_bitfield bitfield(uint32_t offset, uint32_t length) {
+    fb_bitfield field;
+    field.offset = offset;
+    field.length = length;
+    field.msb_right = 0;
+    return field;
+}
+
+PixelLayout layout(int bitsPerPixel, fb_bitfield red, fb_bitfield green, fb_bitfield blue) {
+    PixelLayout result;
+    result.bitsPerPixel = bitsPerPixel;
+    result.red = red;
+    result.green = green;
+    result.blue = blue;
+    return result;
+}
+
+// Top `length` bits of an 8 bit channel, moved to `offset`
+struct ChannelShift {
+    int drop;
+    int offset;
+
+    explicit ChannelShift(const fb_bitfield& field)
+        : drop(field.length < 8 ? 8 - static_cast<int>(field.length) : 0), offset(static_cast<int>(field.offset)) {}
+
+    uint32_t operator()(uint8_t value) const { return static_cast<uint32_t>(value >> drop) << offset; }
+};
+
+} // namespace
+
+PixelLayout pixelLayout(const fb_var_screeninfo& vinfo) {
+    return layout(vinfo.bits_per_pixel, vinfo.red, vinfo.green, vinfo.blue);
+}
+
+PixelLayout rgb565Layout() {
+    return layout(16, bitfield(11, 5), bitfield(5, 6), bitfield(0, 5));
+}
+
+PixelLayout xrgb8888Layout() {
+    return layout(32, bitfield(16, 8), bitfield(8, 8), bitfield(0, 8));
+}
+
+PixelLayout xbgr8888Layout() {
+    return layout(32, bitfield(0, 8), bitfield(8, 8), bitfield(16, 8));
+}
+
+void packBgr(const cv::Mat& bgr, int cols, int rows, uint8_t* dst, size_t stride, const PixelLayout& layout) {
+    const ChannelShift red(layout.red);
+    const ChannelShift green(layout.green);
+    const ChannelShift blue(layout.blue);
+    for (int y = 0; y < rows; ++y) {
+        const uint8_t* src = bgr.ptr<uint8_t>(y);
+        uint8_t* row = dst + y * stride;
+        if (layout.bitsPerPixel == 16) {
+            uint16_t* out = reinterpret_cast<uint16_t*>(row);
+            for (int x = 0; x < cols; ++x) {
+                out[x] = static_cast<uint16_t>(red(src[3 * x + 2]) | green(src[3 * x + 1]) | blue(src[3 * x]));
+            }
+        } else {
+            uint32_t* out = reinterpret_cast<uint32_t*>(row);
+            for (int x = 0; x < cols; ++x) {
+                out[x] = red(src[3 * x + 2]) | green(src[3 * x + 1]) | blue(src[3 * x]);
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef FRAMEBUFFER_PACK_H
+#define FRAMEBUFFER_PACK_H
+
+#include <opencv2/opencv.hpp>
+#include <linux/fb.h>
+#include <cstddef>
+#include <cstdint>
+
+// BGR frames into a framebuffer's pixel format, shared by 04MultiInput's
+// FramebufferSink, 05modular's FramebufferOut and DrawBench.
+
+// Where a framebuffer puts each channel, from its fb_var_screeninfo.
+// 16 and 32 bpp, channels of up to 8 bits.
+struct PixelLayout {
+    int bitsPerPixel;
+    fb_bitfield red;
+    fb_bitfield green;
+    fb_bitfield blue;
+};
+
+PixelLayout pixelLayout(const fb_var_screeninfo& vinfo);
+PixelLayout rgb565Layout();
+PixelLayout xrgb8888Layout();
+PixelLayout xbgr8888Layout();
+
+// Packs the top left cols x rows of bgr (CV_8UC3) into dst, rows stride bytes apart
+void packBgr(const cv::Mat& bgr, int cols, int rows, uint8_t* dst, size_t stride, const PixelLayout& layout);
+
+#endif // FRAMEBUFFER_PACK_H
@@ -0,0 +1,33 @@
+#include "GraphDraw.h"
+#include <algorithm>
+
+double seriesY(const cv::Rect& area, double value, double minVal, double maxVal) {
+    double y = area.y + area.height - ((value - minVal) / (maxVal - minVal)) * area.height;
+    return std::max(static_cast<double>(area.y), std::min(static_cast<double>(area.y + area.height), y));
+}
+
+void drawSeries(cv::Mat& image, const std::vector<double>& data, const cv::Rect& area, double minVal,
+                double maxVal, const cv::Scalar& color, const SeriesStyle& style) {
+    if (data.empty()) return;
+
+    if (data.size() > 1) {
+        size_t last = data.size() - 1;
+        size_t stride = 1;
+        if (style.maxPoints > 1 && data.size() > style.maxPoints) {
+            stride = (last + style.maxPoints - 2) / (style.maxPoints - 1);
+        }
+
+        cv::Point from(area.x, static_cast<int>(seriesY(area, data[0], minVal, maxVal)));
+        for (size_t i = std::min(stride, last);; i = std::min(i + stride, last)) {
+            double x = area.x + (static_cast<double>(i) / last) * area.width;
+            cv::Point to(static_cast<int>(x), static_cast<int>(seriesY(area, data[i], minVal, maxVal)));
+            cv::line(image, from, to, color, style.thickness, style.lineType);
+            from = to;
+            if (i == last) break;
+        }
+    }
+
+    double y = seriesY(area, data.back(), minVal, maxVal);
+    cv::circle(image, cv::Point(area.x + area.width - style.markerInset, static_cast<int>(y)), style.markerRadius,
+               color, -1);
+}
@@ -0,0 +1,29 @@
+#ifndef GRAPH_DRAW_H
+#define GRAPH_DRAW_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <vector>
+
+// The line graph of 04MultiInput's DataVisualizer, shared so DrawBench
+// times the same drawing the renderer does.
+
+// How a series is drawn. maxPoints caps the vertex count: 0 draws every
+// sample, otherwise every stride-th one (the newest always included).
+// The dot at the newest value is markerInset px in from the right edge.
+struct SeriesStyle {
+    int thickness;
+    int lineType;
+    size_t maxPoints;
+    int markerRadius;
+    int markerInset;
+};
+
+// Y of a value in area, minVal at the bottom and maxVal at the top, clamped
+double seriesY(const cv::Rect& area, double value, double minVal, double maxVal);
+
+// data as a polyline across the width of area, plus a dot at its newest value
+void drawSeries(cv::Mat& image, const std::vector<double>& data, const cv::Rect& area, double minVal,
+                double maxVal, const cv::Scalar& color, const SeriesStyle& style);
+
+#endif // GRAPH_DRAW_H
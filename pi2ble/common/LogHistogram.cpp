@@ -0,0 +1,43 @@
+#include "LogHistogram.h"
+#include <cstring>
+
+static const int SUB_BUCKET_BITS = 6;
+
+int logBucketIndex(uint64_t us) {
+    const uint64_t subBuckets = 1ull << SUB_BUCKET_BITS;
+    if (us < subBuckets) return static_cast<int>(us);
+    if (us >= (1ull << 32)) us = (1ull << 32) - 1;
+
+    int magnitude = 63 - __builtin_clzll(us);
+    int shift = magnitude - (SUB_BUCKET_BITS - 1);
+    int top = static_cast<int>(us >> shift); // 32..63
+    return static_cast<int>(subBuckets) + (shift - 1) * 32 + (top - 32);
+}
+
+uint64_t logBucketUpperBound(int index) {
+    const int subBuckets = 1 << SUB_BUCKET_BITS;
+    if (index < subBuckets) return static_cast<uint64_t>(index);
+
+    int shift = (index - subBuckets) / 32 + 1;
+    uint64_t top = 32 + static_cast<uint64_t>((index - subBuckets) % 32);
+    return ((top + 1) << shift) - 1;
+}
+
+LogHistogram::LogHistogram() {
+    reset();
+}
+
+void LogHistogram::record(uint64_t us) {
+    counts[logBucketIndex(us)]++;
+    total++;
+}
+
+void LogHistogram::remove(uint64_t us) {
+    counts[logBucketIndex(us)]--;
+    total--;
+}
+
+void LogHistogram::reset() {
+    std::memset(counts, 0, sizeof(counts));
+    total = 0;
+}
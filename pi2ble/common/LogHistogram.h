@@ -0,0 +1,55 @@
+#ifndef LOG_HISTOGRAM_H
+#define LOG_HISTOGRAM_H
+
+#include <cstdint>
+
+// Log-linear histogram buckets for durations in microseconds, shared by
+// 03StreamLoadingBar's capture latency, 04MultiInput's FrameStats and
+// 05modular's LatencyHistogram: exact below 64 us, then 32 buckets per
+// power of two (~3% precision). From 2^32 us (~71 minutes) on, values
+// share the last bucket.
+const int LOG_HISTOGRAM_BUCKETS = 64 + 26 * 32;
+
+int logBucketIndex(uint64_t us);
+// Largest value that lands in bucket `index`
+uint64_t logBucketUpperBound(int index);
+
+// Upper bound of the bucket holding the p-th percentile (0..100) of the
+// `total` values in counts[LOG_HISTOGRAM_BUCKETS], 0 if there are none.
+// Count is an integer or a std::atomic of one.
+template <typename Count>
+uint64_t logBucketPercentile(const Count* counts, uint64_t total, double p) {
+    if (total == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total));
+    if (rank >= total) rank = total - 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < LOG_HISTOGRAM_BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen > rank) return logBucketUpperBound(i);
+    }
+    return logBucketUpperBound(LOG_HISTOGRAM_BUCKETS - 1);
+}
+
+// Counts per bucket. Fixed size, recording never allocates; not thread
+// safe (05modular's LatencyHistogram keeps atomic counts instead).
+class LogHistogram {
+private:
+    uint64_t counts[LOG_HISTOGRAM_BUCKETS];
+    uint64_t total;
+
+public:
+    LogHistogram();
+
+    void record(uint64_t us);
+    // Takes back a value recorded earlier, for rolling windows
+    void remove(uint64_t us);
+    void reset();
+
+    uint64_t count() const { return total; }
+    // Bucket upper bound, callers cap it at the largest value they saw
+    uint64_t percentile(double p) const { return logBucketPercentile(counts, total, p); }
+};
+
+#endif // LOG_HISTOGRAM_H
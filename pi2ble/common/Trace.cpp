@@ -0,0 +1,261 @@
+#include "Trace.h"
+
+#ifdef TRACE_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t beginNs;
+    uint64_t endNs;
+};
+
+// Marks an event that names its thread instead of timing a scope
+const uint64_t THREAD_NAME = ~0ULL;
+
+// Single producer (the owning thread), single consumer (the writer).
+// The other fields are guarded by registryMutex.
+struct ThreadBuffer {
+    static const size_t CAPACITY = 1 << 14;
+
+    Event events[CAPACITY];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> retired; // set when the owning thread exits
+    int tid;
+    const char* name;          // from TRACE_THREAD_NAME, NULL if unnamed
+    bool free;                 // retired and drained, another thread may take it
+
+    explicit ThreadBuffer(int id) : head(0), tail(0), dropped(0), retired(false), tid(id), name(NULL), free(false) {}
+};
+
+// Marks the buffer retired when its thread exits. The writer drains what
+// is left, then hands the buffer to the next new thread, so threads that
+// come and go don't grow the registry.
+struct BufferOwner {
+    ThreadBuffer* buffer;
+    const char* name; // kept until the thread has a buffer
+
+    BufferOwner() : buffer(NULL), name(NULL) {}
+    ~BufferOwner() {
+        if (buffer) buffer->retired.store(true, std::memory_order_release);
+        buffer = NULL;
+    }
+};
+
+std::atomic<bool> active(false);
+std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+std::mutex registryMutex;
+std::vector<ThreadBuffer*> registry;
+int lastTid = 0;
+uint64_t droppedReused = 0; // by buffers since handed to another thread
+thread_local BufferOwner threadOwner;
+
+std::mutex writerMutex;
+std::condition_variable writerWake;
+std::thread writer;
+bool writerRunning = false;
+FILE* out = NULL;
+bool firstEvent = true;
+
+void pushTo(ThreadBuffer* buffer, const char* name, uint64_t beginNs, uint64_t endNs) {
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= ThreadBuffer::CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event& event = buffer->events[head % ThreadBuffer::CAPACITY];
+    event.name = name;
+    event.beginNs = beginNs;
+    event.endNs = endNs;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+// A free buffer of a thread that exited, or a new one. Gets a tid of its
+// own either way, and starts with the thread's name if it has one.
+ThreadBuffer* currentBuffer() {
+    if (!threadOwner.buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ThreadBuffer* buffer = NULL;
+        for (size_t i = 0; i < registry.size() && !buffer; ++i) {
+            if (registry[i]->free) buffer = registry[i];
+        }
+        if (buffer) {
+            droppedReused += buffer->dropped.load(std::memory_order_relaxed);
+            buffer->head.store(0, std::memory_order_relaxed);
+            buffer->tail.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+            buffer->retired.store(false, std::memory_order_relaxed);
+            buffer->tid = ++lastTid;
+            buffer->free = false;
+        } else {
+            buffer = new ThreadBuffer(++lastTid);
+            registry.push_back(buffer);
+        }
+        buffer->name = threadOwner.name;
+        threadOwner.buffer = buffer;
+        if (buffer->name) pushTo(buffer, buffer->name, THREAD_NAME, THREAD_NAME);
+    }
+    return threadOwner.buffer;
+}
+
+void push(const char* name, uint64_t beginNs, uint64_t endNs) {
+    pushTo(currentBuffer(), name, beginNs, endNs);
+}
+
+void writeName(const char* name) {
+    std::fputc('"', out);
+    for (const char* c = name; *c; ++c) {
+        if (*c == '"' || *c == '\\') std::fputc('\\', out);
+        std::fputc(*c, out);
+    }
+    std::fputc('"', out);
+}
+
+void writeEvent(const Event& event, int tid) {
+    std::fputs(firstEvent ? "\n" : ",\n", out);
+    firstEvent = false;
+    if (event.beginNs == THREAD_NAME) {
+        std::fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", tid);
+        writeName(event.name);
+        std::fputs("}}", out);
+        return;
+    }
+    // Chrome wants microseconds; the fraction keeps the nanoseconds
+    std::fputs("{\"name\":", out);
+    writeName(event.name);
+    std::fprintf(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", tid, event.beginNs / 1000.0,
+                 (event.endNs - event.beginNs) / 1000.0);
+}
+
+// Only ever called from one thread at a time: the writer, or stop() after it
+void drain() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < registry.size(); ++i) {
+        ThreadBuffer* buffer = registry[i];
+        if (buffer->free) continue;
+        // Retired before head is read: then head is the last event
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        size_t head = buffer->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            writeEvent(buffer->events[tail % ThreadBuffer::CAPACITY], buffer->tid);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+        if (retired) buffer->free = true;
+    }
+}
+
+void writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (writerRunning) {
+        writerWake.wait_for(lock, std::chrono::milliseconds(20));
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+} // namespace
+
+uint64_t Trace::nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Trace::start(const std::string& path) {
+    if (active) {
+        throw std::runtime_error("Trace session already running");
+    }
+    out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        throw std::runtime_error("Could not open trace file: " + path);
+    }
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out);
+    firstEvent = true;
+
+    // Whatever was left from an earlier session is not part of this one,
+    // but the names of the threads still around are
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        droppedReused = 0;
+        for (size_t i = 0; i < registry.size(); ++i) {
+            ThreadBuffer* buffer = registry[i];
+            buffer->dropped = 0;
+            if (buffer->free) continue;
+            bool retired = buffer->retired.load(std::memory_order_acquire);
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            if (retired) {
+                buffer->free = true;
+            } else if (buffer->name) {
+                Event event = {buffer->name, THREAD_NAME, THREAD_NAME};
+                writeEvent(event, buffer->tid);
+            }
+        }
+    }
+
+    writerRunning = true;
+    writer = std::thread(writerLoop);
+    active = true;
+}
+
+void Trace::stop() {
+    if (!active) return;
+    active = false;
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerRunning = false;
+    }
+    writerWake.notify_one();
+    writer.join();
+    drain();
+
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        dropped = droppedReused;
+        for (size_t i = 0; i < registry.size(); ++i) dropped += registry[i]->dropped;
+    }
+    std::fputs("\n]}\n", out);
+    std::fclose(out);
+    out = NULL;
+    if (dropped > 0) {
+        std::cerr << "Trace: " << dropped << " events dropped, the writer fell behind" << std::endl;
+    }
+}
+
+void Trace::record(const char* name, uint64_t beginNs, uint64_t endNs) {
+    if (!active.load(std::memory_order_relaxed)) return;
+    push(name, beginNs, endNs);
+}
+
+// Kept with the thread, so a name given before start() is written when
+// the session starts or the thread's first event is
+void Trace::nameThread(const char* name) {
+    threadOwner.name = name;
+    if (!threadOwner.buffer) {
+        // A new buffer starts with the name
+        if (active.load(std::memory_order_relaxed)) currentBuffer();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadOwner.buffer->name = name;
+    }
+    if (!active.load(std::memory_order_relaxed)) return;
+    push(name, THREAD_NAME, THREAD_NAME);
+}
+
+#endif // TRACE_ENABLED
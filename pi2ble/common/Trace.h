@@ -0,0 +1,70 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Scoped tracing to Chrome trace-event JSON (chrome://tracing, Perfetto).
+//
+//   TRACE_START("run.trace.json");
+//   { TRACE_SCOPE("render"); ... }
+//   TRACE_STOP();
+//
+// A scope records its nanosecond begin and end into a ring owned by the
+// calling thread, without locks or allocation (the ring is taken on a
+// thread's first event, and handed on to a later thread once its own has
+// exited and the ring is drained). A background thread drains the rings
+// and writes the JSON. If a ring fills faster than it is drained, events
+// are dropped and counted rather than blocking the traced thread.
+//
+// Without TRACE_ENABLED (make trace defines it) the macros expand to
+// nothing and none of this is compiled in.
+
+#ifdef TRACE_ENABLED
+
+#include <cstdint>
+#include <string>
+
+namespace Trace {
+
+uint64_t nowNs();
+
+// Starts writing events to path; events before start() are ignored
+void start(const std::string& path);
+// Writes what is still buffered and closes the file
+void stop();
+
+// name must outlive the session (a string literal)
+void record(const char* name, uint64_t beginNs, uint64_t endNs);
+// May be called before start(); name must outlive the session too
+void nameThread(const char* name);
+
+class Scope {
+private:
+    const char* name;
+    uint64_t beginNs;
+
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+public:
+    explicit Scope(const char* scopeName) : name(scopeName), beginNs(nowNs()) {}
+    ~Scope() { record(name, beginNs, nowNs()); }
+};
+
+} // namespace Trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Trace::nameThread(name)
+#define TRACE_START(path) Trace::start(path)
+#define TRACE_STOP() Trace::stop()
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_START(path) ((void)0)
+#define TRACE_STOP() ((void)0)
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_H
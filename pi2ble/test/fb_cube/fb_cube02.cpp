@@ -100,18 +100,19 @@ int main() {
 
     auto start_time = std::chrono::steady_clock::now();
 
+    // Projected vertices, reused every frame
+    std::vector<cv::Point> pts(verts.size());
+
     while (true) {
         frame.setTo(cv::Scalar(0,0,0));
 
         // Rotate and project cube
-        std::vector<cv::Point> pts;
-        pts.reserve(verts.size());
-        for (const auto& v : verts) {
-            Vec3 r = rotateX(rotateY(v, angle*0.9f), angle*0.7f);
+        for (size_t i = 0; i < verts.size(); ++i) {
+            Vec3 r = rotateX(rotateY(verts[i], angle*0.9f), angle*0.7f);
             float z = r.z + zcam;
             float px = (r.x * fov) / z + W*0.5f;
             float py = (r.y * fov) / z + H*0.5f;
-            pts.emplace_back((int)std::lround(px), (int)std::lround(py));
+            pts[i] = cv::Point((int)std::lround(px), (int)std::lround(py));
         }
         for (auto& e : edges) {
             cv::line(frame, pts[e[0]], pts[e[1]], cv::Scalar(200, 255, 255), 2, cv::LINE_AA);